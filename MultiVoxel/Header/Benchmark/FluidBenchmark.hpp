@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include "Independent/Thread/WorkerPool.hpp"
+#include "Independent/World/FluidSimulation.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Thread;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Benchmark
+{
+    class FluidBenchmark final
+    {
+
+    public:
+
+        FluidBenchmark(const FluidBenchmark&) = delete;
+        FluidBenchmark(FluidBenchmark&&) = delete;
+        FluidBenchmark& operator=(const FluidBenchmark&) = delete;
+        FluidBenchmark& operator=(FluidBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const uint32_t maximumTicks = 4000)
+        {
+            WorkerPool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+            for (const int32_t worldRadius : { 4, 16 })
+                RunDamBreak(stream, worldRadius, maximumTicks, pool);
+        }
+
+    private:
+
+        static constexpr int32_t BasinWidth = 4 * Chunk::Width;
+        static constexpr int32_t FloorHeight = ChunkSection::Size;
+        static constexpr int32_t WallHeight = 24;
+        static constexpr int32_t DamX = 16;
+        static constexpr int32_t ReservoirHeight = 16;
+
+        struct Statistics
+        {
+            size_t updatedCount = 0;
+            size_t peakActiveCount = 0;
+        };
+
+        FluidBenchmark() = default;
+
+        static void RunDamBreak(std::ostream& stream, const int32_t worldRadius, const uint32_t maximumTicks, WorkerPool& pool)
+        {
+            auto& manager = ChunkManager::GetInstance();
+            auto& tracker = ChunkChangeTracker::GetInstance();
+            auto& simulation = FluidSimulation::GetInstance();
+
+            manager.Clear();
+            simulation.Clear();
+
+            for (int32_t z = -worldRadius; z < worldRadius; ++z)
+            {
+                for (int32_t x = -worldRadius; x < worldRadius; ++x)
+                {
+                    auto chunk = std::make_unique<Chunk>(ChunkCoordinate{ x, z });
+
+                    chunk->GetSection(0).Fill(StoneBlock);
+
+                    manager.Insert(std::move(chunk));
+                }
+            }
+
+            for (int32_t y = FloorHeight; y < FloorHeight + WallHeight; ++y)
+            {
+                for (int32_t index = 0; index < BasinWidth; ++index)
+                {
+                    manager.SetBlock(index, y, 0, StoneBlock);
+                    manager.SetBlock(index, y, BasinWidth - 1, StoneBlock);
+                    manager.SetBlock(0, y, index, StoneBlock);
+                    manager.SetBlock(BasinWidth - 1, y, index, StoneBlock);
+                    manager.SetBlock(DamX, y, index, StoneBlock);
+                }
+            }
+
+            for (int32_t y = FloorHeight; y < FloorHeight + ReservoirHeight; ++y)
+            {
+                for (int32_t z = 1; z < BasinWidth - 1; ++z)
+                {
+                    for (int32_t x = 1; x < DamX; ++x)
+                        simulation.AddFluid(x, y, z, WaterBlock);
+                }
+            }
+
+            tracker.Flush();
+
+            uint64_t tick = 0;
+
+            const uint32_t settleTicks = StepUntilIdle(simulation, tracker, pool, tick, maximumTicks, nullptr);
+
+            const uint64_t volume = simulation.GetVolume();
+
+            stream << "[Benchmark] fluid world " << 2 * worldRadius << "x" << 2 * worldRadius << " chunks: reservoir cells=" << simulation.GetCellCount()
+                   << " settled in " << settleTicks << " ticks\n";
+
+            for (int32_t y = FloorHeight; y < FloorHeight + WallHeight; ++y)
+            {
+                for (int32_t z = 1; z < BasinWidth - 1; ++z)
+                {
+                    if (manager.SetBlock(DamX, y, z, AirBlock))
+                        simulation.OnBlockChanged(DamX, y, z, StoneBlock, AirBlock);
+                }
+            }
+
+            tracker.Flush();
+
+            Statistics statistics;
+
+            const auto start = steady_clock::now();
+
+            const uint32_t breakTicks = StepUntilIdle(simulation, tracker, pool, tick, maximumTicks, &statistics);
+
+            const double seconds = duration<double>(steady_clock::now() - start).count();
+
+            stream << "[Benchmark] fluid dam break: ticks=" << breakTicks << (breakTicks >= maximumTicks ? " (not settled)" : "")
+                   << " cell updates=" << statistics.updatedCount
+                   << " peak active=" << statistics.peakActiveCount
+                   << " wet cells=" << simulation.GetCellCount()
+                   << " volume " << volume << " -> " << simulation.GetVolume()
+                   << " time=" << std::fixed << std::setprecision(2) << seconds * 1000.0 << "ms"
+                   << " (" << std::setprecision(3) << seconds * 1000.0 / std::max<uint32_t>(breakTicks, 1) << "ms/tick, "
+                   << std::setprecision(1) << static_cast<double>(statistics.updatedCount) / std::max(seconds, 1e-9) / 1e6 << "M updates/s)\n";
+
+            manager.Clear();
+            simulation.Clear();
+        }
+
+        static uint32_t StepUntilIdle(FluidSimulation& simulation, ChunkChangeTracker& tracker, WorkerPool& pool, uint64_t& tick, const uint32_t maximumTicks, Statistics* statistics)
+        {
+            uint32_t count = 0;
+
+            while (count < maximumTicks && simulation.GetActiveCount() > 0)
+            {
+                if (statistics)
+                    statistics->peakActiveCount = std::max(statistics->peakActiveCount, simulation.GetActiveCount());
+
+                simulation.Step(++tick, &pool);
+                tracker.Flush();
+
+                if (statistics)
+                    statistics->updatedCount += simulation.GetLastUpdatedCount();
+
+                count++;
+            }
+
+            return count;
+        }
+
+    };
+}
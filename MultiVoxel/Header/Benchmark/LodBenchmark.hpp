@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Independent/World/Brickmap.hpp"
+#include "Independent/World/GenerationPipeline.hpp"
+#include "Independent/World/LodMesher.hpp"
+#include "Independent/World/LodSelector.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Benchmark
+{
+    class LodBenchmark final
+    {
+
+    public:
+
+        LodBenchmark(const LodBenchmark&) = delete;
+        LodBenchmark(LodBenchmark&&) = delete;
+        LodBenchmark& operator=(const LodBenchmark&) = delete;
+        LodBenchmark& operator=(LodBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const int32_t maximumRadius = 32, const uint64_t seed = 0x5EED)
+        {
+            auto& store = BrickmapStore::GetInstance();
+
+            store.Clear();
+
+            const auto start = steady_clock::now();
+
+            {
+                GenerationPipeline pipeline(seed, std::max(1u, std::thread::hardware_concurrency()));
+
+                const int32_t extent = maximumRadius + 1;
+
+                for (int32_t z = -extent; z <= extent; ++z)
+                {
+                    for (int32_t x = -extent; x <= extent; ++x)
+                    {
+                        if (x * x + z * z <= extent * extent)
+                            pipeline.Request({ x, z });
+                    }
+
+                    pipeline.Collect([&](const std::unique_ptr<Chunk>& chunk) { store.Update(*chunk); });
+                }
+
+                pipeline.Wait();
+                pipeline.Collect([&](const std::unique_ptr<Chunk>& chunk) { store.Update(*chunk); });
+            }
+
+            stream << "[Benchmark] lod world: columns=" << store.GetEntryCount() << " brickmap=" << store.GetMemoryUsage() / 1024 << "KB"
+                   << " generated in " << std::fixed << std::setprecision(2) << duration<double>(steady_clock::now() - start).count() << "s\n";
+
+            const Vector<float, 3> camera = { 8.0f, 96.0f, 8.0f };
+
+            LodMesher mesher;
+            LodMesh mesh;
+
+            std::unordered_map<ChunkCoordinate, size_t, ChunkCoordinateHash> fullTriangleMap;
+
+            for (int32_t radius = 8; radius <= maximumRadius; radius += 8)
+            {
+                LodSelector selector;
+
+                selector.Update(camera, radius);
+
+                size_t triangleCount = 0;
+                size_t fullTriangleCount = 0;
+
+                std::array<size_t, LodMesher::LevelCount> levelCountList = { };
+
+                const auto meshStart = steady_clock::now();
+
+                selector.ForEach([&](const ChunkCoordinate coordinate, const int32_t level)
+                {
+                    mesher.Generate(store, coordinate, level, selector.GetNeighbourLevelList(coordinate), mesh);
+
+                    triangleCount += mesh.GetTriangleCount();
+                    levelCountList[level]++;
+                });
+
+                const double meshSeconds = duration<double>(steady_clock::now() - meshStart).count();
+
+                selector.ForEach([&](const ChunkCoordinate coordinate, int32_t)
+                {
+                    auto [iterator, inserted] = fullTriangleMap.try_emplace(coordinate, 0);
+
+                    if (inserted)
+                    {
+                        mesher.Generate(store, coordinate, 0, { 0, 0, 0, 0 }, mesh);
+
+                        iterator->second = mesh.GetTriangleCount();
+                    }
+
+                    fullTriangleCount += iterator->second;
+                });
+
+                stream << "[Benchmark] lod radius " << std::setw(2) << radius
+                       << ": chunks=" << selector.GetChunkCount()
+                       << " levels=" << levelCountList[0] << "/" << levelCountList[1] << "/" << levelCountList[2] << "/" << levelCountList[3]
+                       << " triangles=" << triangleCount
+                       << " full-resolution=" << fullTriangleCount
+                       << " ratio=" << std::setprecision(1) << static_cast<double>(fullTriangleCount) / static_cast<double>(std::max<size_t>(triangleCount, 1)) << "x"
+                       << " meshing=" << std::setprecision(2) << meshSeconds * 1000.0 << "ms\n";
+            }
+
+            LodSelector selector;
+
+            selector.Update({ camera[0] + 4.0f * Chunk::Width, camera[1], camera[2] }, maximumRadius);
+
+            size_t remeshCount = 0;
+
+            for (int32_t frame = 0; frame < 64; ++frame)
+            {
+                const float offset = frame % 2 == 0 ? 0.2f : -0.2f;
+
+                remeshCount += selector.Update({ camera[0] + (4.0f + offset) * Chunk::Width, camera[1], camera[2] }, maximumRadius).size();
+            }
+
+            stream << "[Benchmark] lod hysteresis: " << remeshCount << " remeshes over 64 frames oscillating around a level boundary\n";
+
+            store.Clear();
+        }
+
+    private:
+
+        LodBenchmark() = default;
+
+    };
+}
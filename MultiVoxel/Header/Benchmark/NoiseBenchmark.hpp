@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Independent/Math/Noise.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Math;
+
+namespace MultiVoxel::Benchmark
+{
+    class NoiseBenchmark final
+    {
+
+    public:
+
+        NoiseBenchmark(const NoiseBenchmark&) = delete;
+        NoiseBenchmark(NoiseBenchmark&&) = delete;
+        NoiseBenchmark& operator=(const NoiseBenchmark&) = delete;
+        NoiseBenchmark& operator=(NoiseBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const size_t sampleCount = 1 << 16, const size_t iterationCount = 20)
+        {
+            std::vector<float> x(sampleCount);
+            std::vector<float> y(sampleCount);
+            std::vector<float> z(sampleCount);
+
+            for (size_t index = 0; index < sampleCount; ++index)
+            {
+                x[index] = static_cast<float>(index % 256) * 0.173f - 11.0f;
+                y[index] = static_cast<float>(index / 256 % 256) * 0.091f + 3.5f;
+                z[index] = static_cast<float>(index / 65536) * 0.137f - 7.25f;
+            }
+
+            stream << "[Benchmark] noise: detected " << GetSimdLevelName(DetectSimdLevel()) << "\n";
+
+            Report(stream, "perlin 2d", x, y, z, iterationCount, [](const Noise& noise, const float* sampleX, const float* sampleY, const float*, float* out, const size_t count) { noise.Perlin(sampleX, sampleY, out, count); });
+            Report(stream, "perlin 3d", x, y, z, iterationCount, [](const Noise& noise, const float* sampleX, const float* sampleY, const float* sampleZ, float* out, const size_t count) { noise.Perlin(sampleX, sampleY, sampleZ, out, count); });
+            Report(stream, "simplex 2d", x, y, z, iterationCount, [](const Noise& noise, const float* sampleX, const float* sampleY, const float*, float* out, const size_t count) { noise.Simplex(sampleX, sampleY, out, count); });
+            Report(stream, "simplex 3d", x, y, z, iterationCount, [](const Noise& noise, const float* sampleX, const float* sampleY, const float* sampleZ, float* out, const size_t count) { noise.Simplex(sampleX, sampleY, sampleZ, out, count); });
+            Report(stream, "fractal 3d x4", x, y, z, iterationCount, [](const Noise& noise, const float* sampleX, const float* sampleY, const float* sampleZ, float* out, const size_t count) { noise.Fractal(NoiseType::Perlin, sampleX, sampleY, sampleZ, out, count, 4); });
+        }
+
+    private:
+
+        using Kernel = std::function<void(const Noise&, const float*, const float*, const float*, float*, size_t)>;
+
+        NoiseBenchmark() = default;
+
+        static void Report(std::ostream& stream, const std::string& name, const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z, const size_t iterationCount, const Kernel& kernel)
+        {
+            const size_t sampleCount = x.size();
+
+            Noise noise(0x5EED);
+
+            std::vector<float> reference(sampleCount);
+            std::vector<float> output(sampleCount);
+
+            for (const auto level : { SimdLevel::Scalar, SimdLevel::Sse41, SimdLevel::Avx2 })
+            {
+                noise.SetSimdLevel(level);
+
+                if (noise.GetSimdLevel() != level)
+                    continue;
+
+                auto& target = level == SimdLevel::Scalar ? reference : output;
+
+                const auto start = steady_clock::now();
+
+                for (size_t iteration = 0; iteration < iterationCount; ++iteration)
+                    kernel(noise, x.data(), y.data(), z.data(), target.data(), sampleCount);
+
+                const double seconds = duration<double>(steady_clock::now() - start).count();
+                const bool identical = level == SimdLevel::Scalar || std::memcmp(reference.data(), output.data(), sampleCount * sizeof(float)) == 0;
+
+                stream << "[Benchmark] " << std::left << std::setw(14) << name << std::setw(7) << GetSimdLevelName(level) << std::right
+                       << ": " << std::fixed << std::setprecision(1) << static_cast<double>(sampleCount * iterationCount) / seconds / 1e6 << " Msamples/s"
+                       << (identical ? "" : " (MISMATCH against scalar)") << "\n";
+            }
+        }
+
+    };
+}
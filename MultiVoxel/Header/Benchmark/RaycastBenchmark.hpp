@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "Independent/Math/Random.hpp"
+#include "Independent/World/GenerationPipeline.hpp"
+#include "Independent/World/VoxelRaycast.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::Thread;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Benchmark
+{
+    class RaycastBenchmark final
+    {
+
+    public:
+
+        RaycastBenchmark(const RaycastBenchmark&) = delete;
+        RaycastBenchmark(RaycastBenchmark&&) = delete;
+        RaycastBenchmark& operator=(const RaycastBenchmark&) = delete;
+        RaycastBenchmark& operator=(RaycastBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const int32_t radius = 6, const size_t rayCount = 1 << 18, const uint64_t seed = 0x5EED)
+        {
+            const size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+            auto& manager = ChunkManager::GetInstance();
+
+            manager.Clear();
+
+            {
+                GenerationPipeline pipeline(seed, threadCount);
+
+                for (int32_t z = -radius; z < radius; ++z)
+                {
+                    for (int32_t x = -radius; x < radius; ++x)
+                        pipeline.Request({ x, z });
+                }
+
+                pipeline.Wait();
+                pipeline.Collect([&](std::unique_ptr<Chunk> chunk) { manager.Insert(std::move(chunk)); });
+            }
+
+            const float extent = static_cast<float>(radius * Chunk::Width);
+
+            Random random(seed);
+
+            std::vector<Ray> rayList(rayCount);
+
+            for (auto& ray : rayList)
+            {
+                const float pitch = NextFloat(random, -1.2f, 0.3f);
+                const float yaw = NextFloat(random, 0.0f, 6.2831853f);
+
+                ray.origin = { NextFloat(random, -extent, extent), NextFloat(random, 64.0f, 140.0f), NextFloat(random, -extent, extent) };
+                ray.direction = { std::cos(pitch) * std::cos(yaw), std::sin(pitch), std::cos(pitch) * std::sin(yaw) };
+                ray.maximumDistance = MaximumDistance;
+            }
+
+            std::vector<std::optional<RaycastHit>> serialList(rayCount);
+            std::vector<std::optional<RaycastHit>> batchList(rayCount);
+
+            auto start = steady_clock::now();
+
+            VoxelRaycast::CastBatch(manager, rayList, serialList);
+
+            const double serialSeconds = duration<double>(steady_clock::now() - start).count();
+
+            double batchSeconds;
+
+            {
+                WorkerPool pool(threadCount);
+
+                start = steady_clock::now();
+
+                VoxelRaycast::CastBatch(manager, rayList, batchList, &pool);
+
+                batchSeconds = duration<double>(steady_clock::now() - start).count();
+            }
+
+            size_t hitCount = 0;
+            double hitDistance = 0.0;
+            bool identical = true;
+
+            for (size_t index = 0; index < rayCount; ++index)
+            {
+                const auto& serial = serialList[index];
+                const auto& batch = batchList[index];
+
+                if (serial)
+                {
+                    hitCount++;
+                    hitDistance += serial->distance;
+                }
+
+                identical = identical && serial.has_value() == batch.has_value() && (!serial || (serial->position == batch->position && serial->distance == batch->distance));
+            }
+
+            stream << "[Benchmark] raycast world: chunks=" << manager.GetChunkCount() << " rays=" << rayCount << " range=" << MaximumDistance
+                   << " hits=" << std::fixed << std::setprecision(1) << static_cast<double>(hitCount) * 100.0 / static_cast<double>(rayCount) << "%"
+                   << " mean hit distance=" << std::setprecision(2) << hitDistance / static_cast<double>(std::max<size_t>(hitCount, 1)) << "\n";
+
+            stream << "[Benchmark] raycast serial    : " << std::setprecision(2) << static_cast<double>(rayCount) / serialSeconds / 1e6 << " Mrays/s\n";
+            stream << "[Benchmark] raycast batch x" << std::left << std::setw(3) << threadCount << std::right
+                   << ": " << static_cast<double>(rayCount) / batchSeconds / 1e6 << " Mrays/s"
+                   << (identical ? "" : " (MISMATCH against serial)") << "\n";
+
+            manager.Clear();
+        }
+
+    private:
+
+        static constexpr float MaximumDistance = 96.0f;
+
+        RaycastBenchmark() = default;
+
+        static float NextFloat(Random& random, const float minimum, const float maximum)
+        {
+            return minimum + (maximum - minimum) * static_cast<float>(random.Next() >> 40) / static_cast<float>(1 << 24);
+        }
+
+    };
+}
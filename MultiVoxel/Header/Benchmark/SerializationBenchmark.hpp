@@ -0,0 +1,274 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/array.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include "Client/Render/Vertices/FatVertex.hpp"
+#include "Independent/Math/Transform.hpp"
+#include "Independent/Math/Vector.hpp"
+#include "Independent/Network/WireArchive.hpp"
+#include "Server/RPC/RpcTypes.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Client::Render::Vertices;
+using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Server::Rpc;
+
+namespace MultiVoxel::Benchmark
+{
+    class SerializationBenchmark final
+    {
+
+    public:
+
+        SerializationBenchmark(const SerializationBenchmark&) = delete;
+        SerializationBenchmark(SerializationBenchmark&&) = delete;
+        SerializationBenchmark& operator=(const SerializationBenchmark&) = delete;
+        SerializationBenchmark& operator=(SerializationBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const size_t iterationCount = 200)
+        {
+            const auto moveList = CreateMoves(256);
+            const auto transformList = CreateTransforms(512);
+            const auto vertexList = CreateVertices(10000);
+
+            std::vector<uint32_t> indexList(vertexList.size() * 3 / 2);
+
+            for (size_t index = 0; index < indexList.size(); ++index)
+                indexList[index] = static_cast<uint32_t>(index % vertexList.size());
+
+            Report(stream, "rpc batch (256 moves)", iterationCount, moveList, WriteMoves<cereal::BinaryOutputArchive>, ReadMoves<cereal::BinaryInputArchive>, WriteMoves<WireOutputArchive>, ReadMoves<WireInputArchive>);
+            Report(stream, "sync packet (512 transforms)", iterationCount, transformList, WriteTransforms<cereal::BinaryOutputArchive>, ReadTransforms<cereal::BinaryInputArchive>, WriteTransforms<WireOutputArchive>, ReadTransforms<WireInputArchive>);
+
+            const auto writeMesh = [&]<typename Archive>(Archive& archive, const std::vector<FatVertex>& vertices) { archive(vertices, indexList); };
+            const auto readMesh = []<typename Archive>(Archive& archive, std::vector<FatVertex>& vertices)
+            {
+                std::vector<uint32_t> indices;
+
+                archive(vertices, indices);
+            };
+
+            Report(stream, "mesh (10k fat vertices)", iterationCount, vertexList, writeMesh, readMesh, writeMesh, readMesh);
+        }
+
+    private:
+
+        struct Move
+        {
+            uint64_t callId = 0;
+            NetworkId id = 0;
+
+            Vector<float, 3> position;
+            Vector<float, 3> rotation;
+        };
+
+        struct TransformRecord
+        {
+            NetworkId id = 0;
+
+            std::string typeName;
+
+            Vector<float, 3> position;
+            Vector<float, 3> rotation;
+            Vector<float, 3> scale;
+        };
+
+        struct Result
+        {
+            double encodeMicroseconds = 0.0;
+            double decodeMicroseconds = 0.0;
+
+            size_t byteCount = 0;
+        };
+
+        SerializationBenchmark() = default;
+
+        static std::vector<Move> CreateMoves(const size_t count)
+        {
+            std::vector<Move> result(count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float value = static_cast<float>(index);
+
+                result[index] = { index + 1, static_cast<NetworkId>(index + 1), { value, 64.0f, -value }, { 0.0f, value * 0.5f, 0.0f } };
+            }
+
+            return result;
+        }
+
+        static std::vector<TransformRecord> CreateTransforms(const size_t count)
+        {
+            std::vector<TransformRecord> result(count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float value = static_cast<float>(index);
+
+                result[index] = { static_cast<NetworkId>(index + 1), typeid(Transform).name(), { value, 64.0f, -value }, { 0.0f, value, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+            }
+
+            return result;
+        }
+
+        static std::vector<FatVertex> CreateVertices(const size_t count)
+        {
+            std::vector<FatVertex> result(count);
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float value = static_cast<float>(index);
+
+                result[index] = { { value, value * 0.5f, -value }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { value / static_cast<float>(count), 0.5f } };
+            }
+
+            return result;
+        }
+
+        template <typename Archive>
+        static void WriteMoves(Archive& archive, const std::vector<Move>& moveList)
+        {
+            archive(static_cast<uint32_t>(moveList.size()));
+
+            for (const auto& [callId, id, position, rotation] : moveList)
+                archive(callId, RpcType::MoveGameObjectResponse, id, position, rotation);
+        }
+
+        template <typename Archive>
+        static void ReadMoves(Archive& archive, std::vector<Move>& moveList)
+        {
+            uint32_t count;
+
+            archive(count);
+
+            moveList.resize(count);
+
+            for (auto& [callId, id, position, rotation] : moveList)
+            {
+                RpcType type;
+
+                archive(callId, type, id, position, rotation);
+            }
+        }
+
+        template <typename Archive>
+        static void WriteTransforms(Archive& archive, const std::vector<TransformRecord>& recordList)
+        {
+            for (const auto& [id, typeName, position, rotation, scale] : recordList)
+                archive(true, id, typeName, position, rotation, scale);
+
+            archive(false);
+        }
+
+        template <typename Archive>
+        static void ReadTransforms(Archive& archive, std::vector<TransformRecord>& recordList)
+        {
+            recordList.clear();
+
+            while (true)
+            {
+                bool hasNext;
+
+                archive(hasNext);
+
+                if (!hasNext)
+                    break;
+
+                auto& [id, typeName, position, rotation, scale] = recordList.emplace_back();
+
+                archive(id, typeName, position, rotation, scale);
+            }
+        }
+
+        template <typename T, typename CerealWrite, typename CerealRead, typename WireWrite, typename WireRead>
+        static void Report(std::ostream& stream, const std::string& name, const size_t iterationCount, const T& input, CerealWrite cerealWrite, CerealRead cerealRead, WireWrite wireWrite, WireRead wireRead)
+        {
+            Result cerealResult;
+            Result wireResult;
+
+            T output;
+
+            {
+                std::string data;
+
+                const auto start = steady_clock::now();
+
+                for (size_t iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    std::ostringstream outputStream;
+
+                    {
+                        cereal::BinaryOutputArchive archive(outputStream);
+
+                        cerealWrite(archive, input);
+                    }
+
+                    data = outputStream.str();
+                }
+
+                const auto middle = steady_clock::now();
+
+                for (size_t iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    std::istringstream inputStream(data);
+                    cereal::BinaryInputArchive archive(inputStream);
+
+                    cerealRead(archive, output);
+                }
+
+                cerealResult = { GetAverage(middle - start, iterationCount), GetAverage(steady_clock::now() - middle, iterationCount), data.size() };
+            }
+
+            {
+                std::string data;
+
+                const auto start = steady_clock::now();
+
+                for (size_t iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    data.clear();
+
+                    WireOutputArchive archive(data);
+
+                    wireWrite(archive, input);
+                }
+
+                const auto middle = steady_clock::now();
+
+                for (size_t iteration = 0; iteration < iterationCount; ++iteration)
+                {
+                    WireInputArchive archive(data);
+
+                    wireRead(archive, output);
+                }
+
+                wireResult = { GetAverage(middle - start, iterationCount), GetAverage(steady_clock::now() - middle, iterationCount), data.size() };
+            }
+
+            PrintResult(stream, name, "cereal", cerealResult);
+            PrintResult(stream, name, "wire", wireResult);
+        }
+
+        static double GetAverage(const steady_clock::duration elapsed, const size_t iterationCount)
+        {
+            return duration<double, std::micro>(elapsed).count() / static_cast<double>(iterationCount);
+        }
+
+        static void PrintResult(std::ostream& stream, const std::string& name, const std::string& archiveName, const Result& result)
+        {
+            stream << "[Benchmark] " << name << " " << std::left << std::setw(6) << archiveName << std::right
+                   << ": encode=" << std::fixed << std::setprecision(1) << result.encodeMicroseconds << "us"
+                   << " decode=" << result.decodeMicroseconds << "us"
+                   << " bytes=" << result.byteCount << "\n";
+        }
+
+    };
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Independent/Network/WireArchive.hpp"
+#include "Independent/World/GenerationPipeline.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Benchmark
+{
+    class TerrainBenchmark final
+    {
+
+    public:
+
+        TerrainBenchmark(const TerrainBenchmark&) = delete;
+        TerrainBenchmark(TerrainBenchmark&&) = delete;
+        TerrainBenchmark& operator=(const TerrainBenchmark&) = delete;
+        TerrainBenchmark& operator=(TerrainBenchmark&&) = delete;
+
+        static void Run(std::ostream& stream, const int32_t radius = 8, const uint64_t seed = 0x5EED)
+        {
+            const size_t maximumThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+            std::vector<size_t> threadCountList;
+
+            for (size_t threadCount = 1; threadCount < maximumThreadCount; threadCount *= 2)
+                threadCountList.push_back(threadCount);
+
+            threadCountList.push_back(maximumThreadCount);
+
+            double baseline = 0.0;
+            uint64_t baselineHash = 0;
+            bool deterministic = true;
+
+            for (const size_t threadCount : threadCountList)
+            {
+                GenerationPipeline pipeline(seed, threadCount);
+
+                std::vector<std::unique_ptr<Chunk>> chunkList;
+
+                const auto start = steady_clock::now();
+
+                for (int32_t z = -radius; z < radius; ++z)
+                {
+                    for (int32_t x = -radius; x < radius; ++x)
+                        pipeline.Request({ x, z });
+                }
+
+                pipeline.Wait();
+
+                const double seconds = duration<double>(steady_clock::now() - start).count();
+
+                pipeline.Collect([&](std::unique_ptr<Chunk> chunk) { chunkList.push_back(std::move(chunk)); });
+
+                const uint64_t hash = Hash(chunkList);
+                const double chunksPerSecond = static_cast<double>(chunkList.size()) / seconds;
+
+                if (threadCount == 1)
+                {
+                    baseline = chunksPerSecond;
+                    baselineHash = hash;
+
+                    stream << "[Benchmark] terrain stages (1 thread):"
+                           << " heightmap=" << std::fixed << std::setprecision(2) << GetStageMilliseconds(pipeline, GenerationStage::Heightmap) << "ms"
+                           << " caves=" << GetStageMilliseconds(pipeline, GenerationStage::Caves) << "ms"
+                           << " decorations=" << GetStageMilliseconds(pipeline, GenerationStage::Decorated) << "ms per chunk\n";
+                }
+
+                deterministic = deterministic && hash == baselineHash;
+
+                stream << "[Benchmark] terrain " << std::setw(3) << threadCount << " threads"
+                       << ": chunks=" << chunkList.size()
+                       << " time=" << std::fixed << std::setprecision(3) << seconds << "s"
+                       << " chunks/s=" << std::setprecision(1) << chunksPerSecond
+                       << " chunks/s/core=" << chunksPerSecond / static_cast<double>(threadCount)
+                       << " speedup=" << std::setprecision(2) << chunksPerSecond / baseline << "x"
+                       << " hash=" << std::hex << hash << std::dec << "\n";
+            }
+
+            stream << "[Benchmark] terrain output is " << (deterministic ? "identical" : "DIFFERENT") << " across thread counts\n";
+        }
+
+    private:
+
+        TerrainBenchmark() = default;
+
+        static double GetStageMilliseconds(const GenerationPipeline& pipeline, const GenerationStage stage)
+        {
+            return pipeline.GetStageSeconds(stage) * 1000.0 / static_cast<double>(std::max<uint64_t>(pipeline.GetStageCount(stage), 1));
+        }
+
+        static uint64_t Hash(std::vector<std::unique_ptr<Chunk>>& chunkList)
+        {
+            std::ranges::sort(chunkList, [](const auto& left, const auto& right)
+            {
+                const auto a = left->GetCoordinate();
+                const auto b = right->GetCoordinate();
+
+                return a.x != b.x ? a.x < b.x : a.z < b.z;
+            });
+
+            uint64_t result = 0xCBF29CE484222325ull;
+
+            std::string data;
+
+            for (const auto& chunk : chunkList)
+            {
+                data.clear();
+
+                WireOutputArchive archive(data);
+
+                chunk->Serialize(archive);
+
+                for (const char character : data)
+                    result = (result ^ static_cast<uint8_t>(character)) * 0x100000001B3ull;
+            }
+
+            return result;
+        }
+
+    };
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Client/Packet/RpcClient.hpp"
+#include "Independent/Network/NetworkManager.hpp"
+#include "Independent/Network/PacketCompressor.hpp"
+#include "Server/RPC/RpcRegistry.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Client::Packet;
+using namespace MultiVoxel::Server::Rpc;
+
+namespace MultiVoxel::Bot
+{
+    struct BotBehavior
+    {
+        float moveRate = 20.0f;
+        float orbitRadius = 8.0f;
+        float orbitSpeed = 1.0f;
+
+        milliseconds probeInterval{ 1000 };
+    };
+
+    class Bot final
+    {
+
+    public:
+
+        struct Statistics
+        {
+            uint64_t sentPacketCount = 0;
+            uint64_t sentByteCount = 0;
+            uint64_t receivedPacketCount = 0;
+            uint64_t receivedByteCount = 0;
+            uint64_t moveEchoCount = 0;
+
+            std::vector<float> latencyList;
+
+            [[nodiscard]]
+            float GetLatencyPercentile(const float percentile) const
+            {
+                if (latencyList.empty())
+                    return 0.0f;
+
+                std::vector<float> sorted = latencyList;
+
+                const auto index = static_cast<size_t>(percentile * static_cast<float>(sorted.size() - 1));
+
+                std::ranges::nth_element(sorted, sorted.begin() + static_cast<std::ptrdiff_t>(index));
+
+                return sorted[index];
+            }
+        };
+
+        Bot(NetworkManager& networkManager, const size_t index, const HSteamNetConnection handle, std::string name, const BotBehavior& behavior) : networkManager(networkManager), index(index), handle(handle), name(std::move(name)), behavior(behavior) { }
+
+        Bot(const Bot&) = delete;
+        Bot(Bot&&) = delete;
+        Bot& operator=(const Bot&) = delete;
+        Bot& operator=(Bot&&) = delete;
+
+        void Update(const steady_clock::time_point now)
+        {
+            if (!UpdateConnectionState(now))
+                return;
+
+            if (objectId == 0 && pendingCallMap.empty())
+                Call<RpcType::CreateGameObject>(now, name, static_cast<NetworkId>(0));
+
+            if (objectId != 0 && behavior.moveRate > 0.0f)
+            {
+                const auto moveInterval = duration_cast<steady_clock::duration>(duration<float>(1.0f / behavior.moveRate));
+
+                while (now >= nextMove)
+                {
+                    const float angle = duration<float>(nextMove - connectedAt).count() * behavior.orbitSpeed + static_cast<float>(index);
+
+                    requestBatch.Write<RpcType::MoveGameObjectRequest>(0, objectId, Vector<float, 3>{ std::cos(angle) * behavior.orbitRadius, 0.0f, std::sin(angle) * behavior.orbitRadius }, Vector<float, 3>{ 0.0f, angle, 0.0f });
+
+                    nextMove += moveInterval;
+                }
+            }
+
+            if (objectId != 0 && now >= nextProbe)
+            {
+                Call<RpcType::RequestSubtreeHashes>(now, objectId);
+
+                nextProbe = now + behavior.probeInterval;
+            }
+
+            if (requestBatch.IsEmpty())
+                return;
+
+            const auto message = PacketCompressor::GetInstance().Pack(RpcClient::RpcChannelName, requestBatch.Take());
+
+            statistics.sentPacketCount++;
+            statistics.sentByteCount += message.GetBuffer().size();
+
+            if (!networkManager.SendTo(handle, message))
+            {
+                connected = false;
+                closed = true;
+            }
+        }
+
+        void OnMessageReceived(const Message& message)
+        {
+            statistics.receivedPacketCount++;
+            statistics.receivedByteCount += message.GetBuffer().size();
+
+            std::string channel;
+            std::string data;
+
+            try
+            {
+                if (!PacketCompressor::GetInstance().Unpack(message, channel, data) || channel != RpcClient::RpcChannelName)
+                    return;
+
+                WireInputArchive archive(data);
+
+                uint32_t callCount;
+                archive(callCount);
+
+                while (callCount--)
+                {
+                    uint64_t callId;
+                    RpcType rpcType;
+
+                    archive(callId, rpcType);
+
+                    if (!GetResponseTable().Dispatch(*this, rpcType, callId, archive))
+                        break;
+                }
+            }
+            catch (const WireArchiveError& error)
+            {
+                std::cerr << "Bot: malformed packet for '" << name << "': " << error.what() << "\n";
+            }
+        }
+
+        [[nodiscard]]
+        HSteamNetConnection GetHandle() const
+        {
+            return handle;
+        }
+
+        [[nodiscard]]
+        const std::string& GetName() const
+        {
+            return name;
+        }
+
+        [[nodiscard]]
+        bool IsConnected() const
+        {
+            return connected;
+        }
+
+        [[nodiscard]]
+        bool IsClosed() const
+        {
+            return closed;
+        }
+
+        [[nodiscard]]
+        int GetPing() const
+        {
+            ConnectionStatus status;
+
+            if (!networkManager.GetTransport()->GetConnectionStatus(handle, status))
+                return -1;
+
+            return status.ping;
+        }
+
+        [[nodiscard]]
+        const Statistics& GetStatistics() const
+        {
+            return statistics;
+        }
+
+    private:
+
+        template <RpcType TYPE, typename... Arguments>
+        void Call(const steady_clock::time_point now, Arguments&&... arguments)
+        {
+            const uint64_t callId = nextCallId++;
+
+            pendingCallMap[callId] = now;
+
+            requestBatch.Write<TYPE>(callId, std::forward<Arguments>(arguments)...);
+        }
+
+        void CompleteCall(const uint64_t callId)
+        {
+            const auto iterator = pendingCallMap.find(callId);
+
+            if (iterator == pendingCallMap.end())
+                return;
+
+            statistics.latencyList.push_back(duration<float, std::milli>(steady_clock::now() - iterator->second).count());
+
+            pendingCallMap.erase(iterator);
+        }
+
+        bool UpdateConnectionState(const steady_clock::time_point now)
+        {
+            if (connected || closed)
+                return connected;
+
+            switch (networkManager.GetTransport()->GetConnectionState(handle))
+            {
+
+            case Transport::ConnectionState::Connected:
+                connected = true;
+                connectedAt = now;
+                nextMove = now;
+                nextProbe = now + behavior.probeInterval;
+                return true;
+
+            case Transport::ConnectionState::Closed:
+                closed = true;
+                return false;
+
+            default:
+                return false;
+            }
+        }
+
+        static const RpcDispatchTable<Bot&>& GetResponseTable()
+        {
+            static const RpcDispatchTable<Bot&> table = []()
+            {
+                RpcDispatchTable<Bot&> result;
+
+                result.Register<RpcType::CreateGameObjectResponse>([](Bot& bot, const uint64_t callId, const NetworkId id, const std::string&, NetworkId)
+                {
+                    if (bot.pendingCallMap.contains(callId))
+                        bot.objectId = id;
+
+                    bot.CompleteCall(callId);
+                });
+
+                result.Register<RpcType::SubtreeHashesResponse>([](Bot& bot, const uint64_t callId, NetworkId, const std::vector<HierarchyHash::Entry>&)
+                {
+                    bot.CompleteCall(callId);
+                });
+
+                result.Register<RpcType::MoveGameObjectResponse>([](Bot& bot, uint64_t, NetworkId, const Vector<float, 3>&, const Vector<float, 3>&)
+                {
+                    bot.statistics.moveEchoCount++;
+                });
+
+                result.Register<RpcType::AddChildResponse>([](Bot&, uint64_t, NetworkId, NetworkId) { });
+                result.Register<RpcType::AddComponentResponse>([](Bot&, uint64_t, NetworkId, const std::string&, const std::string&) { });
+                result.Register<RpcType::RemoveComponentResponse>([](Bot&, uint64_t, NetworkId, const std::string&) { });
+                result.Register<RpcType::BlobResponse>([](Bot&, uint64_t, uint64_t, bool, const std::string&) { });
+
+                return result;
+            }();
+
+            return table;
+        }
+
+        NetworkManager& networkManager;
+
+        size_t index;
+        HSteamNetConnection handle;
+        std::string name;
+        BotBehavior behavior;
+
+        bool connected = false;
+        bool closed = false;
+
+        NetworkId objectId = 0;
+        uint64_t nextCallId = 1;
+
+        steady_clock::time_point connectedAt;
+        steady_clock::time_point nextMove;
+        steady_clock::time_point nextProbe;
+
+        RpcBatch requestBatch;
+
+        std::unordered_map<uint64_t, steady_clock::time_point> pendingCallMap;
+
+        Statistics statistics;
+
+    };
+}
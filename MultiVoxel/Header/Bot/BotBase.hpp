@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Bot/Bot.hpp"
+#include "Independent/Network/NetworkManager.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Network;
+
+namespace MultiVoxel::Bot
+{
+    class BotBase final
+    {
+
+    public:
+
+        BotBase(const BotBase&) = delete;
+        BotBase(BotBase&&) = delete;
+        BotBase& operator=(const BotBase&) = delete;
+        BotBase& operator=(BotBase&&) = delete;
+
+        bool Initialize(const std::string& address, const uint16_t port, const size_t botCount, const BotBehavior& behavior = { })
+        {
+            return Initialize(NetworkManager::GetInstance(), address, port, botCount, behavior);
+        }
+
+        bool Initialize(NetworkManager& manager, const std::string& address, const uint16_t port, const size_t botCount, const BotBehavior& behavior = { })
+        {
+            networkManager = &manager;
+
+            const auto sessionTag = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count() % 1000000;
+
+            for (size_t index = 0; index < botCount; ++index)
+            {
+                HSteamNetConnection handle;
+
+                if (!networkManager->ConnectToServer(address, port, &handle))
+                {
+                    std::cerr << "Bot: failed to connect bot " << index << " to " << address << ":" << port << "\n";
+                    return false;
+                }
+
+                botList.push_back(std::make_unique<Bot>(*networkManager, index, handle, "bot_" + std::to_string(sessionTag) + "_" + std::to_string(index), behavior));
+                botMap[handle] = botList.back().get();
+            }
+
+            const auto packetHandler = [&](PeerConnection& peer, Message const& msg)
+            {
+                if (const auto iterator = botMap.find(peer.GetHandle()); iterator != botMap.end())
+                    iterator->second->OnMessageReceived(msg);
+            };
+
+            networkManager->GetDispatcher().RegisterHandler(Message::Type::Custom, packetHandler);
+            networkManager->GetDispatcher().RegisterHandler(Message::Type::CompressedCustom, packetHandler);
+
+            startTime = steady_clock::now();
+            lastReport = startTime;
+
+            isInitialized = true;
+
+            return true;
+        }
+
+        void Run(const seconds runDuration)
+        {
+            if (!isInitialized)
+                return;
+
+            while (runDuration.count() <= 0 || steady_clock::now() - startTime < runDuration)
+            {
+                auto start = steady_clock::now();
+
+                if (!Tick(start))
+                    break;
+
+                if (auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start); elapsed < TickInterval)
+                    std::this_thread::sleep_for(TickInterval - elapsed);
+            }
+
+            PrintStatistics(std::cout, duration<double>(steady_clock::now() - startTime).count());
+        }
+
+        bool Tick(const steady_clock::time_point now)
+        {
+            networkManager->PollEvents();
+
+            for (const auto& bot : botList)
+                bot->Update(now);
+
+            networkManager->FlushOutgoing();
+
+            if (now - lastReport >= ReportInterval)
+            {
+                const auto totals = GetTotals();
+                const double elapsed = duration<double>(now - lastReport).count();
+
+                std::cout << "[Bot] connected=" << totals.connectedCount << "/" << botList.size()
+                          << " up=" << std::fixed << std::setprecision(1) << static_cast<double>(totals.sentByteCount - lastTotals.sentByteCount) / elapsed / 1024.0 << "KiB/s"
+                          << " down=" << static_cast<double>(totals.receivedByteCount - lastTotals.receivedByteCount) / elapsed / 1024.0 << "KiB/s\n";
+
+                lastTotals = totals;
+                lastReport = now;
+            }
+
+            if (std::ranges::all_of(botList, [](const auto& bot) { return bot->IsClosed(); }))
+            {
+                std::cerr << "Bot: every bot has disconnected, stopping.\n";
+                return false;
+            }
+
+            return true;
+        }
+
+        void PrintStatistics(std::ostream& stream, const double elapsedSeconds) const
+        {
+            std::vector<float> latencyList;
+
+            for (const auto& bot : botList)
+            {
+                const auto& statistics = bot->GetStatistics();
+
+                stream << "[Bot] " << bot->GetName()
+                       << ": ping=" << bot->GetPing() << "ms"
+                       << " rpc p50=" << std::fixed << std::setprecision(1) << statistics.GetLatencyPercentile(0.5f) << "ms"
+                       << " p99=" << statistics.GetLatencyPercentile(0.99f) << "ms"
+                       << " up=" << static_cast<double>(statistics.sentByteCount) / elapsedSeconds / 1024.0 << "KiB/s"
+                       << " down=" << static_cast<double>(statistics.receivedByteCount) / elapsedSeconds / 1024.0 << "KiB/s"
+                       << " echoes=" << statistics.moveEchoCount << "\n";
+
+                latencyList.insert(latencyList.end(), statistics.latencyList.begin(), statistics.latencyList.end());
+            }
+
+            Bot::Statistics combined;
+
+            combined.latencyList = std::move(latencyList);
+
+            const auto totals = GetTotals();
+
+            stream << "[Bot] total: bots=" << botList.size()
+                   << " connected=" << totals.connectedCount
+                   << " rpc p50=" << combined.GetLatencyPercentile(0.5f) << "ms"
+                   << " p99=" << combined.GetLatencyPercentile(0.99f) << "ms"
+                   << " up=" << static_cast<double>(totals.sentByteCount) / elapsedSeconds / 1024.0 << "KiB/s"
+                   << " down=" << static_cast<double>(totals.receivedByteCount) / elapsedSeconds / 1024.0 << "KiB/s\n";
+        }
+
+        static constexpr milliseconds TickInterval{ 16 };
+
+        static BotBase& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<BotBase>(new BotBase());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        static constexpr seconds ReportInterval{ 5 };
+
+        struct Totals
+        {
+            size_t connectedCount = 0;
+            uint64_t sentByteCount = 0;
+            uint64_t receivedByteCount = 0;
+        };
+
+        BotBase() = default;
+
+        [[nodiscard]]
+        Totals GetTotals() const
+        {
+            Totals result;
+
+            for (const auto& bot : botList)
+            {
+                result.connectedCount += bot->IsConnected() ? 1 : 0;
+                result.sentByteCount += bot->GetStatistics().sentByteCount;
+                result.receivedByteCount += bot->GetStatistics().receivedByteCount;
+            }
+
+            return result;
+        }
+
+        bool isInitialized = false;
+
+        NetworkManager* networkManager = nullptr;
+
+        steady_clock::time_point startTime;
+        steady_clock::time_point lastReport;
+        Totals lastTotals;
+
+        std::vector<std::unique_ptr<Bot>> botList;
+        std::unordered_map<HSteamNetConnection, Bot*> botMap;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<BotBase> instance;
+
+    };
+
+    std::once_flag BotBase::initializationFlag;
+    std::unique_ptr<BotBase> BotBase::instance;
+}
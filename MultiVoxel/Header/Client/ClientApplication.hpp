@@ -8,6 +8,7 @@
 #include "Client/Render/Mesh.hpp"
 #include "Client/Render/ShaderManager.hpp"
 #include "Client/ClientBase.hpp"
+#include "Client/Packet/BlockDeltaReceiver.hpp"
 #include "Independent/ECS/ComponentFactory.hpp"
 #include "Independent/ECS/GameObjectManager.hpp"
 #include "Independent/Thread/MainThreadExecutor.hpp"
@@ -64,6 +65,9 @@ namespace MultiVoxel::Client
 				return &temp;
 			}());
 
+			ClientBase::GetInstance().RegisterPacketSender(&BlockDeltaReceiver::GetInstance());
+			ClientBase::GetInstance().RegisterPacketReceiver(&BlockDeltaReceiver::GetInstance());
+
 			Window::GetInstance().Initialize("MultiVoxel* 3.12.2", { 750, 450 });
 
 			InputManager::GetInstance().Initialize();
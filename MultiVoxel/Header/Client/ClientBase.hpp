@@ -4,13 +4,10 @@
 #include <thread>
 #include <chrono>
 #include <sstream>
-#include <cereal/cereal.hpp>
-#include <cereal/archives/binary.hpp>
-#include <cereal/types/string.hpp>
-#include <cereal/types/vector.hpp>
 #include "Client/Core/Window.hpp"
 #include "Client/ClientInterfaceLayer.hpp"
 #include "Independent/Network/NetworkManager.hpp"
+#include "Independent/Network/PacketCompressor.hpp"
 #include "Independent/Network/PacketReceiver.hpp"
 #include "Independent/Network/PacketSender.hpp"
 
@@ -44,29 +41,35 @@ namespace MultiVoxel::Client
                 return false;
             }
 
-            networkManager.GetDispatcher()
-                .RegisterHandler(Message::Type::Custom,
-                    [&](PeerConnection&, Message const& msg)
-                    {
-                        const auto& buffer = msg.GetBuffer();
-
-                        std::string dataIn{ reinterpret_cast<const char*>(buffer.data()), buffer.size() };
+            const auto packetHandler = [&](PeerConnection&, Message const& msg)
+            {
+                std::string name;
+                std::string data;
 
-                        std::istringstream stream(dataIn);
-                        cereal::BinaryInputArchive archive(stream);
+                try
+                {
+                    if (!PacketCompressor::GetInstance().Unpack(msg, name, data))
+                        return;
 
-                        std::string name;
-                        std::string data;
+                    NetworkStatistics::GetInstance().RecordReceived(NetworkStatistics::Category::Channel, name, msg.GetBuffer().size());
 
-                        archive(name, data);
+                    for (auto* receiver : packetReceiverList)
+                        receiver->OnPacketReceived(IndexedString(name), data);
+                }
+                catch (const WireArchiveError& error)
+                {
+                    std::cerr << "Client: malformed packet on channel '" << name << "': " << error.what() << "\n";
+                }
+            };
 
-                        for (auto* receiver : packetReceiverList)
-                            receiver->OnPacketReceived(IndexedString(name), data);
-                    });
+            networkManager.GetDispatcher().RegisterHandler(Message::Type::Custom, packetHandler);
+            networkManager.GetDispatcher().RegisterHandler(Message::Type::CompressedCustom, packetHandler);
 
             ClientInterfaceLayer::GetInstance().CallEvent("preinitialize");
             ClientInterfaceLayer::GetInstance().CallEvent("initialize");
 
+            networkManager.StartNetworkThread();
+
             isInitialized = true;
 
             return true;
@@ -94,19 +97,19 @@ namespace MultiVoxel::Client
 
                     while (sender->SendPacket(packetName, packetData))
                     {
-                        std::ostringstream stream;
-                        cereal::BinaryOutputArchive archive(stream);
+                        const auto message = PacketCompressor::GetInstance().Pack(packetName, packetData);
 
-                        archive(packetName, packetData);
+                        networkManager.Broadcast(message);
 
-                        auto const& buffer = stream.str();
-
-                        networkManager.Broadcast(Message::Create(Message::Type::Custom, buffer.data(), buffer.size(), true));
+                        NetworkStatistics::GetInstance().RecordSent(NetworkStatistics::Category::Channel, packetName, message.GetBuffer().size());
                     }
                 }
 
                 networkManager.FlushOutgoing();
 
+                if (NetworkStatistics::GetInstance().IsReportDue())
+                    NetworkStatistics::GetInstance().Report(std::cout, networkManager.GetPeerStatuses());
+
                 ClientInterfaceLayer::GetInstance().CallEvent("update");
                 ClientInterfaceLayer::GetInstance().CallEvent("render");
 
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Independent/Network/PacketReceiver.hpp"
+#include "Independent/Network/PacketSender.hpp"
+#include "Independent/World/BlockDeltaCodec.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Client::Packet
+{
+    class BlockDeltaReceiver final : public PacketSender, public PacketReceiver
+    {
+
+    public:
+
+        static constexpr size_t MaximumRequestsPerPacket = 256;
+        static constexpr milliseconds ResyncRetryInterval{ 1000 };
+
+        BlockDeltaReceiver(const BlockDeltaReceiver&) = delete;
+        BlockDeltaReceiver(BlockDeltaReceiver&&) = delete;
+        BlockDeltaReceiver& operator=(const BlockDeltaReceiver&) = delete;
+        BlockDeltaReceiver& operator=(BlockDeltaReceiver&&) = delete;
+
+        void Reload(HSteamNetConnection) override { }
+
+        bool SendPacket(std::string& outName, std::string& outData) override
+        {
+            if (requestList.empty())
+                return false;
+
+            const size_t count = std::min(requestList.size(), MaximumRequestsPerPacket);
+
+            outName = BlockDeltaChannelName;
+            outData.clear();
+
+            WireOutputArchive archive(outData);
+
+            archive(BlockDeltaType::ResyncRequest, static_cast<uint32_t>(count));
+
+            for (size_t index = 0; index < count; ++index)
+                archive(requestList[index]);
+
+            requestList.erase(requestList.begin(), requestList.begin() + static_cast<std::ptrdiff_t>(count));
+
+            return true;
+        }
+
+        void OnPacketReceived(const std::string& name, const std::string& data) override
+        {
+            if (name != BlockDeltaChannelName)
+                return;
+
+            WireInputArchive archive(data);
+
+            BlockDeltaType type;
+            uint32_t count;
+
+            archive(type, count);
+
+            if (type == BlockDeltaType::Delta)
+            {
+                while (count--)
+                    ReadDelta(archive);
+            }
+            else if (type == BlockDeltaType::Resync)
+            {
+                while (count--)
+                    ReadResync(archive);
+            }
+        }
+
+        [[nodiscard]]
+        std::optional<uint32_t> GetChunkVersion(const ChunkCoordinate coordinate) const
+        {
+            const auto iterator = versionMap.find(coordinate);
+
+            return iterator == versionMap.end() ? std::nullopt : std::optional(iterator->second);
+        }
+
+        [[nodiscard]]
+        size_t GetAppliedCount() const
+        {
+            return appliedCount;
+        }
+
+        [[nodiscard]]
+        size_t GetGapCount() const
+        {
+            return gapCount;
+        }
+
+        static BlockDeltaReceiver& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<BlockDeltaReceiver>(new BlockDeltaReceiver());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        BlockDeltaReceiver() = default;
+
+        void ReadDelta(WireInputArchive& archive)
+        {
+            ChunkCoordinate coordinate;
+
+            uint32_t baseVersion;
+            uint32_t version;
+
+            archive(coordinate, baseVersion, version);
+
+            const auto body = archive.ReadLengthPrefixed();
+
+            const auto iterator = versionMap.find(coordinate);
+            const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+            if (iterator == versionMap.end() || iterator->second < baseVersion || !chunk)
+            {
+                gapCount++;
+                RequestResync(coordinate);
+                return;
+            }
+
+            if (iterator->second >= version)
+                return;
+
+            WireInputArchive bodyArchive(body);
+
+            BlockDeltaCodec::ApplySections(bodyArchive, *chunk);
+
+            iterator->second = version;
+            appliedCount++;
+        }
+
+        void ReadResync(WireInputArchive& archive)
+        {
+            ChunkCoordinate coordinate;
+
+            bool present;
+
+            archive(coordinate, present);
+
+            requestedMap.erase(coordinate);
+
+            if (!present)
+            {
+                versionMap.erase(coordinate);
+                ChunkManager::GetInstance().Remove(coordinate);
+                return;
+            }
+
+            auto chunk = BlockDeltaCodec::ReadChunk(archive, coordinate);
+
+            versionMap[coordinate] = chunk->GetVersion();
+
+            ChunkManager::GetInstance().Insert(std::move(chunk));
+        }
+
+        void RequestResync(const ChunkCoordinate coordinate)
+        {
+            const auto now = steady_clock::now();
+
+            const auto [iterator, inserted] = requestedMap.try_emplace(coordinate, now);
+
+            if (!inserted && now - iterator->second < ResyncRetryInterval)
+                return;
+
+            iterator->second = now;
+            requestList.push_back(coordinate);
+        }
+
+        std::unordered_map<ChunkCoordinate, uint32_t, ChunkCoordinateHash> versionMap;
+        std::unordered_map<ChunkCoordinate, steady_clock::time_point, ChunkCoordinateHash> requestedMap;
+        std::vector<ChunkCoordinate> requestList;
+
+        size_t appliedCount = 0;
+        size_t gapCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<BlockDeltaReceiver> instance;
+
+    };
+
+    std::once_flag BlockDeltaReceiver::initializationFlag;
+    std::unique_ptr<BlockDeltaReceiver> BlockDeltaReceiver::instance;
+}
@@ -2,12 +2,14 @@
 
 #include <vector>
 #include <string>
-#include <sstream>
 #include <future>
-#include <cereal/archives/binary.hpp>
+#include <unordered_set>
 #include "Independent/ECS/GameObjectManager.hpp"
+#include "Independent/ECS/HierarchyHash.hpp"
+#include "Independent/Network/ContentStore.hpp"
 #include "Independent/Network/PacketReceiver.hpp"
 #include "Independent/Network/PacketSender.hpp"
+#include "Server/RPC/RpcRegistry.hpp"
 #include "Server/RPC/RpcTypes.hpp"
 
 using namespace MultiVoxel::Independent::ECS;
@@ -21,59 +23,65 @@ namespace MultiVoxel::Client::Packet
 
     public:
 
-        void Reload() override
+        void Reload(HSteamNetConnection) override
         {
-            requestList.push_back({ 0, RpcType::RequestFullSync, "", 0});
+            std::lock_guard guard(mutex);
+
+            requestBatch.Write<RpcType::RequestFullSync>(0);
         }
 
         void MoveGameObject(const NetworkId id, const Vector<float, 3>& position, const Vector<float, 3>& rotation)
         {
             std::lock_guard guard(mutex);
 
-            requestList.push_back({ 0, RpcType::MoveGameObjectRequest, std::string(), id, SerializePositionRotation(position, rotation) });
+            requestBatch.Write<RpcType::MoveGameObjectRequest>(0, id, position, rotation);
         }
 
         std::future<std::shared_ptr<GameObject>> CreateGameObjectAsync(const std::string& name, const NetworkId parentId)
         {
-            uint64_t callId = nextCallId++;
+            std::lock_guard guard(mutex);
 
-            {
-                std::lock_guard guard(mutex);
-                pendingCreateMap.emplace(callId, std::promise<std::shared_ptr<GameObject>>());
-            }
-            
-            requestList.push_back({ callId, RpcType::CreateGameObject, name, parentId });
+            const uint64_t callId = nextCallId++;
+
+            auto result = pendingCreateMap[callId].get_future();
 
-            return pendingCreateMap[callId].get_future();
+            requestBatch.Write<RpcType::CreateGameObject>(callId, name, parentId);
+
+            return result;
         }
 
-        void DestroyGameObject(const std::string& name)
+        void DestroyGameObject(const NetworkId id)
         {
-            requestList.push_back({ 0, RpcType::DestroyGameObject, name, 0 });
+            std::lock_guard guard(mutex);
+
+            requestBatch.Write<RpcType::DestroyGameObject>(0, id);
         }
 
-        void AddChildToGameObject(const std::string& name, const NetworkId childId)
+        void AddChildToGameObject(const NetworkId parentId, const NetworkId childId)
         {
-            requestList.push_back({ 0, RpcType::AddChild, name, childId });
+            std::lock_guard guard(mutex);
+
+            requestBatch.Write<RpcType::AddChild>(0, parentId, childId);
         }
 
-        void RemoveChildFromGameObject(const std::string& name, const NetworkId childId)
+        void RemoveChildFromGameObject(const NetworkId parentId, const NetworkId childId)
         {
-            requestList.push_back({ 0, RpcType::RemoveChild, name, childId });
+            std::lock_guard guard(mutex);
+
+            requestBatch.Write<RpcType::RemoveChild>(0, parentId, childId);
         }
 
         std::future<std::shared_ptr<Component>> AddComponentAsync(const NetworkId objectId, const std::string& compTypeName, const std::string& payload)
         {
-            uint64_t callId = nextCallId++;
-            {
-                std::lock_guard guard(mutex);
+            std::lock_guard guard(mutex);
 
-                pendingComponentMap.emplace(callId, std::promise<std::shared_ptr<Component>>());
-            }
+            const uint64_t callId = nextCallId++;
+
+            auto result = pendingComponentMap[callId].get_future();
 
-            requestList.push_back({ callId, RpcType::AddComponent, compTypeName, objectId, payload });
+            requestBatch.Write<RpcType::AddComponent>(callId, compTypeName, objectId, payload);
 
-            return pendingComponentMap[callId].get_future();
+            return result;
         }
 
         template <ComponentType T>
@@ -81,13 +89,13 @@ namespace MultiVoxel::Client::Packet
         {
             static_assert(std::derived_from<T, Component>);
 
-            std::ostringstream stream;
+            std::string payload;
             {
-                cereal::BinaryOutputArchive archive(stream);
+                WireOutputArchive archive(payload);
                 prototype->Serialize(archive);
             }
 
-            auto baseFuture = AddComponentAsync(objectId, typeid(T).name(), stream.str());
+            auto baseFuture = AddComponentAsync(objectId, typeid(T).name(), payload);
 
             std::promise<std::shared_ptr<T>> promise;
             auto result = promise.get_future();
@@ -105,57 +113,38 @@ namespace MultiVoxel::Client::Packet
 
         void RemoveComponent(const NetworkId objectId, const std::string& typeName)
         {
-            requestList.push_back({ 0, RpcType::RemoveComponent, typeName, objectId });
+            std::lock_guard guard(mutex);
+
+            requestBatch.Write<RpcType::RemoveComponent>(0, typeName, objectId);
         }
 
-        bool SendPacket(std::string& outName, std::string& outData) override
+        void RequestBlob(const ContentHash hash)
         {
-            if (requestList.empty())
-                return false;
+            std::lock_guard guard(mutex);
 
-            std::ostringstream stream;
-            cereal::BinaryOutputArchive archive(stream);
+            requestBatch.Write<RpcType::RequestBlob>(0, hash);
+        }
 
-            archive(static_cast<uint32_t>(requestList.size()));
+        void ReconcileHierarchy()
+        {
+            std::lock_guard guard(mutex);
 
-            for (auto& [callId, type, name, parentId, payload] : requestList)
-            {
-                archive(callId, type);
+            if (pendingSubtreeRequestCount > 0)
+                return;
 
-                switch (type)
-                {
-                    case RpcType::CreateGameObject:
-                    case RpcType::AddChild:
-                    case RpcType::RequestFullSync:
-                        archive(name, parentId);
-                        break;
-
-                    case RpcType::DestroyGameObject:
-                        archive(parentId);
-                        break;
-
-                    case RpcType::AddComponent:
-                        archive(name, parentId);
-                        archive(payload);
-                        break;
-
-                    case RpcType::RemoveComponent:
-                        archive(name, parentId);
-                        break;
-
-                    case RpcType::MoveGameObjectRequest:
-                        archive(parentId, payload);
-                        break;
-
-                    default:
-                        break;
-                }
-            }
+            requestBatch.Write<RpcType::RequestSubtreeHashes>(0, HierarchyHash::RootId);
+            ++pendingSubtreeRequestCount;
+        }
 
-            requestList.clear();
+        bool SendPacket(std::string& outName, std::string& outData) override
+        {
+            std::lock_guard guard(mutex);
+
+            if (requestBatch.IsEmpty())
+                return false;
 
             outName = RpcChannelName;
-            outData = stream.str();
+            outData = requestBatch.Take();
 
             return true;
         }
@@ -165,165 +154,195 @@ namespace MultiVoxel::Client::Packet
             if (name != RpcChannelName)
                 return;
 
-            std::istringstream stream(data);
-            cereal::BinaryInputArchive archive(stream);
+            WireInputArchive archive(data);
 
             uint32_t callCount;
             archive(callCount);
 
             while (callCount--)
             {
+                const auto start = archive.GetPosition();
+
                 uint64_t callId;
                 RpcType rpcType;
 
                 archive(callId, rpcType);
 
-                if (rpcType == RpcType::MoveGameObjectResponse)
+                if (!responseTable.Dispatch(rpcType, callId, archive))
                 {
-                    NetworkId id;
-                    std::string payload;
+                    std::cerr << "No RPC response handler registered for type '" << static_cast<uint32_t>(rpcType) << "'.\n";
+                    break;
+                }
 
-                    archive(id, payload);
+                NetworkStatistics::GetInstance().RecordReceived(NetworkStatistics::Category::Rpc, GetRpcTypeName(rpcType), archive.GetPosition() - start);
+            }
+        }
 
-                    auto [position, rotation] = DeserializePositionRotation(payload);
+        static RpcClient& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<RpcClient>(new RpcClient());
+            });
+            
+            return *instance;
+        }
 
-                    if (auto gameObject = GameObjectManager::GetInstance().Get(id))
-                    {
-                        //gameObject.value()->GetTransform()->SetTargetTransform(position, rotation, 0.1f); TODO: Implement this later
+        static const std::string RpcChannelName;
 
-                        gameObject.value()->GetTransform()->SetLocalPosition(position);
-                        gameObject.value()->GetTransform()->SetLocalRotation(rotation);
-                    }
-                }
-                else if (rpcType == RpcType::CreateGameObjectResponse)
-                {
-                    NetworkId newId;
+    private:
 
-                    std::string gameObjectName;
+        RpcClient()
+        {
+            responseTable.Register<RpcType::MoveGameObjectResponse>([](uint64_t, const NetworkId id, const Vector<float, 3>& position, const Vector<float, 3>& rotation)
+            {
+                if (auto gameObject = GameObjectManager::GetInstance().Get(id))
+                {
+                    //gameObject.value()->GetTransform()->SetTargetTransform(position, rotation, 0.1f); TODO: Implement this later
 
-                    NetworkId parentId;
+                    gameObject.value()->GetTransform()->SetLocalPosition(position);
+                    gameObject.value()->GetTransform()->SetLocalRotation(rotation);
+                }
+            });
 
-                    archive(newId, gameObjectName, parentId);
+            responseTable.Register<RpcType::CreateGameObjectResponse>([this](const uint64_t callId, const NetworkId newId, const std::string& gameObjectName, const NetworkId parentId)
+            {
+                auto gameObject = GameObject::Create(IndexedString(gameObjectName));
 
-                    auto gameObject = GameObject::Create(IndexedString(gameObjectName));
+                gameObject->SetNetworkId(newId);
 
-                    gameObject->SetNetworkId(newId);
+                if (parentId != 0)
+                    GameObjectManager::GetInstance().Get(parentId).value()->AddChild(gameObject);
 
-                    if (parentId != 0)
-                        GameObjectManager::GetInstance().Get(parentId).value()->AddChild(gameObject);
+                GameObjectManager::GetInstance().Register(gameObject);
 
-                    GameObjectManager::GetInstance().Register(gameObject);
+                std::lock_guard guard(mutex);
 
-                    std::lock_guard guard(mutex);
+                if (auto iterator = pendingCreateMap.find(callId); iterator != pendingCreateMap.end())
+                {
+                    iterator->second.set_value(gameObject);
 
-                    pendingCreateMap[callId].set_value(gameObject);
-                    pendingCreateMap.erase(callId);
+                    pendingCreateMap.erase(iterator);
                 }
-                else if (rpcType == RpcType::AddComponentResponse)
-                {
-                    NetworkId objectId;
-                    std::string compTypeName;
-                    archive(objectId, compTypeName);
+            });
 
-                    std::string payload;
+            responseTable.Register<RpcType::AddComponentResponse>([this](const uint64_t callId, const NetworkId objectId, const std::string& compTypeName, const std::string& payload)
+            {
+                auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId);
 
-                    archive(payload);
+                std::shared_ptr<Component> component = nullptr;
 
-                    auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId);
+                if (optionalGameObject)
+                {
+                    component = ComponentFactory::Create(compTypeName);
 
-                    std::shared_ptr<Component> component = nullptr;
+                    optionalGameObject.value()->AddComponentDynamic(component);
 
-                    if (optionalGameObject)
                     {
-                        component = ComponentFactory::Create(compTypeName);
-                        
-                        optionalGameObject.value()->AddComponentDynamic(component);
-
-                        {
-                            std::istringstream componentStream(payload);
-                            cereal::BinaryInputArchive componentArchive(componentStream);
+                        WireInputArchive componentArchive(payload);
 
-                            if (auto* networkComponent = dynamic_cast<INetworkSerializable*>(component.get()))
-                                networkComponent->Deserialize(componentArchive);
-                        }
+                        if (auto* networkComponent = dynamic_cast<INetworkSerializable*>(component.get()))
+                            networkComponent->Deserialize(componentArchive);
                     }
+                }
 
-                    std::lock_guard guard(mutex);
-
-                    if (auto iterator = pendingComponentMap.find(callId); iterator != pendingComponentMap.end())
-                    {
-                        iterator->second.set_value(component);
+                std::lock_guard guard(mutex);
 
-                        pendingComponentMap.erase(iterator);
-                    }
-                }
-                else if (rpcType == RpcType::RemoveComponentResponse)
+                if (auto iterator = pendingComponentMap.find(callId); iterator != pendingComponentMap.end())
                 {
-                    NetworkId objectId;
+                    iterator->second.set_value(component);
 
-                    std::string compTypeName;
-                    archive(objectId, compTypeName);
-
-                    if (auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId))
-                        optionalGameObject.value()->RemoveComponentDynamic(ComponentFactory::Create(compTypeName));
+                    pendingComponentMap.erase(iterator);
                 }
-            }
-        }
+            });
 
-        static RpcClient& GetInstance()
-        {
-            std::call_once(initializationFlag, [&]()
+            responseTable.Register<RpcType::RemoveComponentResponse>([](uint64_t, const NetworkId objectId, const std::string& compTypeName)
             {
-                instance = std::unique_ptr<RpcClient>(new RpcClient());
+                if (auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId))
+                    optionalGameObject.value()->RemoveComponentDynamic(ComponentFactory::Create(compTypeName));
             });
-            
-            return *instance;
-        }
 
-        static const std::string RpcChannelName;
+            responseTable.Register<RpcType::BlobResponse>([](uint64_t, const ContentHash hash, const bool found, const std::string& blob)
+            {
+                if (!found)
+                    ContentStore::GetInstance().Reject(hash);
+                else
+                    ContentStore::GetInstance().Store(hash, blob);
+            });
 
-    private:
+            responseTable.Register<RpcType::SubtreeHashesResponse>([this](uint64_t, const NetworkId parentId, const std::vector<HierarchyHash::Entry>& remoteList)
+            {
+                ReconcileChildren(parentId, remoteList);
+            });
 
-        RpcClient() = default;
+            ContentStore::GetInstance().SetFetcher([this](const ContentHash hash) { RequestBlob(hash); });
+        }
 
-        static std::string SerializePositionRotation(const Vector<float, 3>& position, const Vector<float, 3>& rotation)
+        void ReconcileChildren(const NetworkId parentId, const std::vector<HierarchyHash::Entry>& remoteList)
         {
-            std::ostringstream stream;
+            const auto& hierarchy = HierarchyHash::GetInstance();
 
-            cereal::BinaryOutputArchive archive(stream);
+            std::unordered_map<NetworkId, HierarchyHash::Entry> localMap;
 
-            archive(position, rotation);
+            for (auto& entry : hierarchy.GetChildren(parentId))
+                localMap.emplace(entry.id, std::move(entry));
 
-            return stream.str();
-        }
+            std::unordered_set<NetworkId> remoteSet;
+            std::vector<NetworkId> discardList;
 
-        static std::pair<Vector<float, 3>, Vector<float, 3>> DeserializePositionRotation(const std::string& payload)
-        {
-            std::istringstream stream(payload);
+            {
+                std::lock_guard guard(mutex);
 
-            cereal::BinaryInputArchive archive(stream);
+                --pendingSubtreeRequestCount;
 
-            Vector<float, 3> position = { 0, 0, 0 };
-            Vector<float, 3> rotation = { 0, 0, 0 };
+                for (const auto& [id, name, hash] : remoteList)
+                {
+                    remoteSet.insert(id);
 
-            archive(position, rotation);
+                    const auto iterator = localMap.find(id);
 
-            return {position,rotation};
+                    if (iterator == localMap.end() || iterator->second.name != name)
+                        requestBatch.Write<RpcType::RequestSubtreeSync>(0, id);
+                    else if (iterator->second.hash != hash)
+                    {
+                        requestBatch.Write<RpcType::RequestSubtreeHashes>(0, id);
+                        ++pendingSubtreeRequestCount;
+                    }
+                }
+            }
+
+            for (const auto& id : localMap | std::views::keys)
+            {
+                if (!remoteSet.contains(id))
+                    discardList.push_back(id);
+            }
+
+            for (const auto id : discardList)
+                DiscardSubtree(parentId, id);
         }
 
-        struct Request
+        static void DiscardSubtree(const NetworkId parentId, const NetworkId id)
         {
-            uint64_t callId;
-            RpcType type;
-            std::string name;
-            NetworkId parentId;
-            std::string payload;
-        };
+            auto& manager = GameObjectManager::GetInstance();
+
+            if (parentId != HierarchyHash::RootId && manager.Has(parentId) && manager.Has(id))
+                manager.Get(parentId).value()->RemoveChild(id);
+
+            auto subtree = HierarchyHash::GetInstance().GetSubtree(id);
+
+            for (const auto objectId : subtree | std::views::reverse)
+            {
+                if (manager.Has(objectId))
+                    manager.Unregister(objectId);
+            }
+        }
 
         uint64_t nextCallId{ 1 };
+        uint32_t pendingSubtreeRequestCount = 0;
 
         std::mutex mutex;
-        std::vector<Request> requestList;
+        RpcBatch requestBatch;
+        RpcDispatchTable<> responseTable;
         std::unordered_map<uint64_t, std::promise<std::shared_ptr<GameObject>>> pendingCreateMap;
         std::unordered_map<uint64_t, std::promise<std::shared_ptr<Component>>> pendingComponentMap;
 
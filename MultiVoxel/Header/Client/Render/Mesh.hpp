@@ -3,14 +3,18 @@
 #include <vector>
 #include <memory>
 #include <concepts>
+#include <optional>
+#include <unordered_map>
 #include <glad/glad.h>
 #include "Client/Render/Shader.hpp"
 #include "Client/Render/Vertex.hpp"
 #include "Independent/ECS/Component.hpp"
 #include "Independent/ECS/ComponentFactory.hpp"
 #include "Independent/Math/Camera.hpp"
+#include "Independent/Network/ContentStore.hpp"
 
 using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::Network;
 
 namespace MultiVoxel::Client::Render
 {
@@ -20,13 +24,9 @@ namespace MultiVoxel::Client::Render
         { a.GetLayout() } -> std::same_as<VertexBufferLayout>;
     };
 
-    template <VertexType T>
-    class Mesh final : public Component, public INetworkSerializable, public std::enable_shared_from_this<Mesh<T>>
+    struct MeshBuffers final
     {
-
-    public:
-
-        ~Mesh() override
+        ~MeshBuffers()
         {
             if (VAO)
                 glDeleteVertexArrays(1, &VAO);
@@ -38,6 +38,21 @@ namespace MultiVoxel::Client::Render
                 glDeleteBuffers(1, &EBO);
         }
 
+        GLuint VAO = 0, VBO = 0, EBO = 0;
+    };
+
+    template <VertexType T>
+    class Mesh final : public Component, public INetworkSerializable, public std::enable_shared_from_this<Mesh<T>>
+    {
+
+    public:
+
+        enum class Encoding : uint8_t
+        {
+            Inline = 0,
+            Reference = 1
+        };
+
         Mesh(const Mesh&) = delete;
         Mesh(Mesh&&) = delete;
         Mesh& operator=(const Mesh&) = delete;
@@ -45,6 +60,21 @@ namespace MultiVoxel::Client::Render
 
         void Generate()
         {
+            auto& bufferCache = GetBufferCache();
+
+            const ContentHash hash = GetContentHash();
+
+            if (const auto iterator = bufferCache.find(hash); iterator != bufferCache.end())
+            {
+                if ((buffers = iterator->second.lock()))
+                    return;
+            }
+
+            buffers = std::make_shared<MeshBuffers>();
+            bufferCache[hash] = buffers;
+
+            auto& [VAO, VBO, EBO] = *buffers;
+
             glGenVertexArrays(1, &VAO);
             glGenBuffers(1, &VBO);
             glGenBuffers(1, &EBO);
@@ -79,7 +109,10 @@ namespace MultiVoxel::Client::Render
             GetGameObject()->template GetComponent<Shader>().value()->SetUniform("viewUniform", camera->GetViewMatrix());
             GetGameObject()->template GetComponent<Shader>().value()->SetUniform("modelUniform", GetGameObject()->GetTransform()->GetModelMatrix());
 
-            glBindVertexArray(VAO);
+            if (!buffers)
+                return;
+
+            glBindVertexArray(buffers->VAO);
 
             glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
 
@@ -91,6 +124,8 @@ namespace MultiVoxel::Client::Render
             MarkDirty();
 
             this->vertices = vertices;
+            contentHash.reset();
+            contentBlob.reset();
         }
 
         void SetIndices(const std::vector<uint32_t>& indices)
@@ -98,19 +133,81 @@ namespace MultiVoxel::Client::Render
             MarkDirty();
 
             this->indices = indices;
+            contentHash.reset();
+            contentBlob.reset();
         }
 
-        void Serialize(cereal::BinaryOutputArchive& archive) const override
+        void Serialize(WireOutputArchive& archive) const override
         {
-            archive(vertices, indices);
+            if (!ContentStore::GetInstance().IsPublishing())
+            {
+                archive(Encoding::Inline, vertices, indices);
+                return;
+            }
+
+            if (!contentBlob)
+            {
+                ContentHash hash;
+
+                contentBlob = ContentStore::GetInstance().Publish(SerializeContent(), hash);
+                contentHash = hash;
+            }
+
+            if (!contentBlob)
+            {
+                archive(Encoding::Inline, vertices, indices);
+                return;
+            }
+
+            archive(Encoding::Reference, *contentHash);
         }
 
-        void Deserialize(cereal::BinaryInputArchive& archive) override
+        void Deserialize(WireInputArchive& archive) override
         {
-            archive(vertices, indices);
+            Encoding encoding;
 
-            if (!GetGameObject()->IsAuthoritative())
-                Generate();
+            archive(encoding);
+
+            if (encoding == Encoding::Inline)
+            {
+                archive(vertices, indices);
+
+                contentHash.reset();
+                contentBlob.reset();
+
+                if (!GetGameObject()->IsAuthoritative())
+                    Generate();
+
+                return;
+            }
+
+            ContentHash hash;
+
+            archive(hash);
+
+            if (contentHash == hash)
+                return;
+
+            ContentStore::GetInstance().Acquire(hash, [weak = this->weak_from_this(), hash](const std::string& blob)
+            {
+                if (const auto self = weak.lock())
+                    self->LoadContent(hash, blob);
+            });
+        }
+
+        [[nodiscard]]
+        ContentHash GetContentHash() const
+        {
+            if (!contentHash)
+                contentHash = ContentStore::Hash(SerializeContent());
+
+            return *contentHash;
+        }
+
+        [[nodiscard]]
+        float GetReplicationPriority() const override
+        {
+            return 0.25f;
         }
 
         void MarkDirty() override
@@ -151,12 +248,45 @@ namespace MultiVoxel::Client::Render
 
         friend class MultiVoxel::Independent::ECS::ComponentFactory;
 
+        std::string SerializeContent() const
+        {
+            std::string result;
+
+            WireOutputArchive archive(result);
+
+            archive(vertices, indices);
+
+            return result;
+        }
+
+        void LoadContent(const ContentHash hash, const std::string& blob)
+        {
+            WireInputArchive archive(blob);
+
+            archive(vertices, indices);
+
+            contentHash = hash;
+
+            if (const auto gameObject = GetGameObject(); gameObject && !gameObject->IsAuthoritative())
+                Generate();
+        }
+
+        static std::unordered_map<ContentHash, std::weak_ptr<MeshBuffers>>& GetBufferCache()
+        {
+            static std::unordered_map<ContentHash, std::weak_ptr<MeshBuffers>> cache;
+
+            return cache;
+        }
+
         bool dirty = true;
 
         std::vector<T> vertices;
         std::vector<uint32_t> indices;
 
-        GLuint VAO = 0, VBO = 0, EBO = 0;
+        mutable std::optional<ContentHash> contentHash;
+        mutable ContentStore::Blob contentBlob;
+
+        std::shared_ptr<MeshBuffers> buffers;
     };
 
     REGISTER_COMPONENT_TEMPLATED(Mesh);
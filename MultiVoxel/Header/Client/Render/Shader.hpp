@@ -68,12 +68,12 @@ namespace MultiVoxel::Client::Render
 			glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
 		}
 
-		void Serialize(cereal::BinaryOutputArchive& archive) const override
+		void Serialize(WireOutputArchive& archive) const override
 		{
 			archive(name, localPath, vertexPath, fragmentPath, id);
 		}
 
-		void Deserialize(cereal::BinaryInputArchive& archive) override
+		void Deserialize(WireInputArchive& archive) override
 		{
 			archive(name, localPath, vertexPath, fragmentPath, id);
 
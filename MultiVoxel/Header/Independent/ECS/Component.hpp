@@ -3,7 +3,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
-#include <cereal/cereal.hpp>
+#include "Independent/Network/WireArchive.hpp"
 
 namespace MultiVoxel::Independent::Math
 {
@@ -27,8 +27,8 @@ namespace MultiVoxel::Independent::ECS
 	{
 		virtual ~INetworkSerializable() = default;
 
-		virtual void Serialize(cereal::BinaryOutputArchive& ar) const = 0;
-		virtual void Deserialize(cereal::BinaryInputArchive& ar) = 0;
+		virtual void Serialize(Network::WireOutputArchive& ar) const = 0;
+		virtual void Deserialize(Network::WireInputArchive& ar) = 0;
 
 		virtual void MarkDirty() = 0;
 
@@ -37,6 +37,12 @@ namespace MultiVoxel::Independent::ECS
 
 		virtual void ClearDirty() = 0;
 
+		[[nodiscard]]
+		virtual float GetReplicationPriority() const
+		{
+			return 1.0f;
+		}
+
 		[[nodiscard]]
 		virtual std::string GetComponentTypeName() const = 0;
 	};
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <ranges>
 #include <string>
+#include <vector>
 #include <memory>
 #include <unordered_map>
 #include <functional>
@@ -62,6 +65,20 @@ namespace MultiVoxel::Independent::ECS
             return iterator->second();
         }
 
+        static std::vector<std::string> GetRegisteredTypeNames()
+        {
+            std::lock_guard guard(GetMutex());
+
+            std::vector<std::string> result;
+
+            for (const auto& key : GetRegistry() | std::views::keys)
+                result.push_back(key);
+
+            std::ranges::sort(result);
+
+            return result;
+        }
+
     private:
 
         static std::unordered_map<std::string, Creator>& GetRegistry()
@@ -9,6 +9,7 @@
 #include "Independent/Math/Transform.hpp"
 #include "Independent/Utility/IndexedString.hpp"
 #include "Independent/ECS/Component.hpp"
+#include "Independent/ECS/HierarchyHash.hpp"
 
 using namespace MultiVoxel::Independent::Math;
 using namespace MultiVoxel::Independent::Utility;
@@ -76,6 +77,8 @@ namespace MultiVoxel::Independent::ECS
                                 return;
                         }
 
+                        childMap[name]->SetParent(nullptr);
+
                         childMapByNetworkId.erase(childMap[name]->GetNetworkId());
                         childMap.erase(name);
                 }
@@ -88,7 +91,11 @@ namespace MultiVoxel::Independent::ECS
                                 return;
                         }
 
-                        childMap.erase(childMapByNetworkId[id].lock()->GetName());
+                        const auto child = childMapByNetworkId[id].lock();
+
+                        child->SetParent(nullptr);
+
+                        childMap.erase(child->GetName());
                         childMapByNetworkId.erase(id);
                 }
 
@@ -177,17 +184,21 @@ namespace MultiVoxel::Independent::ECS
 
 		void SetParent(std::shared_ptr<GameObject> parent)
 		{
+			HierarchyHash::GetInstance().SetParent(networkId, parent ? parent->GetNetworkId() : HierarchyHash::RootId);
+
 			if (parent)
 			{
 				this->parent = std::make_optional<std::shared_ptr<GameObject>>(parent);
 
-				GetTransform()->SetParent(parent->GetTransform());
+				if (HasComponent<Transform>() && parent->HasComponent<Transform>())
+					GetTransform()->SetParent(parent->GetTransform());
 			}
 			else
 			{
 				this->parent = std::nullopt;
 
-				GetTransform()->SetParent(nullptr);
+				if (HasComponent<Transform>())
+					GetTransform()->SetParent(nullptr);
 			}
 		}
 
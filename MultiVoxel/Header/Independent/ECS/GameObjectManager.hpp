@@ -2,6 +2,7 @@
 
 #include "Independent/Utility/SingletonManager.hpp"
 #include "Independent/ECS/GameObject.hpp"
+#include "Independent/ECS/HierarchyHash.hpp"
 
 namespace MultiVoxel::Independent::ECS
 {
@@ -28,6 +29,10 @@ namespace MultiVoxel::Independent::ECS
 			gameObjectMap.insert({ name, std::move(object) });
 			networkMap.insert({ gameObjectMap[name]->GetNetworkId(), gameObjectMap[name] });
 
+			const auto parent = gameObjectMap[name]->GetParent();
+
+			HierarchyHash::GetInstance().AddNode(gameObjectMap[name]->GetNetworkId(), name, parent.has_value() && parent.value() ? parent.value()->GetNetworkId() : HierarchyHash::RootId);
+
 			return gameObjectMap[name];
 		}
 
@@ -39,6 +44,8 @@ namespace MultiVoxel::Independent::ECS
 				return;
 			}
 
+			HierarchyHash::GetInstance().RemoveNode(gameObjectMap[name]->GetNetworkId());
+
 			networkMap.erase(gameObjectMap[name]->GetNetworkId());
 
 			gameObjectMap.erase(name);
@@ -52,6 +59,8 @@ namespace MultiVoxel::Independent::ECS
 				return;
 			}
 
+			HierarchyHash::GetInstance().RemoveNode(id);
+
 			gameObjectMap.erase(networkMap[id].lock()->GetName());
 			
 			networkMap.erase(id);
@@ -98,6 +107,13 @@ namespace MultiVoxel::Independent::ECS
 			return result;
 		}
 
+		template <typename Function>
+		void ForEach(Function&& function) const
+		{
+			for (const auto& gameObject: gameObjectMap | std::views::values)
+				function(gameObject);
+		}
+
 		void Update()
 		{
 			for (const auto& gameObject: gameObjectMap | std::views::values)
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Independent/ECS/Component.hpp"
+#include "Independent/Network/ContentStore.hpp"
+
+using namespace MultiVoxel::Independent::Network;
+
+namespace MultiVoxel::Independent::ECS
+{
+	class HierarchyHash final
+	{
+
+	public:
+
+		struct Entry
+		{
+			NetworkId id = 0;
+			std::string name;
+			uint64_t hash = 0;
+
+			template <typename Archive>
+			void serialize(Archive& archive)
+			{
+				archive(id, name, hash);
+			}
+		};
+
+		HierarchyHash(const HierarchyHash&) = delete;
+		HierarchyHash(HierarchyHash&&) = delete;
+		HierarchyHash& operator=(const HierarchyHash&) = delete;
+		HierarchyHash& operator=(HierarchyHash&&) = delete;
+
+		void AddNode(const NetworkId id, const std::string& name, const NetworkId parentId)
+		{
+			if (id == RootId)
+				return;
+
+			auto& node = Ensure(id);
+
+			node.registered = true;
+			node.name = name;
+			node.nameHash = ContentStore::Hash(name);
+
+			Refresh(id);
+			Attach(id, parentId);
+		}
+
+		void RemoveNode(const NetworkId id)
+		{
+			const auto iterator = nodeMap.find(id);
+
+			if (id == RootId || iterator == nodeMap.end())
+				return;
+
+			iterator->second.registered = false;
+			iterator->second.name.clear();
+			iterator->second.nameHash = 0;
+
+			Refresh(id);
+			Prune(id);
+		}
+
+		void SetParent(const NetworkId id, const NetworkId parentId)
+		{
+			const auto iterator = nodeMap.find(id);
+
+			if (iterator == nodeMap.end() || !iterator->second.registered)
+				return;
+
+			Attach(id, parentId);
+		}
+
+		[[nodiscard]]
+		uint64_t GetRootHash() const
+		{
+			const auto iterator = nodeMap.find(RootId);
+
+			return iterator != nodeMap.end() ? iterator->second.childSum : 0;
+		}
+
+		[[nodiscard]]
+		uint64_t GetSubtreeHash(const NetworkId id) const
+		{
+			if (id == RootId)
+				return GetRootHash();
+
+			const auto iterator = nodeMap.find(id);
+
+			return iterator != nodeMap.end() ? iterator->second.hash : 0;
+		}
+
+		[[nodiscard]]
+		bool Has(const NetworkId id) const
+		{
+			const auto iterator = nodeMap.find(id);
+
+			return iterator != nodeMap.end() && iterator->second.registered;
+		}
+
+		[[nodiscard]]
+		NetworkId GetParent(const NetworkId id) const
+		{
+			const auto iterator = nodeMap.find(id);
+
+			return iterator != nodeMap.end() ? iterator->second.parent : RootId;
+		}
+
+		[[nodiscard]]
+		std::vector<Entry> GetChildren(const NetworkId id) const
+		{
+			std::vector<Entry> result;
+
+			const auto iterator = nodeMap.find(id);
+
+			if (iterator == nodeMap.end())
+				return result;
+
+			result.reserve(iterator->second.children.size());
+
+			for (const auto childId : iterator->second.children)
+			{
+				const auto& child = nodeMap.at(childId);
+
+				result.push_back({ childId, child.name, child.hash });
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		std::vector<NetworkId> GetSubtree(const NetworkId id) const
+		{
+			std::vector<NetworkId> result;
+
+			if (!nodeMap.contains(id))
+				return result;
+
+			std::vector<NetworkId> stack{ id };
+
+			while (!stack.empty())
+			{
+				const NetworkId current = stack.back();
+				stack.pop_back();
+
+				const auto& node = nodeMap.at(current);
+
+				if (node.registered)
+					result.push_back(current);
+
+				stack.insert(stack.end(), node.children.begin(), node.children.end());
+			}
+
+			return result;
+		}
+
+		static HierarchyHash& GetInstance()
+		{
+			std::call_once(initializationFlag, [&]()
+			{
+				instance = std::unique_ptr<HierarchyHash>(new HierarchyHash());
+			});
+
+			return *instance;
+		}
+
+		static constexpr NetworkId RootId = 0;
+
+	private:
+
+		HierarchyHash() = default;
+
+		static constexpr size_t MaximumDepth = 4096;
+
+		struct Node
+		{
+			bool registered = false;
+
+			std::string name;
+			ContentHash nameHash = 0;
+
+			NetworkId parent = RootId;
+
+			uint64_t childSum = 0;
+			uint64_t hash = 0;
+
+			std::unordered_set<NetworkId> children;
+		};
+
+		static uint64_t Mix(uint64_t value)
+		{
+			value ^= value >> 30;
+			value *= 0xbf58476d1ce4e5b9ULL;
+			value ^= value >> 27;
+			value *= 0x94d049bb133111ebULL;
+			value ^= value >> 31;
+
+			return value;
+		}
+
+		static uint64_t Compute(const NetworkId id, const Node& node)
+		{
+			if (!node.registered)
+				return node.childSum;
+
+			return Mix(Mix(static_cast<uint64_t>(id) ^ node.nameHash) + node.childSum);
+		}
+
+		Node& Ensure(const NetworkId id)
+		{
+			auto [iterator, inserted] = nodeMap.try_emplace(id);
+
+			if (inserted && id != RootId)
+				nodeMap[RootId].children.insert(id);
+
+			return iterator->second;
+		}
+
+		void Refresh(const NetworkId id)
+		{
+			auto& node = nodeMap.at(id);
+
+			const uint64_t previous = node.hash;
+
+			node.hash = Compute(id, node);
+
+			if (node.hash != previous)
+				Propagate(node.parent, previous, node.hash);
+		}
+
+		void Propagate(NetworkId id, uint64_t removed, uint64_t added)
+		{
+			for (size_t depth = 0; depth < MaximumDepth; ++depth)
+			{
+				auto& node = nodeMap[id];
+
+				node.childSum += added - removed;
+
+				if (id == RootId)
+					return;
+
+				removed = node.hash;
+				added = node.hash = Compute(id, node);
+
+				id = node.parent;
+			}
+
+			std::cerr << "Hierarchy is deeper than " << MaximumDepth << " levels, stopped propagating its hash.\n";
+		}
+
+		void Attach(const NetworkId id, const NetworkId parentId)
+		{
+			auto& node = nodeMap.at(id);
+
+			if (node.parent == parentId || parentId == id)
+				return;
+
+			for (NetworkId ancestor = parentId; ancestor != RootId; )
+			{
+				const auto iterator = nodeMap.find(ancestor);
+
+				if (iterator == nodeMap.end())
+					break;
+
+				if (ancestor == id)
+				{
+					std::cerr << "Refusing to parent game object '" << id << "' under its own descendant '" << parentId << "'.\n";
+					return;
+				}
+
+				ancestor = iterator->second.parent;
+			}
+
+			const NetworkId previousParent = node.parent;
+
+			nodeMap.at(previousParent).children.erase(id);
+			Propagate(previousParent, node.hash, 0);
+
+			Ensure(parentId).children.insert(id);
+			node.parent = parentId;
+			Propagate(parentId, 0, node.hash);
+
+			Prune(previousParent);
+		}
+
+		void Prune(const NetworkId id)
+		{
+			const auto iterator = nodeMap.find(id);
+
+			if (id == RootId || iterator == nodeMap.end() || iterator->second.registered || !iterator->second.children.empty())
+				return;
+
+			const NetworkId parentId = iterator->second.parent;
+
+			nodeMap.at(parentId).children.erase(id);
+			nodeMap.erase(iterator);
+
+			Prune(parentId);
+		}
+
+		std::unordered_map<NetworkId, Node> nodeMap{ { RootId, Node{ } } };
+
+		static std::once_flag initializationFlag;
+		static std::unique_ptr<HierarchyHash> instance;
+
+	};
+
+	std::once_flag HierarchyHash::initializationFlag;
+	std::unique_ptr<HierarchyHash> HierarchyHash::instance;
+}
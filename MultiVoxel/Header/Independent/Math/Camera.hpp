@@ -28,12 +28,12 @@ namespace MultiVoxel::Independent::Math
             return Matrix<float, 4, 4>::LookAt(GetGameObject()->GetTransform()->GetWorldPosition(), GetGameObject()->GetTransform()->GetWorldPosition() + GetGameObject()->GetTransform()->GetForward(), { 0.0f, 1.0f, 0.0f });
         }
 
-        void Serialize(cereal::BinaryOutputArchive& archive) const override
+        void Serialize(WireOutputArchive& archive) const override
         {
             archive(fieldOfView, nearPlane, farPlane);
         }
 
-        void Deserialize(cereal::BinaryInputArchive& archive) override
+        void Deserialize(WireInputArchive& archive) override
         {
             archive(fieldOfView, nearPlane, farPlane);
 
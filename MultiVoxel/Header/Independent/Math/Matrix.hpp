@@ -441,10 +441,10 @@ inline void HashCombine(std::size_t& seed, std::size_t value) noexcept
 
 namespace std
 {
-	template <Arithmetic T, size_t R, size_t C>
-	struct hash<Matrix<T, R, C>>
+	template <MultiVoxel::Independent::Math::Arithmetic T, size_t R, size_t C>
+	struct hash<MultiVoxel::Independent::Math::Matrix<T, R, C>>
 	{
-		std::size_t operator()(const Matrix<T, R, C>& m) const noexcept
+		std::size_t operator()(const MultiVoxel::Independent::Math::Matrix<T, R, C>& m) const noexcept
 		{
 			std::size_t result = 0;
 
@@ -461,10 +461,10 @@ namespace std
 		}
 	};
 
-	template <Arithmetic T, size_t R, size_t C>
-	struct formatter<Matrix<T, R, C>> : std::formatter<std::string>
+	template <MultiVoxel::Independent::Math::Arithmetic T, size_t R, size_t C>
+	struct formatter<MultiVoxel::Independent::Math::Matrix<T, R, C>> : std::formatter<std::string>
 	{
-		auto format(const Matrix<T, R, C>& mat, std::format_context& ctx)
+		auto format(const MultiVoxel::Independent::Math::Matrix<T, R, C>& mat, std::format_context& ctx)
 		{
 			std::ostringstream oss;
 
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include "Independent/Math/NoiseKernels.hpp"
+#include "Independent/Math/Random.hpp"
+#include "Independent/Math/Simd.hpp"
+
+namespace MultiVoxel::Independent::Math
+{
+	enum class NoiseType : uint8_t
+	{
+		Perlin,
+		Simplex
+	};
+
+	class Noise final
+	{
+
+	public:
+
+		explicit Noise(const uint64_t seed) : simdLevel(DetectSimdLevel())
+		{
+			std::array<int32_t, 256> table;
+
+			std::iota(table.begin(), table.end(), 0);
+
+			Random random(seed);
+
+			for (uint32_t index = 255; index > 0; --index)
+				std::swap(table[index], table[random.NextBelow(index + 1)]);
+
+			for (size_t index = 0; index < permutation.size(); ++index)
+				permutation[index] = table[index & 255];
+		}
+
+		[[nodiscard]]
+		float Perlin(const float x, const float y) const
+		{
+			const float floorX = std::floor(x);
+			const float floorY = std::floor(y);
+
+			const int32_t cellX = static_cast<int32_t>(floorX) & 255;
+			const int32_t cellY = static_cast<int32_t>(floorY) & 255;
+
+			const float localX = x - floorX;
+			const float localY = y - floorY;
+
+			const float u = Fade(localX);
+			const float v = Fade(localY);
+
+			const int32_t a = permutation[cellX] + cellY;
+			const int32_t b = permutation[cellX + 1] + cellY;
+
+			return Lerp(Lerp(Gradient(permutation[a], localX, localY), Gradient(permutation[b], localX - 1.0f, localY), u), Lerp(Gradient(permutation[a + 1], localX, localY - 1.0f), Gradient(permutation[b + 1], localX - 1.0f, localY - 1.0f), u), v);
+		}
+
+		[[nodiscard]]
+		float Perlin(const float x, const float y, const float z) const
+		{
+			const float floorX = std::floor(x);
+			const float floorY = std::floor(y);
+			const float floorZ = std::floor(z);
+
+			const int32_t cellX = static_cast<int32_t>(floorX) & 255;
+			const int32_t cellY = static_cast<int32_t>(floorY) & 255;
+			const int32_t cellZ = static_cast<int32_t>(floorZ) & 255;
+
+			const float localX = x - floorX;
+			const float localY = y - floorY;
+			const float localZ = z - floorZ;
+
+			const float u = Fade(localX);
+			const float v = Fade(localY);
+			const float w = Fade(localZ);
+
+			const int32_t a = permutation[cellX] + cellY;
+			const int32_t aa = permutation[a] + cellZ;
+			const int32_t ab = permutation[a + 1] + cellZ;
+			const int32_t b = permutation[cellX + 1] + cellY;
+			const int32_t ba = permutation[b] + cellZ;
+			const int32_t bb = permutation[b + 1] + cellZ;
+
+			const float x0 = Lerp(Gradient(permutation[aa], localX, localY, localZ), Gradient(permutation[ba], localX - 1.0f, localY, localZ), u);
+			const float x1 = Lerp(Gradient(permutation[ab], localX, localY - 1.0f, localZ), Gradient(permutation[bb], localX - 1.0f, localY - 1.0f, localZ), u);
+			const float x2 = Lerp(Gradient(permutation[aa + 1], localX, localY, localZ - 1.0f), Gradient(permutation[ba + 1], localX - 1.0f, localY, localZ - 1.0f), u);
+			const float x3 = Lerp(Gradient(permutation[ab + 1], localX, localY - 1.0f, localZ - 1.0f), Gradient(permutation[bb + 1], localX - 1.0f, localY - 1.0f, localZ - 1.0f), u);
+
+			return Lerp(Lerp(x0, x1, v), Lerp(x2, x3, v), w);
+		}
+
+		[[nodiscard]]
+		float Simplex(const float x, const float y) const
+		{
+			using namespace NoiseKernels;
+
+			const float skew = (x + y) * Simplex2Skew;
+			const float cellX = std::floor(x + skew);
+			const float cellY = std::floor(y + skew);
+			const float unskew = (cellX + cellY) * Simplex2Unskew;
+
+			const float x0 = x - (cellX - unskew);
+			const float y0 = y - (cellY - unskew);
+
+			const int32_t i1 = x0 > y0 ? 1 : 0;
+			const int32_t j1 = 1 - i1;
+
+			const float x1 = x0 - static_cast<float>(i1) + Simplex2Unskew;
+			const float y1 = y0 - static_cast<float>(j1) + Simplex2Unskew;
+			const float x2 = x0 - 1.0f + Simplex2UnskewDouble;
+			const float y2 = y0 - 1.0f + Simplex2UnskewDouble;
+
+			const int32_t i = static_cast<int32_t>(cellX) & 255;
+			const int32_t j = static_cast<int32_t>(cellY) & 255;
+
+			const float n0 = Corner(permutation[i + permutation[j]], x0, y0);
+			const float n1 = Corner(permutation[i + i1 + permutation[j + j1]], x1, y1);
+			const float n2 = Corner(permutation[i + 1 + permutation[j + 1]], x2, y2);
+
+			return Simplex2Scale * (n0 + n1 + n2);
+		}
+
+		[[nodiscard]]
+		float Simplex(const float x, const float y, const float z) const
+		{
+			using namespace NoiseKernels;
+
+			const float skew = (x + y + z) * Simplex3Skew;
+			const float cellX = std::floor(x + skew);
+			const float cellY = std::floor(y + skew);
+			const float cellZ = std::floor(z + skew);
+			const float unskew = (cellX + cellY + cellZ) * Simplex3Unskew;
+
+			const float x0 = x - (cellX - unskew);
+			const float y0 = y - (cellY - unskew);
+			const float z0 = z - (cellZ - unskew);
+
+			const bool xy = x0 >= y0;
+			const bool xz = x0 >= z0;
+			const bool yz = y0 >= z0;
+
+			const int32_t i1 = xy && xz;
+			const int32_t j1 = !xy && yz;
+			const int32_t k1 = !xz && !yz;
+			const int32_t i2 = xy || xz;
+			const int32_t j2 = !xy || yz;
+			const int32_t k2 = !(xz && yz);
+
+			const float x1 = x0 - static_cast<float>(i1) + Simplex3Unskew;
+			const float y1 = y0 - static_cast<float>(j1) + Simplex3Unskew;
+			const float z1 = z0 - static_cast<float>(k1) + Simplex3Unskew;
+			const float x2 = x0 - static_cast<float>(i2) + Simplex3UnskewDouble;
+			const float y2 = y0 - static_cast<float>(j2) + Simplex3UnskewDouble;
+			const float z2 = z0 - static_cast<float>(k2) + Simplex3UnskewDouble;
+			const float x3 = x0 - 1.0f + Simplex3UnskewTriple;
+			const float y3 = y0 - 1.0f + Simplex3UnskewTriple;
+			const float z3 = z0 - 1.0f + Simplex3UnskewTriple;
+
+			const int32_t i = static_cast<int32_t>(cellX) & 255;
+			const int32_t j = static_cast<int32_t>(cellY) & 255;
+			const int32_t k = static_cast<int32_t>(cellZ) & 255;
+
+			const float n0 = Corner(permutation[i + permutation[j + permutation[k]]], x0, y0, z0);
+			const float n1 = Corner(permutation[i + i1 + permutation[j + j1 + permutation[k + k1]]], x1, y1, z1);
+			const float n2 = Corner(permutation[i + i2 + permutation[j + j2 + permutation[k + k2]]], x2, y2, z2);
+			const float n3 = Corner(permutation[i + 1 + permutation[j + 1 + permutation[k + 1]]], x3, y3, z3);
+
+			return Simplex3Scale * (n0 + n1 + n2 + n3);
+		}
+
+		[[nodiscard]]
+		float Sample(const NoiseType type, const float x, const float y) const
+		{
+			return type == NoiseType::Simplex ? Simplex(x, y) : Perlin(x, y);
+		}
+
+		[[nodiscard]]
+		float Sample(const NoiseType type, const float x, const float y, const float z) const
+		{
+			return type == NoiseType::Simplex ? Simplex(x, y, z) : Perlin(x, y, z);
+		}
+
+		[[nodiscard]]
+		float Fractal(const NoiseType type, float x, float y, const int32_t octaveCount, const float lacunarity = 2.0f, const float gain = 0.5f) const
+		{
+			float result = 0.0f;
+			float amplitude = 1.0f;
+
+			for (int32_t octave = 0; octave < octaveCount; ++octave)
+			{
+				result += Sample(type, x, y) * amplitude;
+
+				x *= lacunarity;
+				y *= lacunarity;
+				amplitude *= gain;
+			}
+
+			return result;
+		}
+
+		[[nodiscard]]
+		float Fractal(const NoiseType type, float x, float y, float z, const int32_t octaveCount, const float lacunarity = 2.0f, const float gain = 0.5f) const
+		{
+			float result = 0.0f;
+			float amplitude = 1.0f;
+
+			for (int32_t octave = 0; octave < octaveCount; ++octave)
+			{
+				result += Sample(type, x, y, z) * amplitude;
+
+				x *= lacunarity;
+				y *= lacunarity;
+				z *= lacunarity;
+				amplitude *= gain;
+			}
+
+			return result;
+		}
+
+		void Perlin(const float* x, const float* y, float* out, const size_t count) const
+		{
+			size_t index = 0;
+
+#ifdef MULTIVOXEL_SIMD_X86
+			if (simdLevel == SimdLevel::Avx2)
+				index = NoiseKernels::Avx2::Perlin(permutation.data(), x, y, out, count);
+			else if (simdLevel == SimdLevel::Sse41)
+				index = NoiseKernels::Sse41::Perlin(permutation.data(), x, y, out, count);
+#endif
+			for (; index < count; ++index)
+				out[index] = Perlin(x[index], y[index]);
+		}
+
+		void Perlin(const float* x, const float* y, const float* z, float* out, const size_t count) const
+		{
+			size_t index = 0;
+
+#ifdef MULTIVOXEL_SIMD_X86
+			if (simdLevel == SimdLevel::Avx2)
+				index = NoiseKernels::Avx2::Perlin(permutation.data(), x, y, z, out, count);
+			else if (simdLevel == SimdLevel::Sse41)
+				index = NoiseKernels::Sse41::Perlin(permutation.data(), x, y, z, out, count);
+#endif
+			for (; index < count; ++index)
+				out[index] = Perlin(x[index], y[index], z[index]);
+		}
+
+		void Simplex(const float* x, const float* y, float* out, const size_t count) const
+		{
+			size_t index = 0;
+
+#ifdef MULTIVOXEL_SIMD_X86
+			if (simdLevel == SimdLevel::Avx2)
+				index = NoiseKernels::Avx2::Simplex(permutation.data(), x, y, out, count);
+			else if (simdLevel == SimdLevel::Sse41)
+				index = NoiseKernels::Sse41::Simplex(permutation.data(), x, y, out, count);
+#endif
+			for (; index < count; ++index)
+				out[index] = Simplex(x[index], y[index]);
+		}
+
+		void Simplex(const float* x, const float* y, const float* z, float* out, const size_t count) const
+		{
+			size_t index = 0;
+
+#ifdef MULTIVOXEL_SIMD_X86
+			if (simdLevel == SimdLevel::Avx2)
+				index = NoiseKernels::Avx2::Simplex(permutation.data(), x, y, z, out, count);
+			else if (simdLevel == SimdLevel::Sse41)
+				index = NoiseKernels::Sse41::Simplex(permutation.data(), x, y, z, out, count);
+#endif
+			for (; index < count; ++index)
+				out[index] = Simplex(x[index], y[index], z[index]);
+		}
+
+		void Sample(const NoiseType type, const float* x, const float* y, float* out, const size_t count) const
+		{
+			if (type == NoiseType::Simplex)
+				Simplex(x, y, out, count);
+			else
+				Perlin(x, y, out, count);
+		}
+
+		void Sample(const NoiseType type, const float* x, const float* y, const float* z, float* out, const size_t count) const
+		{
+			if (type == NoiseType::Simplex)
+				Simplex(x, y, z, out, count);
+			else
+				Perlin(x, y, z, out, count);
+		}
+
+		void Fractal(const NoiseType type, const float* x, const float* y, float* out, const size_t count, const int32_t octaveCount, const float lacunarity = 2.0f, const float gain = 0.5f) const
+		{
+			std::array<float, FractalBlockSize> scaledX;
+			std::array<float, FractalBlockSize> scaledY;
+			std::array<float, FractalBlockSize> sample;
+
+			for (size_t begin = 0; begin < count; begin += FractalBlockSize)
+			{
+				const size_t size = std::min(FractalBlockSize, count - begin);
+
+				std::copy_n(x + begin, size, scaledX.begin());
+				std::copy_n(y + begin, size, scaledY.begin());
+				std::fill_n(out + begin, size, 0.0f);
+
+				float amplitude = 1.0f;
+
+				for (int32_t octave = 0; octave < octaveCount; ++octave)
+				{
+					Sample(type, scaledX.data(), scaledY.data(), sample.data(), size);
+
+					for (size_t index = 0; index < size; ++index)
+					{
+						out[begin + index] += sample[index] * amplitude;
+
+						scaledX[index] *= lacunarity;
+						scaledY[index] *= lacunarity;
+					}
+
+					amplitude *= gain;
+				}
+			}
+		}
+
+		void Fractal(const NoiseType type, const float* x, const float* y, const float* z, float* out, const size_t count, const int32_t octaveCount, const float lacunarity = 2.0f, const float gain = 0.5f) const
+		{
+			std::array<float, FractalBlockSize> scaledX;
+			std::array<float, FractalBlockSize> scaledY;
+			std::array<float, FractalBlockSize> scaledZ;
+			std::array<float, FractalBlockSize> sample;
+
+			for (size_t begin = 0; begin < count; begin += FractalBlockSize)
+			{
+				const size_t size = std::min(FractalBlockSize, count - begin);
+
+				std::copy_n(x + begin, size, scaledX.begin());
+				std::copy_n(y + begin, size, scaledY.begin());
+				std::copy_n(z + begin, size, scaledZ.begin());
+				std::fill_n(out + begin, size, 0.0f);
+
+				float amplitude = 1.0f;
+
+				for (int32_t octave = 0; octave < octaveCount; ++octave)
+				{
+					Sample(type, scaledX.data(), scaledY.data(), scaledZ.data(), sample.data(), size);
+
+					for (size_t index = 0; index < size; ++index)
+					{
+						out[begin + index] += sample[index] * amplitude;
+
+						scaledX[index] *= lacunarity;
+						scaledY[index] *= lacunarity;
+						scaledZ[index] *= lacunarity;
+					}
+
+					amplitude *= gain;
+				}
+			}
+		}
+
+		void SetSimdLevel(const SimdLevel level)
+		{
+			simdLevel = std::min(level, DetectSimdLevel());
+		}
+
+		[[nodiscard]]
+		SimdLevel GetSimdLevel() const
+		{
+			return simdLevel;
+		}
+
+	private:
+
+		static constexpr size_t FractalBlockSize = 256;
+
+		[[nodiscard]]
+		static float Fade(const float t)
+		{
+			return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+		}
+
+		[[nodiscard]]
+		static float Lerp(const float a, const float b, const float t)
+		{
+			return a + t * (b - a);
+		}
+
+		[[nodiscard]]
+		static float Gradient(const int32_t hash, const float x, const float y)
+		{
+			const float u = hash & 4 ? y : x;
+			const float v = hash & 4 ? x : y;
+
+			return (hash & 1 ? -u : u) + (hash & 2 ? -v : v) * 0.5f;
+		}
+
+		[[nodiscard]]
+		static float Gradient(const int32_t hash, const float x, const float y, const float z)
+		{
+			const int32_t h = hash & 15;
+
+			const float u = h < 8 ? x : y;
+			const float v = h < 4 ? y : h == 12 || h == 14 ? x : z;
+
+			return (h & 1 ? -u : u) + (h & 2 ? -v : v);
+		}
+
+		[[nodiscard]]
+		static float Corner(const int32_t hash, const float x, const float y)
+		{
+			const float t = NoiseKernels::Simplex2Radius - x * x - y * y;
+
+			if (t < 0.0f)
+				return 0.0f;
+
+			const float t2 = t * t;
+
+			return t2 * t2 * Gradient(hash, x, y);
+		}
+
+		[[nodiscard]]
+		static float Corner(const int32_t hash, const float x, const float y, const float z)
+		{
+			const float t = NoiseKernels::Simplex3Radius - x * x - y * y - z * z;
+
+			if (t < 0.0f)
+				return 0.0f;
+
+			const float t2 = t * t;
+
+			return t2 * t2 * Gradient(hash, x, y, z);
+		}
+
+		std::array<int32_t, 512> permutation = { };
+
+		SimdLevel simdLevel;
+
+	};
+}
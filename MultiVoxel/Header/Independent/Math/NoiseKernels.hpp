@@ -0,0 +1,573 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Independent/Math/Simd.hpp"
+
+namespace MultiVoxel::Independent::Math::NoiseKernels
+{
+	inline constexpr float Simplex2Skew = 0.36602540378f;
+	inline constexpr float Simplex2Unskew = 0.21132486540f;
+	inline constexpr float Simplex2UnskewDouble = Simplex2Unskew * 2.0f;
+	inline constexpr float Simplex2Radius = 0.5f;
+	inline constexpr float Simplex2Scale = 70.0f;
+
+	inline constexpr float Simplex3Skew = 1.0f / 3.0f;
+	inline constexpr float Simplex3Unskew = 1.0f / 6.0f;
+	inline constexpr float Simplex3UnskewDouble = Simplex3Unskew * 2.0f;
+	inline constexpr float Simplex3UnskewTriple = Simplex3Unskew * 3.0f;
+	inline constexpr float Simplex3Radius = 0.6f;
+	inline constexpr float Simplex3Scale = 32.0f;
+
+#ifdef MULTIVOXEL_SIMD_X86
+	namespace Sse41
+	{
+		inline constexpr size_t Width = 4;
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128i Gather(const int32_t* table, const __m128i index)
+		{
+			alignas(16) int32_t lane[Width];
+
+			_mm_store_si128(reinterpret_cast<__m128i*>(lane), index);
+
+			return _mm_setr_epi32(table[lane[0]], table[lane[1]], table[lane[2]], table[lane[3]]);
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Fade(const __m128 t)
+		{
+			const __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+
+			return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Lerp(const __m128 a, const __m128 b, const __m128 t)
+		{
+			return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 FlipSign(const __m128 value, const __m128i hash, const int32_t bit, const int32_t shift)
+		{
+			return _mm_xor_ps(value, _mm_castsi128_ps(_mm_sll_epi32(_mm_and_si128(hash, _mm_set1_epi32(bit)), _mm_cvtsi32_si128(shift))));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Gradient(const __m128i hash, const __m128 x, const __m128 y)
+		{
+			const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(hash, _mm_set1_epi32(4)), _mm_set1_epi32(4)));
+
+			const __m128 u = _mm_blendv_ps(x, y, swap);
+			const __m128 v = _mm_blendv_ps(y, x, swap);
+
+			return _mm_add_ps(FlipSign(u, hash, 1, 31), _mm_mul_ps(FlipSign(v, hash, 2, 30), _mm_set1_ps(0.5f)));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Gradient(const __m128i hash, const __m128 x, const __m128 y, const __m128 z)
+		{
+			const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+
+			const __m128 lowerThanEight = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(8), h));
+			const __m128 lowerThanFour = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(4), h));
+			const __m128 twelveOrFourteen = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+
+			const __m128 u = _mm_blendv_ps(y, x, lowerThanEight);
+			const __m128 v = _mm_blendv_ps(_mm_blendv_ps(z, x, twelveOrFourteen), y, lowerThanFour);
+
+			return _mm_add_ps(FlipSign(u, h, 1, 31), FlipSign(v, h, 2, 30));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Corner(const __m128i hash, const __m128 x, const __m128 y)
+		{
+			const __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(Simplex2Radius), _mm_mul_ps(x, x)), _mm_mul_ps(y, y));
+			const __m128 t2 = _mm_mul_ps(t, t);
+
+			return _mm_and_ps(_mm_mul_ps(_mm_mul_ps(t2, t2), Gradient(hash, x, y)), _mm_cmpge_ps(t, _mm_setzero_ps()));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline __m128 Corner(const __m128i hash, const __m128 x, const __m128 y, const __m128 z)
+		{
+			const __m128 t = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(Simplex3Radius), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			const __m128 t2 = _mm_mul_ps(t, t);
+
+			return _mm_and_ps(_mm_mul_ps(_mm_mul_ps(t2, t2), Gradient(hash, x, y, z)), _mm_cmpge_ps(t, _mm_setzero_ps()));
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline size_t Perlin(const int32_t* permutation, const float* x, const float* y, float* out, const size_t count)
+		{
+			const __m128i mask = _mm_set1_epi32(255);
+			const __m128i oneInteger = _mm_set1_epi32(1);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m128 sampleX = _mm_loadu_ps(x + index);
+				const __m128 sampleY = _mm_loadu_ps(y + index);
+
+				const __m128 floorX = _mm_floor_ps(sampleX);
+				const __m128 floorY = _mm_floor_ps(sampleY);
+
+				const __m128i cellX = _mm_and_si128(_mm_cvttps_epi32(floorX), mask);
+				const __m128i cellY = _mm_and_si128(_mm_cvttps_epi32(floorY), mask);
+
+				const __m128 localX = _mm_sub_ps(sampleX, floorX);
+				const __m128 localY = _mm_sub_ps(sampleY, floorY);
+				const __m128 localX1 = _mm_sub_ps(localX, one);
+				const __m128 localY1 = _mm_sub_ps(localY, one);
+
+				const __m128 u = Fade(localX);
+				const __m128 v = Fade(localY);
+
+				const __m128i a = _mm_add_epi32(Gather(permutation, cellX), cellY);
+				const __m128i b = _mm_add_epi32(Gather(permutation, _mm_add_epi32(cellX, oneInteger)), cellY);
+
+				const __m128 x0 = Lerp(Gradient(Gather(permutation, a), localX, localY), Gradient(Gather(permutation, b), localX1, localY), u);
+				const __m128 x1 = Lerp(Gradient(Gather(permutation, _mm_add_epi32(a, oneInteger)), localX, localY1), Gradient(Gather(permutation, _mm_add_epi32(b, oneInteger)), localX1, localY1), u);
+
+				_mm_storeu_ps(out + index, Lerp(x0, x1, v));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline size_t Perlin(const int32_t* permutation, const float* x, const float* y, const float* z, float* out, const size_t count)
+		{
+			const __m128i mask = _mm_set1_epi32(255);
+			const __m128i oneInteger = _mm_set1_epi32(1);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m128 sampleX = _mm_loadu_ps(x + index);
+				const __m128 sampleY = _mm_loadu_ps(y + index);
+				const __m128 sampleZ = _mm_loadu_ps(z + index);
+
+				const __m128 floorX = _mm_floor_ps(sampleX);
+				const __m128 floorY = _mm_floor_ps(sampleY);
+				const __m128 floorZ = _mm_floor_ps(sampleZ);
+
+				const __m128i cellX = _mm_and_si128(_mm_cvttps_epi32(floorX), mask);
+				const __m128i cellY = _mm_and_si128(_mm_cvttps_epi32(floorY), mask);
+				const __m128i cellZ = _mm_and_si128(_mm_cvttps_epi32(floorZ), mask);
+
+				const __m128 localX = _mm_sub_ps(sampleX, floorX);
+				const __m128 localY = _mm_sub_ps(sampleY, floorY);
+				const __m128 localZ = _mm_sub_ps(sampleZ, floorZ);
+				const __m128 localX1 = _mm_sub_ps(localX, one);
+				const __m128 localY1 = _mm_sub_ps(localY, one);
+				const __m128 localZ1 = _mm_sub_ps(localZ, one);
+
+				const __m128 u = Fade(localX);
+				const __m128 v = Fade(localY);
+				const __m128 w = Fade(localZ);
+
+				const __m128i a = _mm_add_epi32(Gather(permutation, cellX), cellY);
+				const __m128i aa = _mm_add_epi32(Gather(permutation, a), cellZ);
+				const __m128i ab = _mm_add_epi32(Gather(permutation, _mm_add_epi32(a, oneInteger)), cellZ);
+				const __m128i b = _mm_add_epi32(Gather(permutation, _mm_add_epi32(cellX, oneInteger)), cellY);
+				const __m128i ba = _mm_add_epi32(Gather(permutation, b), cellZ);
+				const __m128i bb = _mm_add_epi32(Gather(permutation, _mm_add_epi32(b, oneInteger)), cellZ);
+
+				const __m128 x0 = Lerp(Gradient(Gather(permutation, aa), localX, localY, localZ), Gradient(Gather(permutation, ba), localX1, localY, localZ), u);
+				const __m128 x1 = Lerp(Gradient(Gather(permutation, ab), localX, localY1, localZ), Gradient(Gather(permutation, bb), localX1, localY1, localZ), u);
+				const __m128 x2 = Lerp(Gradient(Gather(permutation, _mm_add_epi32(aa, oneInteger)), localX, localY, localZ1), Gradient(Gather(permutation, _mm_add_epi32(ba, oneInteger)), localX1, localY, localZ1), u);
+				const __m128 x3 = Lerp(Gradient(Gather(permutation, _mm_add_epi32(ab, oneInteger)), localX, localY1, localZ1), Gradient(Gather(permutation, _mm_add_epi32(bb, oneInteger)), localX1, localY1, localZ1), u);
+
+				_mm_storeu_ps(out + index, Lerp(Lerp(x0, x1, v), Lerp(x2, x3, v), w));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline size_t Simplex(const int32_t* permutation, const float* x, const float* y, float* out, const size_t count)
+		{
+			const __m128i mask = _mm_set1_epi32(255);
+			const __m128i oneInteger = _mm_set1_epi32(1);
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m128 sampleX = _mm_loadu_ps(x + index);
+				const __m128 sampleY = _mm_loadu_ps(y + index);
+
+				const __m128 skew = _mm_mul_ps(_mm_add_ps(sampleX, sampleY), _mm_set1_ps(Simplex2Skew));
+				const __m128 cellX = _mm_floor_ps(_mm_add_ps(sampleX, skew));
+				const __m128 cellY = _mm_floor_ps(_mm_add_ps(sampleY, skew));
+				const __m128 unskew = _mm_mul_ps(_mm_add_ps(cellX, cellY), _mm_set1_ps(Simplex2Unskew));
+
+				const __m128 x0 = _mm_sub_ps(sampleX, _mm_sub_ps(cellX, unskew));
+				const __m128 y0 = _mm_sub_ps(sampleY, _mm_sub_ps(cellY, unskew));
+
+				const __m128 lower = _mm_cmpgt_ps(x0, y0);
+				const __m128i lowerInteger = _mm_castps_si128(lower);
+
+				const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(lower, one)), _mm_set1_ps(Simplex2Unskew));
+				const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lower, one)), _mm_set1_ps(Simplex2Unskew));
+				const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(Simplex2UnskewDouble));
+				const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(Simplex2UnskewDouble));
+
+				const __m128i i = _mm_and_si128(_mm_cvttps_epi32(cellX), mask);
+				const __m128i j = _mm_and_si128(_mm_cvttps_epi32(cellY), mask);
+				const __m128i i1 = _mm_and_si128(lowerInteger, oneInteger);
+				const __m128i j1 = _mm_andnot_si128(lowerInteger, oneInteger);
+
+				const __m128i hash0 = Gather(permutation, _mm_add_epi32(i, Gather(permutation, j)));
+				const __m128i hash1 = Gather(permutation, _mm_add_epi32(_mm_add_epi32(i, i1), Gather(permutation, _mm_add_epi32(j, j1))));
+				const __m128i hash2 = Gather(permutation, _mm_add_epi32(_mm_add_epi32(i, oneInteger), Gather(permutation, _mm_add_epi32(j, oneInteger))));
+
+				const __m128 sum = _mm_add_ps(_mm_add_ps(Corner(hash0, x0, y0), Corner(hash1, x1, y1)), Corner(hash2, x2, y2));
+
+				_mm_storeu_ps(out + index, _mm_mul_ps(_mm_set1_ps(Simplex2Scale), sum));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("sse4.1") inline size_t Simplex(const int32_t* permutation, const float* x, const float* y, const float* z, float* out, const size_t count)
+		{
+			const __m128i mask = _mm_set1_epi32(255);
+			const __m128i oneInteger = _mm_set1_epi32(1);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m128 sampleX = _mm_loadu_ps(x + index);
+				const __m128 sampleY = _mm_loadu_ps(y + index);
+				const __m128 sampleZ = _mm_loadu_ps(z + index);
+
+				const __m128 skew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(sampleX, sampleY), sampleZ), _mm_set1_ps(Simplex3Skew));
+				const __m128 cellX = _mm_floor_ps(_mm_add_ps(sampleX, skew));
+				const __m128 cellY = _mm_floor_ps(_mm_add_ps(sampleY, skew));
+				const __m128 cellZ = _mm_floor_ps(_mm_add_ps(sampleZ, skew));
+				const __m128 unskew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(cellX, cellY), cellZ), _mm_set1_ps(Simplex3Unskew));
+
+				const __m128 x0 = _mm_sub_ps(sampleX, _mm_sub_ps(cellX, unskew));
+				const __m128 y0 = _mm_sub_ps(sampleY, _mm_sub_ps(cellY, unskew));
+				const __m128 z0 = _mm_sub_ps(sampleZ, _mm_sub_ps(cellZ, unskew));
+
+				const __m128 xy = _mm_cmpge_ps(x0, y0);
+				const __m128 xz = _mm_cmpge_ps(x0, z0);
+				const __m128 yz = _mm_cmpge_ps(y0, z0);
+
+				const __m128 i1 = _mm_and_ps(xy, xz);
+				const __m128 j1 = _mm_andnot_ps(xy, yz);
+				const __m128 k1 = _mm_andnot_ps(_mm_or_ps(xz, yz), all);
+				const __m128 i2 = _mm_or_ps(xy, xz);
+				const __m128 j2 = _mm_or_ps(_mm_andnot_ps(xy, _mm_castsi128_ps(_mm_set1_epi32(-1))), yz);
+				const __m128 k2 = _mm_andnot_ps(_mm_and_ps(xz, yz), all);
+
+				const __m128 x1 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i1, one)), _mm_set1_ps(Simplex3Unskew));
+				const __m128 y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j1, one)), _mm_set1_ps(Simplex3Unskew));
+				const __m128 z1 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k1, one)), _mm_set1_ps(Simplex3Unskew));
+				const __m128 x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_and_ps(i2, one)), _mm_set1_ps(Simplex3UnskewDouble));
+				const __m128 y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_and_ps(j2, one)), _mm_set1_ps(Simplex3UnskewDouble));
+				const __m128 z2 = _mm_add_ps(_mm_sub_ps(z0, _mm_and_ps(k2, one)), _mm_set1_ps(Simplex3UnskewDouble));
+				const __m128 x3 = _mm_add_ps(_mm_sub_ps(x0, one), _mm_set1_ps(Simplex3UnskewTriple));
+				const __m128 y3 = _mm_add_ps(_mm_sub_ps(y0, one), _mm_set1_ps(Simplex3UnskewTriple));
+				const __m128 z3 = _mm_add_ps(_mm_sub_ps(z0, one), _mm_set1_ps(Simplex3UnskewTriple));
+
+				const __m128i i = _mm_and_si128(_mm_cvttps_epi32(cellX), mask);
+				const __m128i j = _mm_and_si128(_mm_cvttps_epi32(cellY), mask);
+				const __m128i k = _mm_and_si128(_mm_cvttps_epi32(cellZ), mask);
+
+				const __m128i i1Integer = _mm_and_si128(_mm_castps_si128(i1), oneInteger);
+				const __m128i j1Integer = _mm_and_si128(_mm_castps_si128(j1), oneInteger);
+				const __m128i k1Integer = _mm_and_si128(_mm_castps_si128(k1), oneInteger);
+				const __m128i i2Integer = _mm_and_si128(_mm_castps_si128(i2), oneInteger);
+				const __m128i j2Integer = _mm_and_si128(_mm_castps_si128(j2), oneInteger);
+				const __m128i k2Integer = _mm_and_si128(_mm_castps_si128(k2), oneInteger);
+
+				const __m128i hash0 = Gather(permutation, _mm_add_epi32(i, Gather(permutation, _mm_add_epi32(j, Gather(permutation, k)))));
+				const __m128i hash1 = Gather(permutation, _mm_add_epi32(_mm_add_epi32(i, i1Integer), Gather(permutation, _mm_add_epi32(_mm_add_epi32(j, j1Integer), Gather(permutation, _mm_add_epi32(k, k1Integer))))));
+				const __m128i hash2 = Gather(permutation, _mm_add_epi32(_mm_add_epi32(i, i2Integer), Gather(permutation, _mm_add_epi32(_mm_add_epi32(j, j2Integer), Gather(permutation, _mm_add_epi32(k, k2Integer))))));
+				const __m128i hash3 = Gather(permutation, _mm_add_epi32(_mm_add_epi32(i, oneInteger), Gather(permutation, _mm_add_epi32(_mm_add_epi32(j, oneInteger), Gather(permutation, _mm_add_epi32(k, oneInteger))))));
+
+				const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(Corner(hash0, x0, y0, z0), Corner(hash1, x1, y1, z1)), Corner(hash2, x2, y2, z2)), Corner(hash3, x3, y3, z3));
+
+				_mm_storeu_ps(out + index, _mm_mul_ps(_mm_set1_ps(Simplex3Scale), sum));
+			}
+
+			return index;
+		}
+	}
+
+	namespace Avx2
+	{
+		inline constexpr size_t Width = 8;
+
+		MULTIVOXEL_TARGET("avx2") inline __m256i Gather(const int32_t* table, const __m256i index)
+		{
+			return _mm256_i32gather_epi32(table, index, 4);
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Fade(const __m256 t)
+		{
+			const __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+
+			return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Lerp(const __m256 a, const __m256 b, const __m256 t)
+		{
+			return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 FlipSign(const __m256 value, const __m256i hash, const int32_t bit, const int32_t shift)
+		{
+			return _mm256_xor_ps(value, _mm256_castsi256_ps(_mm256_sll_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(bit)), _mm_cvtsi32_si128(shift))));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Gradient(const __m256i hash, const __m256 x, const __m256 y)
+		{
+			const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(4)), _mm256_set1_epi32(4)));
+
+			const __m256 u = _mm256_blendv_ps(x, y, swap);
+			const __m256 v = _mm256_blendv_ps(y, x, swap);
+
+			return _mm256_add_ps(FlipSign(u, hash, 1, 31), _mm256_mul_ps(FlipSign(v, hash, 2, 30), _mm256_set1_ps(0.5f)));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Gradient(const __m256i hash, const __m256 x, const __m256 y, const __m256 z)
+		{
+			const __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+
+			const __m256 lowerThanEight = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(8), h));
+			const __m256 lowerThanFour = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h));
+			const __m256 twelveOrFourteen = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)), _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+
+			const __m256 u = _mm256_blendv_ps(y, x, lowerThanEight);
+			const __m256 v = _mm256_blendv_ps(_mm256_blendv_ps(z, x, twelveOrFourteen), y, lowerThanFour);
+
+			return _mm256_add_ps(FlipSign(u, h, 1, 31), FlipSign(v, h, 2, 30));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Corner(const __m256i hash, const __m256 x, const __m256 y)
+		{
+			const __m256 t = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(Simplex2Radius), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y));
+			const __m256 t2 = _mm256_mul_ps(t, t);
+
+			return _mm256_and_ps(_mm256_mul_ps(_mm256_mul_ps(t2, t2), Gradient(hash, x, y)), _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline __m256 Corner(const __m256i hash, const __m256 x, const __m256 y, const __m256 z)
+		{
+			const __m256 t = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(Simplex3Radius), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+			const __m256 t2 = _mm256_mul_ps(t, t);
+
+			return _mm256_and_ps(_mm256_mul_ps(_mm256_mul_ps(t2, t2), Gradient(hash, x, y, z)), _mm256_cmp_ps(t, _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline size_t Perlin(const int32_t* permutation, const float* x, const float* y, float* out, const size_t count)
+		{
+			const __m256i mask = _mm256_set1_epi32(255);
+			const __m256i oneInteger = _mm256_set1_epi32(1);
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m256 sampleX = _mm256_loadu_ps(x + index);
+				const __m256 sampleY = _mm256_loadu_ps(y + index);
+
+				const __m256 floorX = _mm256_floor_ps(sampleX);
+				const __m256 floorY = _mm256_floor_ps(sampleY);
+
+				const __m256i cellX = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask);
+				const __m256i cellY = _mm256_and_si256(_mm256_cvttps_epi32(floorY), mask);
+
+				const __m256 localX = _mm256_sub_ps(sampleX, floorX);
+				const __m256 localY = _mm256_sub_ps(sampleY, floorY);
+				const __m256 localX1 = _mm256_sub_ps(localX, one);
+				const __m256 localY1 = _mm256_sub_ps(localY, one);
+
+				const __m256 u = Fade(localX);
+				const __m256 v = Fade(localY);
+
+				const __m256i a = _mm256_add_epi32(Gather(permutation, cellX), cellY);
+				const __m256i b = _mm256_add_epi32(Gather(permutation, _mm256_add_epi32(cellX, oneInteger)), cellY);
+
+				const __m256 x0 = Lerp(Gradient(Gather(permutation, a), localX, localY), Gradient(Gather(permutation, b), localX1, localY), u);
+				const __m256 x1 = Lerp(Gradient(Gather(permutation, _mm256_add_epi32(a, oneInteger)), localX, localY1), Gradient(Gather(permutation, _mm256_add_epi32(b, oneInteger)), localX1, localY1), u);
+
+				_mm256_storeu_ps(out + index, Lerp(x0, x1, v));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline size_t Perlin(const int32_t* permutation, const float* x, const float* y, const float* z, float* out, const size_t count)
+		{
+			const __m256i mask = _mm256_set1_epi32(255);
+			const __m256i oneInteger = _mm256_set1_epi32(1);
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m256 sampleX = _mm256_loadu_ps(x + index);
+				const __m256 sampleY = _mm256_loadu_ps(y + index);
+				const __m256 sampleZ = _mm256_loadu_ps(z + index);
+
+				const __m256 floorX = _mm256_floor_ps(sampleX);
+				const __m256 floorY = _mm256_floor_ps(sampleY);
+				const __m256 floorZ = _mm256_floor_ps(sampleZ);
+
+				const __m256i cellX = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask);
+				const __m256i cellY = _mm256_and_si256(_mm256_cvttps_epi32(floorY), mask);
+				const __m256i cellZ = _mm256_and_si256(_mm256_cvttps_epi32(floorZ), mask);
+
+				const __m256 localX = _mm256_sub_ps(sampleX, floorX);
+				const __m256 localY = _mm256_sub_ps(sampleY, floorY);
+				const __m256 localZ = _mm256_sub_ps(sampleZ, floorZ);
+				const __m256 localX1 = _mm256_sub_ps(localX, one);
+				const __m256 localY1 = _mm256_sub_ps(localY, one);
+				const __m256 localZ1 = _mm256_sub_ps(localZ, one);
+
+				const __m256 u = Fade(localX);
+				const __m256 v = Fade(localY);
+				const __m256 w = Fade(localZ);
+
+				const __m256i a = _mm256_add_epi32(Gather(permutation, cellX), cellY);
+				const __m256i aa = _mm256_add_epi32(Gather(permutation, a), cellZ);
+				const __m256i ab = _mm256_add_epi32(Gather(permutation, _mm256_add_epi32(a, oneInteger)), cellZ);
+				const __m256i b = _mm256_add_epi32(Gather(permutation, _mm256_add_epi32(cellX, oneInteger)), cellY);
+				const __m256i ba = _mm256_add_epi32(Gather(permutation, b), cellZ);
+				const __m256i bb = _mm256_add_epi32(Gather(permutation, _mm256_add_epi32(b, oneInteger)), cellZ);
+
+				const __m256 x0 = Lerp(Gradient(Gather(permutation, aa), localX, localY, localZ), Gradient(Gather(permutation, ba), localX1, localY, localZ), u);
+				const __m256 x1 = Lerp(Gradient(Gather(permutation, ab), localX, localY1, localZ), Gradient(Gather(permutation, bb), localX1, localY1, localZ), u);
+				const __m256 x2 = Lerp(Gradient(Gather(permutation, _mm256_add_epi32(aa, oneInteger)), localX, localY, localZ1), Gradient(Gather(permutation, _mm256_add_epi32(ba, oneInteger)), localX1, localY, localZ1), u);
+				const __m256 x3 = Lerp(Gradient(Gather(permutation, _mm256_add_epi32(ab, oneInteger)), localX, localY1, localZ1), Gradient(Gather(permutation, _mm256_add_epi32(bb, oneInteger)), localX1, localY1, localZ1), u);
+
+				_mm256_storeu_ps(out + index, Lerp(Lerp(x0, x1, v), Lerp(x2, x3, v), w));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline size_t Simplex(const int32_t* permutation, const float* x, const float* y, float* out, const size_t count)
+		{
+			const __m256i mask = _mm256_set1_epi32(255);
+			const __m256i oneInteger = _mm256_set1_epi32(1);
+			const __m256 one = _mm256_set1_ps(1.0f);
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m256 sampleX = _mm256_loadu_ps(x + index);
+				const __m256 sampleY = _mm256_loadu_ps(y + index);
+
+				const __m256 skew = _mm256_mul_ps(_mm256_add_ps(sampleX, sampleY), _mm256_set1_ps(Simplex2Skew));
+				const __m256 cellX = _mm256_floor_ps(_mm256_add_ps(sampleX, skew));
+				const __m256 cellY = _mm256_floor_ps(_mm256_add_ps(sampleY, skew));
+				const __m256 unskew = _mm256_mul_ps(_mm256_add_ps(cellX, cellY), _mm256_set1_ps(Simplex2Unskew));
+
+				const __m256 x0 = _mm256_sub_ps(sampleX, _mm256_sub_ps(cellX, unskew));
+				const __m256 y0 = _mm256_sub_ps(sampleY, _mm256_sub_ps(cellY, unskew));
+
+				const __m256 lower = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+				const __m256i lowerInteger = _mm256_castps_si256(lower);
+
+				const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(lower, one)), _mm256_set1_ps(Simplex2Unskew));
+				const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_andnot_ps(lower, one)), _mm256_set1_ps(Simplex2Unskew));
+				const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(Simplex2UnskewDouble));
+				const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, one), _mm256_set1_ps(Simplex2UnskewDouble));
+
+				const __m256i i = _mm256_and_si256(_mm256_cvttps_epi32(cellX), mask);
+				const __m256i j = _mm256_and_si256(_mm256_cvttps_epi32(cellY), mask);
+				const __m256i i1 = _mm256_and_si256(lowerInteger, oneInteger);
+				const __m256i j1 = _mm256_andnot_si256(lowerInteger, oneInteger);
+
+				const __m256i hash0 = Gather(permutation, _mm256_add_epi32(i, Gather(permutation, j)));
+				const __m256i hash1 = Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(i, i1), Gather(permutation, _mm256_add_epi32(j, j1))));
+				const __m256i hash2 = Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(i, oneInteger), Gather(permutation, _mm256_add_epi32(j, oneInteger))));
+
+				const __m256 sum = _mm256_add_ps(_mm256_add_ps(Corner(hash0, x0, y0), Corner(hash1, x1, y1)), Corner(hash2, x2, y2));
+
+				_mm256_storeu_ps(out + index, _mm256_mul_ps(_mm256_set1_ps(Simplex2Scale), sum));
+			}
+
+			return index;
+		}
+
+		MULTIVOXEL_TARGET("avx2") inline size_t Simplex(const int32_t* permutation, const float* x, const float* y, const float* z, float* out, const size_t count)
+		{
+			const __m256i mask = _mm256_set1_epi32(255);
+			const __m256i oneInteger = _mm256_set1_epi32(1);
+			const __m256 one = _mm256_set1_ps(1.0f);
+			const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+			size_t index = 0;
+
+			for (; index + Width <= count; index += Width)
+			{
+				const __m256 sampleX = _mm256_loadu_ps(x + index);
+				const __m256 sampleY = _mm256_loadu_ps(y + index);
+				const __m256 sampleZ = _mm256_loadu_ps(z + index);
+
+				const __m256 skew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(sampleX, sampleY), sampleZ), _mm256_set1_ps(Simplex3Skew));
+				const __m256 cellX = _mm256_floor_ps(_mm256_add_ps(sampleX, skew));
+				const __m256 cellY = _mm256_floor_ps(_mm256_add_ps(sampleY, skew));
+				const __m256 cellZ = _mm256_floor_ps(_mm256_add_ps(sampleZ, skew));
+				const __m256 unskew = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(cellX, cellY), cellZ), _mm256_set1_ps(Simplex3Unskew));
+
+				const __m256 x0 = _mm256_sub_ps(sampleX, _mm256_sub_ps(cellX, unskew));
+				const __m256 y0 = _mm256_sub_ps(sampleY, _mm256_sub_ps(cellY, unskew));
+				const __m256 z0 = _mm256_sub_ps(sampleZ, _mm256_sub_ps(cellZ, unskew));
+
+				const __m256 xy = _mm256_cmp_ps(x0, y0, _CMP_GE_OQ);
+				const __m256 xz = _mm256_cmp_ps(x0, z0, _CMP_GE_OQ);
+				const __m256 yz = _mm256_cmp_ps(y0, z0, _CMP_GE_OQ);
+
+				const __m256 i1 = _mm256_and_ps(xy, xz);
+				const __m256 j1 = _mm256_andnot_ps(xy, yz);
+				const __m256 k1 = _mm256_andnot_ps(_mm256_or_ps(xz, yz), all);
+				const __m256 i2 = _mm256_or_ps(xy, xz);
+				const __m256 j2 = _mm256_or_ps(_mm256_andnot_ps(xy, all), yz);
+				const __m256 k2 = _mm256_andnot_ps(_mm256_and_ps(xz, yz), all);
+
+				const __m256 x1 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(i1, one)), _mm256_set1_ps(Simplex3Unskew));
+				const __m256 y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_and_ps(j1, one)), _mm256_set1_ps(Simplex3Unskew));
+				const __m256 z1 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_and_ps(k1, one)), _mm256_set1_ps(Simplex3Unskew));
+				const __m256 x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_and_ps(i2, one)), _mm256_set1_ps(Simplex3UnskewDouble));
+				const __m256 y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_and_ps(j2, one)), _mm256_set1_ps(Simplex3UnskewDouble));
+				const __m256 z2 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_and_ps(k2, one)), _mm256_set1_ps(Simplex3UnskewDouble));
+				const __m256 x3 = _mm256_add_ps(_mm256_sub_ps(x0, one), _mm256_set1_ps(Simplex3UnskewTriple));
+				const __m256 y3 = _mm256_add_ps(_mm256_sub_ps(y0, one), _mm256_set1_ps(Simplex3UnskewTriple));
+				const __m256 z3 = _mm256_add_ps(_mm256_sub_ps(z0, one), _mm256_set1_ps(Simplex3UnskewTriple));
+
+				const __m256i i = _mm256_and_si256(_mm256_cvttps_epi32(cellX), mask);
+				const __m256i j = _mm256_and_si256(_mm256_cvttps_epi32(cellY), mask);
+				const __m256i k = _mm256_and_si256(_mm256_cvttps_epi32(cellZ), mask);
+
+				const __m256i i1Integer = _mm256_and_si256(_mm256_castps_si256(i1), oneInteger);
+				const __m256i j1Integer = _mm256_and_si256(_mm256_castps_si256(j1), oneInteger);
+				const __m256i k1Integer = _mm256_and_si256(_mm256_castps_si256(k1), oneInteger);
+				const __m256i i2Integer = _mm256_and_si256(_mm256_castps_si256(i2), oneInteger);
+				const __m256i j2Integer = _mm256_and_si256(_mm256_castps_si256(j2), oneInteger);
+				const __m256i k2Integer = _mm256_and_si256(_mm256_castps_si256(k2), oneInteger);
+
+				const __m256i hash0 = Gather(permutation, _mm256_add_epi32(i, Gather(permutation, _mm256_add_epi32(j, Gather(permutation, k)))));
+				const __m256i hash1 = Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(i, i1Integer), Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(j, j1Integer), Gather(permutation, _mm256_add_epi32(k, k1Integer))))));
+				const __m256i hash2 = Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(i, i2Integer), Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(j, j2Integer), Gather(permutation, _mm256_add_epi32(k, k2Integer))))));
+				const __m256i hash3 = Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(i, oneInteger), Gather(permutation, _mm256_add_epi32(_mm256_add_epi32(j, oneInteger), Gather(permutation, _mm256_add_epi32(k, oneInteger))))));
+
+				const __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(Corner(hash0, x0, y0, z0), Corner(hash1, x1, y1, z1)), Corner(hash2, x2, y2, z2)), Corner(hash3, x3, y3, z3));
+
+				_mm256_storeu_ps(out + index, _mm256_mul_ps(_mm256_set1_ps(Simplex3Scale), sum));
+			}
+
+			return index;
+		}
+	}
+#endif
+}
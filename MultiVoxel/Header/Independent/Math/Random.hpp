@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MultiVoxel::Independent::Math
+{
+	class Random final
+	{
+
+	public:
+
+		explicit Random(const uint64_t seed) : state(seed) { }
+
+		[[nodiscard]]
+		static constexpr uint64_t Mix(uint64_t value)
+		{
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+
+			return value ^ (value >> 31);
+		}
+
+		[[nodiscard]]
+		static constexpr uint64_t Hash(const uint64_t seed, const int32_t x, const int32_t z)
+		{
+			return Mix(seed ^ Mix(static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 | static_cast<uint32_t>(z)));
+		}
+
+		uint64_t Next()
+		{
+			state += 0x9E3779B97F4A7C15ull;
+
+			return Mix(state);
+		}
+
+		uint32_t NextBelow(const uint32_t bound)
+		{
+			return static_cast<uint32_t>((Next() >> 32) * bound >> 32);
+		}
+
+		int32_t NextBetween(const int32_t minimum, const int32_t maximum)
+		{
+			return minimum + static_cast<int32_t>(NextBelow(static_cast<uint32_t>(maximum - minimum + 1)));
+		}
+
+	private:
+
+		uint64_t state;
+
+	};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define MULTIVOXEL_SIMD_X86
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define MULTIVOXEL_TARGET(isa)
+#else
+	#define MULTIVOXEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace MultiVoxel::Independent::Math
+{
+	enum class SimdLevel : uint8_t
+	{
+		Scalar,
+		Sse41,
+		Avx2
+	};
+
+	inline const char* GetSimdLevelName(const SimdLevel level)
+	{
+		switch (level)
+		{
+			case SimdLevel::Avx2:
+				return "avx2";
+
+			case SimdLevel::Sse41:
+				return "sse4.1";
+
+			default:
+				return "scalar";
+		}
+	}
+
+	inline SimdLevel DetectSimdLevel()
+	{
+		static const SimdLevel level = []()
+		{
+#if defined(MULTIVOXEL_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+
+			__cpuid(info, 0);
+
+			const int leafCount = info[0];
+
+			__cpuid(info, 1);
+
+			const bool sse41 = (info[2] & (1 << 19)) != 0;
+			const bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+
+			bool avx2 = false;
+
+			if (leafCount >= 7)
+			{
+				__cpuidex(info, 7, 0);
+
+				avx2 = avx && (info[1] & (1 << 5)) != 0;
+			}
+
+			if (avx2)
+				return SimdLevel::Avx2;
+
+			if (sse41)
+				return SimdLevel::Sse41;
+#elif defined(MULTIVOXEL_SIMD_X86)
+			__builtin_cpu_init();
+
+			if (__builtin_cpu_supports("avx2"))
+				return SimdLevel::Avx2;
+
+			if (__builtin_cpu_supports("sse4.1"))
+				return SimdLevel::Sse41;
+#endif
+			return SimdLevel::Scalar;
+		}();
+
+		return level;
+	}
+}
@@ -4,13 +4,13 @@
 #include <optional>
 #include <numbers>
 #include <functional>
-#include <cereal/types/optional.hpp>
 #include "Independent/ECS/Component.hpp"
 #include "Independent/ECS/ComponentFactory.hpp"
 #include "Independent/Math/Matrix.hpp"
 #include "Independent/Math/Vector.hpp"
 
 using namespace MultiVoxel::Independent::ECS;
+using namespace MultiVoxel::Independent::Network;
 
 namespace MultiVoxel::Independent::Math
 {
@@ -258,18 +258,24 @@ namespace MultiVoxel::Independent::Math
             return localMatrix;
         }
 
-        void Serialize(cereal::BinaryOutputArchive& archive) const override
+        void Serialize(WireOutputArchive& archive) const override
         {
             archive(localPosition, localRotation, localScale);
         }
 
-        void Deserialize(cereal::BinaryInputArchive& archive) override
+        void Deserialize(WireInputArchive& archive) override
         {
             archive(localPosition, localRotation, localScale);
 
             dirty = false;
         }
 
+        [[nodiscard]]
+        float GetReplicationPriority() const override
+        {
+            return 4.0f;
+        }
+
         void MarkDirty() override
         {
             dirty = true;
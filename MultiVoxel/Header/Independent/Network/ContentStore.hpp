@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MultiVoxel::Independent::Network
+{
+    using ContentHash = uint64_t;
+
+    class ContentStore final
+    {
+
+    public:
+
+        static constexpr size_t MaximumCacheSize = 64 * 1024 * 1024;
+        static constexpr size_t MinimumPruneThreshold = 64;
+
+        using Blob = std::shared_ptr<const std::string>;
+        using Fetcher = std::function<void(ContentHash)>;
+        using Callback = std::function<void(const std::string&)>;
+
+        ContentStore(const ContentStore&) = delete;
+        ContentStore(ContentStore&&) = delete;
+        ContentStore& operator=(const ContentStore&) = delete;
+        ContentStore& operator=(ContentStore&&) = delete;
+
+        void SetPublishing(const bool value)
+        {
+            publishing = value;
+        }
+
+        [[nodiscard]]
+        bool IsPublishing() const
+        {
+            return publishing;
+        }
+
+        void SetFetcher(Fetcher function)
+        {
+            std::lock_guard guard(mutex);
+
+            fetcher = std::move(function);
+        }
+
+        [[nodiscard]]
+        Blob Publish(std::string blob, ContentHash& outHash)
+        {
+            outHash = Hash(blob);
+
+            std::lock_guard guard(mutex);
+
+            auto& entry = publishedMap[outHash];
+
+            if (auto result = entry.lock())
+            {
+                if (*result == blob)
+                    return result;
+
+                std::cerr << "Content hash '" << outHash << "' collides with a different published blob, refusing to publish it.\n";
+                return nullptr;
+            }
+
+            Blob result(new const std::string(std::move(blob)));
+
+            entry = result;
+
+            if (publishedMap.size() >= pruneThreshold)
+            {
+                std::erase_if(publishedMap, [](const auto& pair) { return pair.second.expired(); });
+
+                pruneThreshold = std::max(MinimumPruneThreshold, publishedMap.size() * 2);
+            }
+
+            return result;
+        }
+
+        [[nodiscard]]
+        Blob Find(const ContentHash hash)
+        {
+            std::lock_guard guard(mutex);
+
+            return FindLocked(hash);
+        }
+
+        [[nodiscard]]
+        size_t GetCacheSize() const
+        {
+            std::lock_guard guard(mutex);
+
+            return cacheSize;
+        }
+
+        bool Store(const ContentHash hash, std::string blob)
+        {
+            if (Hash(blob) != hash)
+            {
+                std::cerr << "Content blob does not match its hash '" << hash << "', discarding it.\n";
+                return false;
+            }
+
+            std::vector<Callback> readyList;
+            Blob stored;
+
+            {
+                std::lock_guard guard(mutex);
+
+                stored = FindCached(hash);
+
+                if (stored && *stored != blob)
+                {
+                    std::cerr << "Content hash '" << hash << "' collides with a different cached blob, replacing it.\n";
+
+                    Evict(hash);
+                    stored.reset();
+                }
+
+                if (!stored)
+                    stored = Cache(hash, std::make_shared<const std::string>(std::move(blob)));
+
+                requestedSet.erase(hash);
+
+                if (const auto iterator = waiterMap.find(hash); iterator != waiterMap.end())
+                {
+                    readyList = std::move(iterator->second);
+                    waiterMap.erase(iterator);
+                }
+            }
+
+            for (const auto& callback : readyList)
+                callback(*stored);
+
+            return true;
+        }
+
+        void Reject(const ContentHash hash)
+        {
+            size_t waiterCount = 0;
+
+            {
+                std::lock_guard guard(mutex);
+
+                requestedSet.erase(hash);
+
+                if (const auto iterator = waiterMap.find(hash); iterator != waiterMap.end())
+                {
+                    waiterCount = iterator->second.size();
+                    waiterMap.erase(iterator);
+                }
+            }
+
+            std::cerr << "Content '" << hash << "' is unavailable, dropping " << waiterCount << " waiter(s).\n";
+        }
+
+        void Acquire(const ContentHash hash, Callback callback)
+        {
+            Blob blob;
+            Fetcher function;
+
+            {
+                std::lock_guard guard(mutex);
+
+                blob = FindLocked(hash);
+
+                if (!blob)
+                {
+                    waiterMap[hash].push_back(std::move(callback));
+
+                    if (!requestedSet.insert(hash).second)
+                        return;
+
+                    function = fetcher;
+                }
+            }
+
+            if (blob)
+                callback(*blob);
+            else if (function)
+                function(hash);
+            else
+                std::cerr << "No fetcher registered for missing content '" << hash << "'.\n";
+        }
+
+        static ContentHash Hash(const void* data, const size_t size)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+
+            ContentHash result = 0xcbf29ce484222325ULL;
+
+            for (size_t index = 0; index < size; ++index)
+            {
+                result ^= bytes[index];
+                result *= 0x100000001b3ULL;
+            }
+
+            result ^= size;
+            result *= 0x100000001b3ULL;
+
+            return result;
+        }
+
+        static ContentHash Hash(const std::string& data)
+        {
+            return Hash(data.data(), data.size());
+        }
+
+        static ContentStore& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<ContentStore>(new ContentStore());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct CacheEntry
+        {
+            Blob blob;
+            std::list<ContentHash>::iterator position;
+        };
+
+        ContentStore() = default;
+
+        Blob FindLocked(const ContentHash hash)
+        {
+            if (const auto iterator = publishedMap.find(hash); iterator != publishedMap.end())
+            {
+                if (auto result = iterator->second.lock())
+                    return result;
+            }
+
+            return FindCached(hash);
+        }
+
+        Blob FindCached(const ContentHash hash)
+        {
+            const auto iterator = cacheMap.find(hash);
+
+            if (iterator == cacheMap.end())
+                return nullptr;
+
+            recencyList.splice(recencyList.begin(), recencyList, iterator->second.position);
+
+            return iterator->second.blob;
+        }
+
+        Blob Cache(const ContentHash hash, Blob blob)
+        {
+            recencyList.push_front(hash);
+
+            cacheMap.emplace(hash, CacheEntry{ blob, recencyList.begin() });
+            cacheSize += blob->size();
+
+            while (cacheSize > MaximumCacheSize && recencyList.size() > 1)
+                Evict(recencyList.back());
+
+            return blob;
+        }
+
+        void Evict(const ContentHash hash)
+        {
+            const auto iterator = cacheMap.find(hash);
+
+            if (iterator == cacheMap.end())
+                return;
+
+            cacheSize -= iterator->second.blob->size();
+
+            recencyList.erase(iterator->second.position);
+            cacheMap.erase(iterator);
+        }
+
+        bool publishing = false;
+
+        Fetcher fetcher;
+
+        mutable std::mutex mutex;
+
+        std::unordered_map<ContentHash, std::weak_ptr<const std::string>> publishedMap;
+        size_t pruneThreshold = MinimumPruneThreshold;
+
+        std::unordered_map<ContentHash, CacheEntry> cacheMap;
+        std::list<ContentHash> recencyList;
+        size_t cacheSize = 0;
+
+        std::unordered_map<ContentHash, std::vector<Callback>> waiterMap;
+        std::unordered_set<ContentHash> requestedSet;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<ContentStore> instance;
+
+    };
+
+    std::once_flag ContentStore::initializationFlag;
+    std::unique_ptr<ContentStore> ContentStore::instance;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include "Independent/Network/WireArchive.hpp"
+
+namespace MultiVoxel::Independent::Network
+{
+    class DeltaEncoder final
+    {
+
+    public:
+
+        explicit DeltaEncoder(WireOutputArchive& archive) : archive(archive) { }
+
+        DeltaEncoder(const DeltaEncoder&) = delete;
+        DeltaEncoder(DeltaEncoder&&) = delete;
+        DeltaEncoder& operator=(const DeltaEncoder&) = delete;
+        DeltaEncoder& operator=(DeltaEncoder&&) = delete;
+
+        void Write(const uint64_t value)
+        {
+            archive.WriteVarint(value - previous);
+            previous = value;
+        }
+
+        void WriteRelative(const uint64_t value, const uint64_t base)
+        {
+            archive.WriteVarint(WireDetail::ZigZagEncode(static_cast<int64_t>(value - base)));
+        }
+
+    private:
+
+        WireOutputArchive& archive;
+
+        uint64_t previous = 0;
+
+    };
+
+    class DeltaDecoder final
+    {
+
+    public:
+
+        explicit DeltaDecoder(WireInputArchive& archive) : archive(archive) { }
+
+        DeltaDecoder(const DeltaDecoder&) = delete;
+        DeltaDecoder(DeltaDecoder&&) = delete;
+        DeltaDecoder& operator=(const DeltaDecoder&) = delete;
+        DeltaDecoder& operator=(DeltaDecoder&&) = delete;
+
+        template <std::unsigned_integral T>
+        T Read()
+        {
+            previous += archive.ReadVarint();
+
+            return static_cast<T>(previous);
+        }
+
+        template <std::unsigned_integral T>
+        T ReadRelative(const uint64_t base)
+        {
+            return static_cast<T>(base + static_cast<uint64_t>(WireDetail::ZigZagDecode<int64_t>(archive.ReadVarint())));
+        }
+
+    private:
+
+        WireInputArchive& archive;
+
+        uint64_t previous = 0;
+
+    };
+}
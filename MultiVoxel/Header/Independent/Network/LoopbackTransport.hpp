@@ -0,0 +1,511 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "Independent/Network/Transport.hpp"
+
+using namespace std::chrono;
+
+namespace MultiVoxel::Independent::Network
+{
+    struct LoopbackSettings
+    {
+        microseconds latency{ 0 };
+        microseconds jitter{ 0 };
+
+        float lossRate = 0.0f;
+
+        size_t bytesPerSecond = 0;
+
+        uint64_t seed = 1;
+    };
+
+    class LoopbackTransport;
+
+    class LoopbackNetwork final
+    {
+
+    public:
+
+        explicit LoopbackNetwork(const LoopbackSettings& settings = { }) : settings(settings), random(settings.seed) { }
+
+        LoopbackNetwork(const LoopbackNetwork&) = delete;
+        LoopbackNetwork(LoopbackNetwork&&) = delete;
+        LoopbackNetwork& operator=(const LoopbackNetwork&) = delete;
+        LoopbackNetwork& operator=(LoopbackNetwork&&) = delete;
+
+        void SetSettings(const LoopbackSettings& value)
+        {
+            std::lock_guard lock(mutex);
+
+            settings = value;
+            random.seed(value.seed);
+        }
+
+        [[nodiscard]]
+        LoopbackSettings GetSettings() const
+        {
+            std::lock_guard lock(mutex);
+
+            return settings;
+        }
+
+        void Advance(const steady_clock::duration step)
+        {
+            std::lock_guard lock(mutex);
+
+            if (!manualTime)
+                manualTime = steady_clock::now();
+
+            *manualTime += step;
+        }
+
+        [[nodiscard]]
+        steady_clock::time_point Now() const
+        {
+            std::lock_guard lock(mutex);
+
+            return GetTime();
+        }
+
+    private:
+
+        friend class LoopbackTransport;
+
+        static constexpr seconds RateWindow{ 1 };
+        static constexpr int MaximumRetransmissions = 16;
+
+        struct Delivery
+        {
+            steady_clock::time_point due;
+            uint64_t sequence = 0;
+
+            LoopbackTransport* target = nullptr;
+            HSteamNetConnection connection = k_HSteamNetConnection_Invalid;
+
+            Transport::ConnectionEvent event = Transport::ConnectionEvent::Connected;
+
+            bool reliable = true;
+            std::shared_ptr<MessageBufferPool::Buffer> buffer;
+
+            bool operator>(const Delivery& other) const
+            {
+                return due != other.due ? due > other.due : sequence > other.sequence;
+            }
+        };
+
+        using DeliveryQueue = std::priority_queue<Delivery, std::vector<Delivery>, std::greater<>>;
+
+        struct Inbox
+        {
+            DeliveryQueue eventQueue;
+            DeliveryQueue frameQueue;
+        };
+
+        struct Endpoint
+        {
+            LoopbackTransport* owner = nullptr;
+            HSteamNetConnection remote = k_HSteamNetConnection_Invalid;
+
+            Transport::ConnectionState state = Transport::ConnectionState::Connecting;
+
+            steady_clock::time_point linkBusyUntil;
+            steady_clock::time_point lastReliableDue;
+
+            int pendingReliableBytes = 0;
+            int pendingUnreliableBytes = 0;
+
+            uint64_t windowOutBytes = 0;
+            uint64_t windowInBytes = 0;
+            steady_clock::time_point windowStart;
+
+            float outBytesPerSecond = 0.0f;
+            float inBytesPerSecond = 0.0f;
+        };
+
+        steady_clock::time_point GetTime() const
+        {
+            return manualTime ? *manualTime : steady_clock::now();
+        }
+
+        void Register(LoopbackTransport* transport, const uint16_t port)
+        {
+            std::lock_guard lock(mutex);
+
+            listenerMap[port] = transport;
+        }
+
+        void Unregister(LoopbackTransport* transport)
+        {
+            std::lock_guard lock(mutex);
+
+            std::erase_if(listenerMap, [&](const auto& pair) { return pair.second == transport; });
+
+            for (auto& [handle, endpoint] : endpointMap)
+            {
+                if (endpoint.owner == transport)
+                    CloseLocked(handle);
+            }
+
+            std::erase_if(endpointMap, [&](const auto& pair) { return pair.second.owner == transport; });
+
+            inboxMap.erase(transport);
+        }
+
+        HSteamNetConnection Connect(LoopbackTransport* client, const uint16_t port)
+        {
+            std::lock_guard lock(mutex);
+
+            const auto iterator = listenerMap.find(port);
+
+            if (iterator == listenerMap.end())
+                return k_HSteamNetConnection_Invalid;
+
+            const auto now = GetTime();
+
+            const HSteamNetConnection clientHandle = nextHandle++;
+            const HSteamNetConnection serverHandle = nextHandle++;
+
+            endpointMap[clientHandle] = Endpoint{ client, serverHandle, Transport::ConnectionState::Connecting, now, now, 0, 0, 0, 0, now };
+            endpointMap[serverHandle] = Endpoint{ iterator->second, clientHandle, Transport::ConnectionState::Connecting, now, now, 0, 0, 0, 0, now };
+
+            ScheduleEvent(iterator->second, serverHandle, Transport::ConnectionEvent::Accepted, now + settings.latency);
+            ScheduleEvent(iterator->second, serverHandle, Transport::ConnectionEvent::Connected, now + settings.latency);
+            ScheduleEvent(client, clientHandle, Transport::ConnectionEvent::Connected, now + settings.latency * 2);
+
+            return clientHandle;
+        }
+
+        void Close(const HSteamNetConnection handle)
+        {
+            std::lock_guard lock(mutex);
+
+            CloseLocked(handle);
+
+            endpointMap.erase(handle);
+        }
+
+        void Send(std::vector<TransportFrame>& frameList)
+        {
+            std::lock_guard lock(mutex);
+
+            const auto now = GetTime();
+
+            for (auto& frame : frameList)
+            {
+                const auto source = endpointMap.find(frame.connection);
+
+                if (source == endpointMap.end() || source->second.state == Transport::ConnectionState::Closed)
+                {
+                    MessageBufferPool::Release(std::move(frame.buffer));
+                    continue;
+                }
+
+                auto& endpoint = source->second;
+                const auto size = frame.buffer->size();
+
+                AccumulateRate(endpoint, now, size, 0);
+
+                auto departure = std::max(now, endpoint.linkBusyUntil);
+
+                if (settings.bytesPerSecond)
+                    departure += duration_cast<steady_clock::duration>(duration<double>(static_cast<double>(size) / static_cast<double>(settings.bytesPerSecond)));
+
+                endpoint.linkBusyUntil = departure;
+
+                auto due = departure + settings.latency + SampleJitter();
+
+                if (frame.reliable)
+                {
+                    for (int attempt = 0; attempt < MaximumRetransmissions && SampleLoss(); ++attempt)
+                        due += settings.latency * 2 + settings.jitter + milliseconds(1);
+
+                    due = std::max(due, endpoint.lastReliableDue);
+                    endpoint.lastReliableDue = due;
+                    endpoint.pendingReliableBytes += static_cast<int>(size);
+                }
+                else if (SampleLoss())
+                {
+                    MessageBufferPool::Release(std::move(frame.buffer));
+                    continue;
+                }
+                else
+                    endpoint.pendingUnreliableBytes += static_cast<int>(size);
+
+                const auto target = endpointMap.find(endpoint.remote);
+
+                if (target == endpointMap.end())
+                {
+                    MessageBufferPool::Release(std::move(frame.buffer));
+                    continue;
+                }
+
+                Delivery delivery;
+
+                delivery.due = due;
+                delivery.sequence = nextSequence++;
+                delivery.target = target->second.owner;
+                delivery.connection = endpoint.remote;
+                delivery.reliable = frame.reliable;
+                delivery.buffer = std::shared_ptr<MessageBufferPool::Buffer>(frame.buffer.release(), [](MessageBufferPool::Buffer* buffer) { MessageBufferPool::Release(std::unique_ptr<MessageBufferPool::Buffer>(buffer)); });
+
+                inboxMap[delivery.target].frameQueue.push(std::move(delivery));
+            }
+
+            frameList.clear();
+        }
+
+        void Drain(LoopbackTransport* target, bool includeFrames, const Transport::EventCallback& eventCallback, const Transport::ReceiveCallback& receiveCallback);
+
+        [[nodiscard]]
+        Transport::ConnectionState GetState(const HSteamNetConnection handle) const
+        {
+            std::lock_guard lock(mutex);
+
+            const auto iterator = endpointMap.find(handle);
+
+            return iterator != endpointMap.end() ? iterator->second.state : Transport::ConnectionState::Closed;
+        }
+
+        bool GetStatus(const HSteamNetConnection handle, ConnectionStatus& outStatus) const
+        {
+            std::lock_guard lock(mutex);
+
+            const auto iterator = endpointMap.find(handle);
+
+            if (iterator == endpointMap.end())
+                return false;
+
+            const auto& endpoint = iterator->second;
+            const auto now = GetTime();
+
+            outStatus.ping = static_cast<int>(duration_cast<milliseconds>(settings.latency * 2 + settings.jitter).count());
+            outStatus.quality = 1.0f - settings.lossRate;
+            outStatus.outBytesPerSecond = endpoint.outBytesPerSecond;
+            outStatus.inBytesPerSecond = endpoint.inBytesPerSecond;
+            outStatus.pendingReliableBytes = endpoint.pendingReliableBytes;
+            outStatus.pendingUnreliableBytes = endpoint.pendingUnreliableBytes;
+            outStatus.queueTime = endpoint.linkBusyUntil > now ? duration_cast<microseconds>(endpoint.linkBusyUntil - now).count() : 0;
+
+            return true;
+        }
+
+        void CloseLocked(const HSteamNetConnection handle)
+        {
+            const auto iterator = endpointMap.find(handle);
+
+            if (iterator == endpointMap.end() || iterator->second.state == Transport::ConnectionState::Closed)
+                return;
+
+            iterator->second.state = Transport::ConnectionState::Closed;
+
+            if (const auto remote = endpointMap.find(iterator->second.remote); remote != endpointMap.end() && remote->second.state != Transport::ConnectionState::Closed)
+                ScheduleEvent(remote->second.owner, iterator->second.remote, Transport::ConnectionEvent::Closed, GetTime() + settings.latency);
+        }
+
+        void ScheduleEvent(LoopbackTransport* target, const HSteamNetConnection handle, const Transport::ConnectionEvent event, const steady_clock::time_point due)
+        {
+            Delivery delivery;
+
+            delivery.due = due;
+            delivery.sequence = nextSequence++;
+            delivery.target = target;
+            delivery.connection = handle;
+            delivery.event = event;
+
+            inboxMap[target].eventQueue.push(std::move(delivery));
+        }
+
+        void AccumulateRate(Endpoint& endpoint, const steady_clock::time_point now, const size_t outBytes, const size_t inBytes)
+        {
+            if (const auto elapsed = now - endpoint.windowStart; elapsed >= RateWindow)
+            {
+                const double elapsedSeconds = duration<double>(elapsed).count();
+
+                endpoint.outBytesPerSecond = static_cast<float>(static_cast<double>(endpoint.windowOutBytes) / elapsedSeconds);
+                endpoint.inBytesPerSecond = static_cast<float>(static_cast<double>(endpoint.windowInBytes) / elapsedSeconds);
+                endpoint.windowOutBytes = 0;
+                endpoint.windowInBytes = 0;
+                endpoint.windowStart = now;
+            }
+
+            endpoint.windowOutBytes += outBytes;
+            endpoint.windowInBytes += inBytes;
+        }
+
+        steady_clock::duration SampleJitter()
+        {
+            if (settings.jitter.count() <= 0)
+                return steady_clock::duration::zero();
+
+            return duration_cast<steady_clock::duration>(microseconds(std::uniform_int_distribution<int64_t>(0, settings.jitter.count())(random)));
+        }
+
+        bool SampleLoss()
+        {
+            return settings.lossRate > 0.0f && std::uniform_real_distribution<float>(0.0f, 1.0f)(random) < settings.lossRate;
+        }
+
+        LoopbackSettings settings;
+        std::mt19937_64 random;
+
+        std::optional<steady_clock::time_point> manualTime;
+
+        HSteamNetConnection nextHandle = 1;
+        uint64_t nextSequence = 0;
+
+        std::unordered_map<uint16_t, LoopbackTransport*> listenerMap;
+        std::unordered_map<HSteamNetConnection, Endpoint> endpointMap;
+        std::unordered_map<LoopbackTransport*, Inbox> inboxMap;
+
+        mutable std::mutex mutex;
+
+    };
+
+    class LoopbackTransport final : public Transport
+    {
+
+    public:
+
+        explicit LoopbackTransport(std::shared_ptr<LoopbackNetwork> network) : network(std::move(network)) { }
+
+        LoopbackTransport(const LoopbackTransport&) = delete;
+        LoopbackTransport(LoopbackTransport&&) = delete;
+        LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+        LoopbackTransport& operator=(LoopbackTransport&&) = delete;
+
+        ~LoopbackTransport() override
+        {
+            network->Unregister(this);
+        }
+
+        bool Listen(const uint16_t port) override
+        {
+            network->Register(this, port);
+
+            return true;
+        }
+
+        HSteamNetConnection Connect(const std::string&, const uint16_t port) override
+        {
+            return network->Connect(this, port);
+        }
+
+        void Close(const HSteamNetConnection connection) override
+        {
+            network->Close(connection);
+        }
+
+        void Send(std::vector<TransportFrame>& frameList) override
+        {
+            network->Send(frameList);
+        }
+
+        void Receive(const ReceiveCallback& callback) override
+        {
+            network->Drain(this, true, [this](const HSteamNetConnection connection, const ConnectionEvent event) { RaiseEvent(connection, event); }, callback);
+        }
+
+        void RunCallbacks() override
+        {
+            network->Drain(this, false, [this](const HSteamNetConnection connection, const ConnectionEvent event) { RaiseEvent(connection, event); }, { });
+        }
+
+        [[nodiscard]]
+        ConnectionState GetConnectionState(const HSteamNetConnection connection) const override
+        {
+            return network->GetState(connection);
+        }
+
+        bool GetConnectionStatus(const HSteamNetConnection connection, ConnectionStatus& outStatus) const override
+        {
+            return network->GetStatus(connection, outStatus);
+        }
+
+        [[nodiscard]]
+        const std::shared_ptr<LoopbackNetwork>& GetNetwork() const
+        {
+            return network;
+        }
+
+    private:
+
+        std::shared_ptr<LoopbackNetwork> network;
+
+    };
+
+    inline void LoopbackNetwork::Drain(LoopbackTransport* target, const bool includeFrames, const Transport::EventCallback& eventCallback, const Transport::ReceiveCallback& receiveCallback)
+    {
+        std::vector<Delivery> eventList;
+        std::vector<Delivery> frameList;
+
+        {
+            std::lock_guard lock(mutex);
+
+            const auto now = GetTime();
+
+            auto& [eventQueue, frameQueue] = inboxMap[target];
+
+            while (!eventQueue.empty() && eventQueue.top().due <= now)
+            {
+                auto delivery = eventQueue.top();
+                eventQueue.pop();
+
+                const auto iterator = endpointMap.find(delivery.connection);
+
+                if (iterator == endpointMap.end())
+                    continue;
+
+                auto& endpoint = iterator->second;
+
+                if (delivery.event == Transport::ConnectionEvent::Connected)
+                {
+                    if (endpoint.state != Transport::ConnectionState::Connecting)
+                        continue;
+
+                    endpoint.state = Transport::ConnectionState::Connected;
+                }
+                else if (delivery.event == Transport::ConnectionEvent::Closed)
+                    endpoint.state = Transport::ConnectionState::Closed;
+
+                eventList.push_back(std::move(delivery));
+            }
+
+            while (includeFrames && !frameQueue.empty() && frameQueue.top().due <= now)
+            {
+                auto delivery = frameQueue.top();
+                frameQueue.pop();
+
+                const auto iterator = endpointMap.find(delivery.connection);
+
+                if (iterator == endpointMap.end() || iterator->second.state == Transport::ConnectionState::Closed)
+                    continue;
+
+                auto& endpoint = iterator->second;
+
+                const auto size = static_cast<int>(delivery.buffer->size());
+
+                if (const auto source = endpointMap.find(endpoint.remote); source != endpointMap.end())
+                    (delivery.reliable ? source->second.pendingReliableBytes : source->second.pendingUnreliableBytes) -= size;
+
+                AccumulateRate(endpoint, now, 0, static_cast<size_t>(size));
+
+                frameList.push_back(std::move(delivery));
+            }
+        }
+
+        for (const auto& delivery : eventList)
+            eventCallback(delivery.connection, delivery.event);
+
+        for (const auto& delivery : frameList)
+            receiveCallback(delivery.connection, delivery.buffer->data(), delivery.buffer->size(), delivery.reliable);
+    }
+}
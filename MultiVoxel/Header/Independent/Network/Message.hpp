@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 #include <cstring>
+#include "Independent/Network/Varint.hpp"
 
 namespace MultiVoxel::Independent::Network
 {
@@ -18,6 +19,7 @@ namespace MultiVoxel::Independent::Network
             Snapshot = 2,
             InputCommand = 3,
             ChatText = 4,
+            CompressedCustom = 254,
             Custom = 255
         };
 
@@ -50,6 +52,20 @@ namespace MultiVoxel::Independent::Network
                 std::memcpy(out.data() + 1, buffer.data(), buffer.size());
         }
 
+        void AppendFramed(std::vector<uint8_t>& out) const
+        {
+            Varint::Write(out, buffer.size() + 1);
+
+            out.push_back(static_cast<uint8_t>(type));
+            out.insert(out.end(), buffer.begin(), buffer.end());
+        }
+
+        [[nodiscard]]
+        size_t GetFramedSize() const
+        {
+            return Varint::SizeOf(buffer.size() + 1) + buffer.size() + 1;
+        }
+
         static Message Create(const Type type, const void* payload, const size_t size, const bool reliable = true)
         {
             Message result = { };
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <steam/isteamnetworkingutils.h>
+#include <steam/steamnetworkingtypes.h>
+
+namespace MultiVoxel::Independent::Network
+{
+    class MessageBufferPool final
+    {
+
+    public:
+
+        using Buffer = std::vector<uint8_t>;
+
+        static constexpr size_t MaximumPooledBuffers = 64;
+        static constexpr size_t MaximumPooledCapacity = 1024 * 1024;
+
+        static std::unique_ptr<Buffer> Acquire()
+        {
+            std::lock_guard lock(GetMutex());
+
+            auto& freeList = GetFreeList();
+
+            if (freeList.empty())
+                return std::make_unique<Buffer>();
+
+            auto result = std::move(freeList.back());
+            freeList.pop_back();
+
+            return result;
+        }
+
+        static void Release(std::unique_ptr<Buffer> buffer)
+        {
+            if (!buffer || buffer->capacity() > MaximumPooledCapacity)
+                return;
+
+            buffer->clear();
+
+            std::lock_guard lock(GetMutex());
+
+            if (auto& freeList = GetFreeList(); freeList.size() < MaximumPooledBuffers)
+                freeList.push_back(std::move(buffer));
+        }
+
+        static SteamNetworkingMessage_t* Wrap(std::unique_ptr<Buffer> buffer, const HSteamNetConnection connection, const int flags, const uint16 lane)
+        {
+            SteamNetworkingMessage_t* result = SteamNetworkingUtils()->AllocateMessage(0);
+
+            result->m_pData = buffer->data();
+            result->m_cbSize = static_cast<int>(buffer->size());
+            result->m_conn = connection;
+            result->m_nFlags = flags;
+            result->m_idxLane = lane;
+            result->m_nUserData = reinterpret_cast<int64>(buffer.release());
+            result->m_pfnFreeData = &MessageBufferPool::OnMessageFreed;
+
+            return result;
+        }
+
+    private:
+
+        MessageBufferPool() = default;
+
+        static void OnMessageFreed(SteamNetworkingMessage_t* message)
+        {
+            Release(std::unique_ptr<Buffer>(reinterpret_cast<Buffer*>(message->m_nUserData)));
+        }
+
+        static std::vector<std::unique_ptr<Buffer>>& GetFreeList()
+        {
+            static std::vector<std::unique_ptr<Buffer>> freeList;
+
+            return freeList;
+        }
+
+        static std::mutex& GetMutex()
+        {
+            static std::mutex mutex;
+
+            return mutex;
+        }
+    };
+}
\ No newline at end of file
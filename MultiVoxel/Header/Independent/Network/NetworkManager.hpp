@@ -1,15 +1,26 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
 #include <mutex>
-#include <steam/isteamnetworkingutils.h>
+#include <thread>
+#include <unordered_map>
 #include <steam/steamnetworkingtypes.h>
 #include "Independent/Network/Message.hpp"
 #include "Independent/Network/MessageDispatcher.hpp"
+#include "Independent/Network/NetworkStatistics.hpp"
 #include "Independent/Network/PeerConnection.hpp"
+#include "Independent/Network/SocketTransport.hpp"
+#include "Independent/Network/Transport.hpp"
+#include "Independent/Thread/SpscRingBuffer.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Thread;
 
 namespace MultiVoxel::Independent::Network
 {
@@ -18,47 +29,30 @@ namespace MultiVoxel::Independent::Network
 
     public:
 
+        static constexpr microseconds NetworkThreadInterval{ 1000 };
+
         ~NetworkManager()
         {
             Shutdown();
-            GameNetworkingSockets_Kill();
         }
 
         void PollEvents()
         {
-            sockets->RunCallbacks();
+            if (!transport)
+                return;
 
-            SteamNetworkingMessage_t* netMsg = nullptr;
+            if (!IsNetworkThreadRunning())
+                Pump();
 
-            while (sockets->ReceiveMessagesOnPollGroup(pollGroup, &netMsg, 1) > 0)
-            {
-                PeerConnection* target = nullptr;
-                {
-                    std::lock_guard lock(peerListMutex);
-                    for (const auto& peer : peerList)
-                    {
-                        if (peer->GetHandle() == netMsg->m_conn)
-                        {
-                            target = peer.get();
-                            break;
-                        }
-                    }
-                }
+            PeerEvent event;
 
-                if (target)
-                    target->EnqueueReceived(netMsg);
-            }
+            while (eventRing.TryPop(event))
+                OnPeerEvent(event);
 
-            std::vector<PeerConnection*> peers;
+            for (size_t index = 0; index < peerList.size(); ++index)
             {
-                std::lock_guard lock(peerListMutex);
-                peers.reserve(peerList.size());
-                for (const auto& peer : peerList)
-                    peers.push_back(peer.get());
-            }
+                const auto peer = peerList[index];
 
-            for (auto* peer : peers)
-            {
                 Message msg;
 
                 while (peer->Receive(msg))
@@ -68,112 +62,189 @@ namespace MultiVoxel::Independent::Network
 
         void Broadcast(const Message& message) const
         {
-            std::vector<PeerConnection*> peers;
+            for (const auto& peer : peerList)
+                peer->Send(message);
+        }
+
+        std::vector<HSteamNetConnection> GetPeerHandles() const
+        {
+            std::vector<HSteamNetConnection> result;
+            result.reserve(peerList.size());
+
+            for (const auto& peer : peerList)
+                result.push_back(peer->GetHandle());
+
+            return result;
+        }
+
+        std::vector<PeerStatus> GetPeerStatuses() const
+        {
+            std::vector<PeerStatus> result;
+
+            if (!transport)
+                return result;
+
+            for (const auto handle : GetPeerHandles())
             {
-                std::lock_guard lock(peerListMutex);
-                peers.reserve(peerList.size());
-                for (const auto& peer : peerList)
-                    peers.push_back(peer.get());
+                PeerStatus peer;
+
+                peer.handle = handle;
+
+                if (transport->GetConnectionStatus(handle, peer.status))
+                    result.push_back(peer);
             }
 
-            for (auto* peer : peers)
-                peer->Send(message);
+            return result;
         }
 
-        void FlushOutgoing() const
+        std::shared_ptr<PeerConnection> FindPeer(const HSteamNetConnection handle) const
         {
-            sockets->RunCallbacks();
+            for (const auto& peer : peerList)
+            {
+                if (peer->GetHandle() == handle)
+                    return peer;
+            }
+
+            return nullptr;
         }
 
-        bool StartServer(const uint16_t port)
+        bool SendTo(const HSteamNetConnection handle, const Message& message) const
+        {
+            for (const auto& peer : peerList)
+            {
+                if (peer->GetHandle() == handle)
+                {
+                    peer->Send(message);
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void FlushOutgoing()
         {
-            SteamNetworkingIPAddr address = { };
+            if (!transport)
+                return;
+
+            for (const auto& peer : peerList)
+                peer->RetryOutbound();
 
-            address.Clear();
-            address.SetIPv4(0, port);
+            while (!attachOverflow.empty() && attachRing.TryPush(std::move(attachOverflow.front())))
+                attachOverflow.pop_front();
 
-            SteamNetworkingConfigValue_t opt = {};
+            if (!IsNetworkThreadRunning())
+                Pump();
+        }
+
+        void StartNetworkThread()
+        {
+            if (networkThread.joinable() || !GetTransport())
+                return;
 
-            opt.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged, (void*)OnSteamNetConnectionStatusChanged);
+            networkThreadRunning.store(true, std::memory_order_release);
 
-            listenerSocket = sockets->CreateListenSocketIP(address, 1, &opt);
+            networkThread = std::thread([this]()
+            {
+                while (networkThreadRunning.load(std::memory_order_acquire))
+                {
+                    Pump();
 
-            return listenerSocket != k_HSteamListenSocket_Invalid;
+                    std::this_thread::sleep_for(NetworkThreadInterval);
+                }
+            });
         }
 
-        bool ConnectToServer(const std::string& addressString, uint16_t port)
+        void StopNetworkThread()
         {
-            SteamNetworkingIPAddr address = { };
+            networkThreadRunning.store(false, std::memory_order_release);
 
-            SteamNetworkingIPAddr_ParseString(&address, addressString.c_str());
+            if (networkThread.joinable())
+                networkThread.join();
+        }
 
-            address.m_port = port;
+        [[nodiscard]]
+        bool IsNetworkThreadRunning() const
+        {
+            return networkThread.joinable();
+        }
 
-            SteamNetworkingConfigValue_t opt = {};
+        bool StartServer(const uint16_t port)
+        {
+            return GetTransport() && transport->Listen(port);
+        }
 
-            opt.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged, (void*)OnSteamNetConnectionStatusChanged);
+        bool ConnectToServer(const std::string& addressString, uint16_t port, HSteamNetConnection* outConnection = nullptr)
+        {
+            if (!GetTransport())
+                return false;
 
-            const HSteamNetConnection connection = sockets->ConnectByIPAddress(address, 1, &opt);
+            const HSteamNetConnection connection = transport->Connect(addressString, port);
 
             if (connection == k_HSteamNetConnection_Invalid)
                 return false;
 
-            sockets->SetConnectionPollGroup(connection, pollGroup);
+            std::shared_ptr<PeerConnection> peer = PeerConnection::Create(connection, transport.get());
 
-            {
-                std::lock_guard lock(peerListMutex);
-                peerList.push_back(PeerConnection::Create(connection, sockets, pollGroup));
-            }
+            peerList.push_back(peer);
+
+            if (!attachOverflow.empty() || !attachRing.TryPush(std::move(peer)))
+                attachOverflow.push_back(std::move(peer));
+
+            if (outConnection)
+                *outConnection = connection;
 
             return true;
         }
 
-        MessageDispatcher& GetDispatcher()
+        void SetTransport(std::unique_ptr<Transport> value)
         {
-            return messageDispatcher;
+            StopNetworkThread();
+            ClearPeers();
+
+            transport = std::move(value);
+
+            if (transport)
+                transport->SetEventCallback([this](const HSteamNetConnection connection, const Transport::ConnectionEvent event) { OnConnectionEvent(connection, event); });
         }
 
-        ISteamNetworkingSockets* GetSockets() const
+        Transport* GetTransport()
         {
-            return sockets;
+            if (!transport)
+                SetTransport(SocketTransport::Create());
+
+            return transport.get();
         }
 
-        HSteamNetPollGroup& GetPollGroup()
+        MessageDispatcher& GetDispatcher()
         {
-            return pollGroup;
+            return messageDispatcher;
         }
 
-        void AddOnPlayerConnectedCallback(const std::function<void()>& callback)
+        void AddOnPlayerConnectedCallback(const std::function<void(HSteamNetConnection)>& callback)
         {
             playerConnectedCallbackList.push_back(callback);
         }
 
-        static NetworkManager& GetInstance()
+        void AddOnPlayerDisconnectedCallback(const std::function<void(HSteamNetConnection)>& callback)
         {
-            std::call_once(initializationFlag, [&]()
-            {
-                instance = [&]() -> std::unique_ptr<NetworkManager>
-                {
-                    auto result = std::unique_ptr<NetworkManager>(new NetworkManager());
-
-                    SteamDatagramErrMsg errorMessage;
-
-                    if (!GameNetworkingSockets_Init(nullptr, errorMessage))
-                    {
-                        std::cerr << "GNS_Init failed: " << errorMessage << "\n";
+            playerDisconnectedCallbackList.push_back(callback);
+        }
 
-                        return nullptr;
-                    }
+        static std::unique_ptr<NetworkManager> Create(std::unique_ptr<Transport> transport)
+        {
+            auto result = std::unique_ptr<NetworkManager>(new NetworkManager());
 
-                    if (!result->Initialize())
-                    {
-                        result->Shutdown();
+            result->SetTransport(std::move(transport));
 
-                        return nullptr;
-                    }
+            return result;
+        }
 
-                    return result;
-                }();
+        static NetworkManager& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<NetworkManager>(new NetworkManager());
             });
 
             return *instance;
@@ -183,106 +254,143 @@ namespace MultiVoxel::Independent::Network
 
         NetworkManager() = default;
 
-        bool Initialize()
+        struct PeerEvent
         {
-            sockets = SteamNetworkingSockets();
-            utilities = SteamNetworkingUtils();
-            pollGroup = sockets->CreatePollGroup();
-            
-            utilities->SetDebugOutputFunction(k_ESteamNetworkingSocketsDebugOutputType_Verbose, &NetworkManager::OnDebugOutput);
+            HSteamNetConnection connection = k_HSteamNetConnection_Invalid;
+            Transport::ConnectionEvent event = Transport::ConnectionEvent::Closed;
 
-            return pollGroup != 0;
-        }
+            std::shared_ptr<PeerConnection> peer;
+        };
+
+        static constexpr size_t EventQueueCapacity = 1024;
 
         void Shutdown()
         {
-            if (listenerSocket != k_HSteamListenSocket_Invalid)
-            {
-                sockets->CloseListenSocket(listenerSocket);
-                listenerSocket = k_HSteamListenSocket_Invalid;
-            }
+            StopNetworkThread();
+            ClearPeers();
 
-            if (pollGroup)
-            {
-                sockets->DestroyPollGroup(pollGroup);
-                pollGroup = 0;
-            }
-
-            {
-                std::lock_guard lock(peerListMutex);
-                peerList.clear();
-            }
+            transport.reset();
         }
 
-        static void OnDebugOutput(ESteamNetworkingSocketsDebugOutputType eType, const char* message)
+        void ClearPeers()
         {
-            std::lock_guard lock(logMutex);
+            PeerEvent event;
+            std::shared_ptr<PeerConnection> peer;
 
-            switch (eType)
-            {
-                case k_ESteamNetworkingSocketsDebugOutputType_None:      break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Bug:       std::cerr << "[GNS][BUG] ";       break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Error:     std::cerr << "[GNS][ERROR] ";     break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Important: std::cerr << "[GNS][IMPORTANT] "; break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Warning:   std::cerr << "[GNS][WARNING] ";   break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Msg:       std::cerr << "[GNS][INFO] ";      break;
-                case k_ESteamNetworkingSocketsDebugOutputType_Verbose:   std::cerr << "[GNS][DEBUG] ";     break;
-
-                default:
-                    break;
-            }
+            while (eventRing.TryPop(event)) { }
+            while (attachRing.TryPop(peer)) { }
 
-            std::cerr << message << "\n";
+            eventOverflow.clear();
+            attachOverflow.clear();
+            networkPeerMap.clear();
+            peerList.clear();
         }
-        
-        static void OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t* info)
+
+        void Pump()
         {
-            if (info->m_info.m_eState == k_ESteamNetworkingConnectionState_Connecting && info->m_info.m_hListenSocket != k_HSteamListenSocket_Invalid)
+            std::shared_ptr<PeerConnection> attached;
+
+            while (attachRing.TryPop(attached))
+                networkPeerMap[attached->GetHandle()] = std::move(attached);
+
+            transport->RunCallbacks();
+
+            transport->Receive([&](const HSteamNetConnection connection, const uint8_t* data, const size_t size, const bool reliable)
             {
-                if (instance->sockets->AcceptConnection(info->m_hConn) != k_EResultOK)
+                if (const auto iterator = networkPeerMap.find(connection); iterator != networkPeerMap.end())
+                    iterator->second->EnqueueReceived(data, size, reliable);
+            });
+
+            for (auto iterator = networkPeerMap.begin(); iterator != networkPeerMap.end(); )
+            {
+                const auto& [handle, peer] = *iterator;
+
+                if (peer->IsOverflowed())
                 {
-                    std::cerr << "Failed to accept connection (handle=" << info->m_hConn << ")\n";
-                    instance->sockets->CloseConnection(info->m_hConn, 0, nullptr, false);
+                    peer->Close();
+                    PostEvent({ handle, Transport::ConnectionEvent::Closed, nullptr });
 
-                    return;
+                    iterator = networkPeerMap.erase(iterator);
+                    continue;
                 }
 
-                if (instance->sockets->SetConnectionPollGroup(info->m_hConn, instance->pollGroup) != k_EResultOK)
+                peer->RetryInbound();
+                peer->CollectOutgoing(outgoingList);
+
+                ++iterator;
+            }
+
+            if (!outgoingList.empty())
+                transport->Send(outgoingList);
+
+            outgoingList.clear();
+
+            while (!eventOverflow.empty() && eventRing.TryPush(std::move(eventOverflow.front())))
+                eventOverflow.pop_front();
+        }
+
+        void PostEvent(PeerEvent event)
+        {
+            if (!eventOverflow.empty() || !eventRing.TryPush(std::move(event)))
+                eventOverflow.push_back(std::move(event));
+        }
+
+        void OnConnectionEvent(const HSteamNetConnection connection, const Transport::ConnectionEvent event)
+        {
+            switch (event)
+            {
+
+            case Transport::ConnectionEvent::Accepted:
                 {
-                    std::cerr << "Failed to set poll group for connection (handle=" << info->m_hConn << ")\n";
-                    instance->sockets->CloseConnection(info->m_hConn, 0, nullptr, false);
+                    std::shared_ptr<PeerConnection> peer = PeerConnection::Create(connection, transport.get());
+
+                    networkPeerMap[connection] = peer;
 
-                    return;
+                    PostEvent({ connection, event, std::move(peer) });
                 }
+                break;
 
+            case Transport::ConnectionEvent::Closed:
+                if (const auto iterator = networkPeerMap.find(connection); iterator != networkPeerMap.end())
                 {
-                    std::lock_guard lock(instance->peerListMutex);
-                    instance->peerList.push_back(PeerConnection::Create(info->m_hConn, instance->sockets, instance->pollGroup));
+                    iterator->second->Close();
+                    networkPeerMap.erase(iterator);
                 }
 
-                std::cout << "New client connected (handle=" << info->m_hConn << ")\n";
+                PostEvent({ connection, event, nullptr });
+                break;
+
+            default:
+                PostEvent({ connection, event, nullptr });
+                break;
             }
-            else switch (info->m_info.m_eState)
+        }
+
+        void OnPeerEvent(const PeerEvent& event)
+        {
+            switch (event.event)
             {
 
-            case k_ESteamNetworkingConnectionState_Connected:
-                std::cout << "Connection fully established: (handle=" << info->m_hConn << ")\n";
+            case Transport::ConnectionEvent::Accepted:
+                peerList.push_back(event.peer);
+                std::cout << "New client connected (handle=" << event.connection << ")\n";
+                break;
+
+            case Transport::ConnectionEvent::Connected:
+                std::cout << "Connection fully established: (handle=" << event.connection << ")\n";
 
-                for (auto& callback : instance->playerConnectedCallbackList)
-                    callback();
+                for (auto& callback : playerConnectedCallbackList)
+                    callback(event.connection);
 
                 break;
 
-            case k_ESteamNetworkingConnectionState_ClosedByPeer:
-            case k_ESteamNetworkingConnectionState_ProblemDetectedLocally:
-                {
-                    std::lock_guard lock(instance->peerListMutex);
-                    std::erase_if(
-                        instance->peerList,
-                        [&](auto& p) { return p->GetHandle() == info->m_hConn; }
-                    );
-                }
-                std::cout << "Client disconnected (handle=" << info->m_hConn << ")\n";
+            case Transport::ConnectionEvent::Closed:
+                std::erase_if(peerList, [&](const auto& peer) { return peer->GetHandle() == event.connection; });
+                std::cout << "Client disconnected (handle=" << event.connection << ")\n";
+
+                for (auto& callback : playerDisconnectedCallbackList)
+                    callback(event.connection);
+
                 break;
 
             default:
@@ -290,16 +398,23 @@ namespace MultiVoxel::Independent::Network
             }
         }
 
-        static std::mutex logMutex;
+        std::unique_ptr<Transport> transport;
+
+        std::vector<std::function<void(HSteamNetConnection)>> playerConnectedCallbackList;
+        std::vector<std::function<void(HSteamNetConnection)>> playerDisconnectedCallbackList;
+
+        std::vector<std::shared_ptr<PeerConnection>> peerList;
+        std::deque<std::shared_ptr<PeerConnection>> attachOverflow;
+
+        std::unordered_map<HSteamNetConnection, std::shared_ptr<PeerConnection>> networkPeerMap;
+        std::deque<PeerEvent> eventOverflow;
+        std::vector<TransportFrame> outgoingList;
 
-        ISteamNetworkingSockets* sockets = nullptr;
-        ISteamNetworkingUtils* utilities = nullptr;
-        HSteamNetPollGroup pollGroup = 0;
-        HSteamListenSocket listenerSocket = k_HSteamListenSocket_Invalid;
+        SpscRingBuffer<PeerEvent, EventQueueCapacity> eventRing;
+        SpscRingBuffer<std::shared_ptr<PeerConnection>, EventQueueCapacity> attachRing;
 
-        std::vector<std::function<void()>> playerConnectedCallbackList;
-        std::mutex peerListMutex;
-        std::vector<std::unique_ptr<PeerConnection>> peerList;
+        std::thread networkThread;
+        std::atomic<bool> networkThreadRunning = false;
 
         MessageDispatcher messageDispatcher;
 
@@ -307,8 +422,6 @@ namespace MultiVoxel::Independent::Network
         static std::unique_ptr<NetworkManager> instance;
 
     };
-    
-    std::mutex NetworkManager::logMutex;
 
     std::once_flag NetworkManager::initializationFlag;
     std::unique_ptr<NetworkManager> NetworkManager::instance;
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Independent/Network/Transport.hpp"
+
+using namespace std::chrono;
+
+namespace MultiVoxel::Independent::Network
+{
+    struct PeerStatus
+    {
+        HSteamNetConnection handle = k_HSteamNetConnection_Invalid;
+
+        ConnectionStatus status;
+    };
+
+    class NetworkStatistics final
+    {
+
+    public:
+
+        enum class Category : uint8_t
+        {
+            Channel,
+            Rpc,
+            Component
+        };
+
+        struct TrafficCounter
+        {
+            uint64_t sentMessageCount = 0;
+            uint64_t sentByteCount = 0;
+            uint64_t receivedMessageCount = 0;
+            uint64_t receivedByteCount = 0;
+        };
+
+        using CounterMap = std::map<std::string, TrafficCounter>;
+
+        NetworkStatistics(const NetworkStatistics&) = delete;
+        NetworkStatistics(NetworkStatistics&&) = delete;
+        NetworkStatistics& operator=(const NetworkStatistics&) = delete;
+        NetworkStatistics& operator=(NetworkStatistics&&) = delete;
+
+        void RecordSent(const Category category, const std::string& key, const size_t byteCount, const size_t messageCount = 1)
+        {
+            if (messageCount == 0)
+                return;
+
+            std::lock_guard lock(mutex);
+
+            auto& counter = counterMaps[static_cast<size_t>(category)][key];
+
+            counter.sentMessageCount += messageCount;
+            counter.sentByteCount += byteCount * messageCount;
+        }
+
+        void RecordReceived(const Category category, const std::string& key, const size_t byteCount)
+        {
+            std::lock_guard lock(mutex);
+
+            auto& counter = counterMaps[static_cast<size_t>(category)][key];
+
+            counter.receivedMessageCount++;
+            counter.receivedByteCount += byteCount;
+        }
+
+        [[nodiscard]]
+        CounterMap GetCounters(const Category category) const
+        {
+            std::lock_guard lock(mutex);
+
+            return counterMaps[static_cast<size_t>(category)];
+        }
+
+        void Reset()
+        {
+            std::lock_guard lock(mutex);
+
+            for (size_t index = 0; index < CategoryCount; ++index)
+            {
+                counterMaps[index].clear();
+                previousMaps[index].clear();
+            }
+        }
+
+        void PrintStatistics(std::ostream& stream, const std::vector<PeerStatus>& peerList) const
+        {
+            for (const auto& [handle, status] : peerList)
+            {
+                stream << "[Network] peer " << handle
+                       << ": ping=" << status.ping << "ms"
+                       << " loss=" << std::fixed << std::setprecision(1) << GetLossPercent(status) << "%"
+                       << " out=" << status.outBytesPerSecond / 1024.0f << "KiB/s"
+                       << " in=" << status.inBytesPerSecond / 1024.0f << "KiB/s"
+                       << " pending=" << status.pendingReliableBytes << "+" << status.pendingUnreliableBytes << "B"
+                       << " queue=" << status.queueTime << "us\n";
+            }
+
+            std::lock_guard lock(mutex);
+
+            for (size_t index = 0; index < CategoryCount; ++index)
+            {
+                for (const auto& [key, counter] : counterMaps[index])
+                {
+                    stream << "[Network] " << CategoryNames[index] << " " << key
+                           << ": sent=" << counter.sentMessageCount << "/" << counter.sentByteCount << "B"
+                           << " received=" << counter.receivedMessageCount << "/" << counter.receivedByteCount << "B\n";
+                }
+            }
+        }
+
+        void SetReportInterval(const seconds interval)
+        {
+            reportInterval = interval;
+        }
+
+        bool SetCsvPath(const std::filesystem::path& path)
+        {
+            std::lock_guard lock(mutex);
+
+            const bool isNew = !std::filesystem::exists(path) || std::filesystem::file_size(path) == 0;
+
+            csvStream.close();
+            csvStream.clear();
+            csvStream.open(path, std::ios::app);
+
+            if (!csvStream)
+            {
+                std::cerr << "Failed to open network statistics file '" << path.string() << "'.\n";
+                return false;
+            }
+
+            if (isNew)
+                csvStream << "seconds,kind,key,sent_messages,sent_bytes,received_messages,received_bytes,ping_ms,loss_percent,out_bytes_per_second,in_bytes_per_second,pending_reliable_bytes,pending_unreliable_bytes,queue_us\n";
+
+            return true;
+        }
+
+        [[nodiscard]]
+        bool IsReportDue() const
+        {
+            return reportInterval.count() > 0 && steady_clock::now() - lastReport >= reportInterval;
+        }
+
+        void Report(std::ostream& stream, const std::vector<PeerStatus>& peerList)
+        {
+            const auto now = steady_clock::now();
+
+            PrintStatistics(stream, peerList);
+
+            std::lock_guard lock(mutex);
+
+            if (csvStream.is_open())
+            {
+                WriteCsv(duration<double>(now - startTime).count(), duration<double>(now - lastReport).count(), peerList);
+                csvStream.flush();
+            }
+
+            for (size_t index = 0; index < CategoryCount; ++index)
+                previousMaps[index] = counterMaps[index];
+
+            lastReport = now;
+        }
+
+        static NetworkStatistics& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<NetworkStatistics>(new NetworkStatistics());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        static constexpr size_t CategoryCount = 3;
+        static constexpr std::array<const char*, CategoryCount> CategoryNames = { "channel", "rpc", "component" };
+
+        NetworkStatistics() = default;
+
+        static float GetLossPercent(const ConnectionStatus& status)
+        {
+            return status.quality < 0.0f ? 0.0f : (1.0f - status.quality) * 100.0f;
+        }
+
+        void WriteCsv(const double timestamp, const double windowSeconds, const std::vector<PeerStatus>& peerList)
+        {
+            csvStream << std::fixed << std::setprecision(3);
+
+            for (size_t index = 0; index < CategoryCount; ++index)
+            {
+                for (const auto& [key, counter] : counterMaps[index])
+                {
+                    const auto previous = previousMaps[index].find(key);
+                    const TrafficCounter base = previous != previousMaps[index].end() ? previous->second : TrafficCounter{ };
+
+                    csvStream << timestamp << "," << CategoryNames[index] << "," << key
+                              << "," << counter.sentMessageCount - base.sentMessageCount
+                              << "," << counter.sentByteCount - base.sentByteCount
+                              << "," << counter.receivedMessageCount - base.receivedMessageCount
+                              << "," << counter.receivedByteCount - base.receivedByteCount
+                              << ",,"
+                              << "," << static_cast<double>(counter.sentByteCount - base.sentByteCount) / windowSeconds
+                              << "," << static_cast<double>(counter.receivedByteCount - base.receivedByteCount) / windowSeconds
+                              << ",,,\n";
+                }
+            }
+
+            for (const auto& [handle, status] : peerList)
+            {
+                csvStream << timestamp << ",peer," << handle
+                          << ",,,,"
+                          << "," << status.ping
+                          << "," << GetLossPercent(status)
+                          << "," << status.outBytesPerSecond
+                          << "," << status.inBytesPerSecond
+                          << "," << status.pendingReliableBytes
+                          << "," << status.pendingUnreliableBytes
+                          << "," << status.queueTime << "\n";
+            }
+        }
+
+        mutable std::mutex mutex;
+
+        std::array<CounterMap, CategoryCount> counterMaps;
+        std::array<CounterMap, CategoryCount> previousMaps;
+
+        seconds reportInterval{ 60 };
+        steady_clock::time_point startTime = steady_clock::now();
+        steady_clock::time_point lastReport = startTime;
+
+        std::ofstream csvStream;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<NetworkStatistics> instance;
+
+    };
+
+    std::once_flag NetworkStatistics::initializationFlag;
+    std::unique_ptr<NetworkStatistics> NetworkStatistics::instance;
+}
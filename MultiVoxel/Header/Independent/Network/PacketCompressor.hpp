@@ -0,0 +1,252 @@
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "Independent/ECS/ComponentFactory.hpp"
+#include "Independent/Network/Message.hpp"
+#include "Independent/Network/WireArchive.hpp"
+#include "Independent/Utility/LzCodec.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::ECS;
+using namespace MultiVoxel::Independent::Utility;
+
+namespace MultiVoxel::Independent::Network
+{
+    class PacketCompressor final
+    {
+
+    public:
+
+        static constexpr size_t DefaultThreshold = 512;
+        static constexpr size_t MaximumDecompressedSize = 64 * 1024 * 1024;
+
+        struct ChannelStatistics
+        {
+            uint64_t compressedPacketCount = 0;
+            uint64_t skippedPacketCount = 0;
+            uint64_t decompressedPacketCount = 0;
+            uint64_t rawByteCount = 0;
+            uint64_t compressedByteCount = 0;
+
+            nanoseconds encodeTime{ 0 };
+            nanoseconds decodeTime{ 0 };
+
+            [[nodiscard]]
+            double GetRatio() const
+            {
+                return compressedByteCount ? static_cast<double>(rawByteCount) / static_cast<double>(compressedByteCount) : 1.0;
+            }
+        };
+
+        PacketCompressor(const PacketCompressor&) = delete;
+        PacketCompressor(PacketCompressor&&) = delete;
+        PacketCompressor& operator=(const PacketCompressor&) = delete;
+        PacketCompressor& operator=(PacketCompressor&&) = delete;
+
+        void SetThreshold(const size_t bytes)
+        {
+            threshold = bytes;
+        }
+
+        [[nodiscard]]
+        size_t GetThreshold() const
+        {
+            return threshold;
+        }
+
+        void SetEnabled(const bool value)
+        {
+            enabled = value;
+        }
+
+        [[nodiscard]]
+        bool IsEnabled() const
+        {
+            return enabled;
+        }
+
+        void SetDictionary(const std::string& channel, std::string dictionary)
+        {
+            dictionaryMap[channel] = std::move(dictionary);
+        }
+
+        Message Pack(const std::string& channel, const std::string& data)
+        {
+            packBuffer.clear();
+
+            WireOutputArchive archive(packBuffer);
+
+            if (enabled && data.size() >= threshold)
+            {
+                const auto start = steady_clock::now();
+
+                const auto& dictionary = GetDictionary(channel);
+
+                LzCodec::Compress(reinterpret_cast<const uint8_t*>(dictionary.data()), dictionary.size(), reinterpret_cast<const uint8_t*>(data.data()), data.size(), scratch);
+
+                auto& statistics = statisticsMap[channel];
+
+                statistics.encodeTime += steady_clock::now() - start;
+
+                if (scratch.size() < data.size())
+                {
+                    statistics.compressedPacketCount++;
+                    statistics.rawByteCount += data.size();
+                    statistics.compressedByteCount += scratch.size();
+
+                    archive(channel, static_cast<uint32_t>(data.size()));
+                    archive.WriteLengthPrefixed(scratch.data(), scratch.size());
+
+                    return Message::Create(Message::Type::CompressedCustom, packBuffer.data(), packBuffer.size(), true);
+                }
+
+                statistics.skippedPacketCount++;
+            }
+
+            archive(channel, data);
+
+            return Message::Create(Message::Type::Custom, packBuffer.data(), packBuffer.size(), true);
+        }
+
+        bool Unpack(const Message& message, std::string& outChannel, std::string& outData)
+        {
+            WireInputArchive archive(message.GetBuffer());
+
+            if (message.GetType() != Message::Type::CompressedCustom)
+            {
+                archive(outChannel, outData);
+                return true;
+            }
+
+            uint32_t originalSize;
+
+            archive(outChannel, originalSize);
+
+            const auto compressed = archive.ReadLengthPrefixed();
+
+            if (originalSize > MaximumDecompressedSize)
+            {
+                std::cerr << "Compressed packet on channel '" << outChannel << "' claims " << originalSize << " bytes, dropping it.\n";
+                return false;
+            }
+
+            const auto start = steady_clock::now();
+
+            const auto& dictionary = GetDictionary(outChannel);
+
+            if (!LzCodec::Decompress(reinterpret_cast<const uint8_t*>(dictionary.data()), dictionary.size(), compressed.data(), compressed.size(), originalSize, scratch))
+            {
+                std::cerr << "Failed to decompress packet on channel '" << outChannel << "'.\n";
+                return false;
+            }
+
+            outData.assign(scratch.begin(), scratch.end());
+
+            auto& statistics = statisticsMap[outChannel];
+
+            statistics.decompressedPacketCount++;
+            statistics.decodeTime += steady_clock::now() - start;
+
+            return true;
+        }
+
+        [[nodiscard]]
+        const std::unordered_map<std::string, ChannelStatistics>& GetStatistics() const
+        {
+            return statisticsMap;
+        }
+
+        void PrintStatistics(std::ostream& stream) const
+        {
+            const std::map<std::string, ChannelStatistics> sorted(statisticsMap.begin(), statisticsMap.end());
+
+            for (const auto& [channel, statistics] : sorted)
+            {
+                const auto encodeCount = statistics.compressedPacketCount + statistics.skippedPacketCount;
+
+                stream << "[Compression] " << channel
+                       << ": packets=" << statistics.compressedPacketCount
+                       << " skipped=" << statistics.skippedPacketCount
+                       << " raw=" << statistics.rawByteCount
+                       << " compressed=" << statistics.compressedByteCount
+                       << " ratio=" << std::fixed << std::setprecision(2) << statistics.GetRatio()
+                       << " encode=" << (encodeCount ? duration_cast<microseconds>(statistics.encodeTime).count() / static_cast<int64_t>(encodeCount) : 0) << "us/packet"
+                       << " decode=" << (statistics.decompressedPacketCount ? duration_cast<microseconds>(statistics.decodeTime).count() / static_cast<int64_t>(statistics.decompressedPacketCount) : 0) << "us/packet\n";
+            }
+        }
+
+        void ReportIfDue(std::ostream& stream)
+        {
+            if (reportInterval.count() <= 0 || statisticsMap.empty())
+                return;
+
+            if (const auto now = steady_clock::now(); now - lastReport >= reportInterval)
+            {
+                PrintStatistics(stream);
+                lastReport = now;
+            }
+        }
+
+        void SetReportInterval(const seconds interval)
+        {
+            reportInterval = interval;
+        }
+
+        static PacketCompressor& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<PacketCompressor>(new PacketCompressor());
+
+                std::string componentDictionary;
+
+                for (const auto& typeName : ComponentFactory::GetRegisteredTypeNames())
+                    componentDictionary += typeName;
+
+                instance->SetDictionary(SyncChannelName, componentDictionary);
+                instance->SetDictionary("RpcChannel", componentDictionary);
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        PacketCompressor() = default;
+
+        const std::string& GetDictionary(const std::string& channel) const
+        {
+            static const std::string empty;
+
+            const auto iterator = dictionaryMap.find(channel);
+
+            return iterator != dictionaryMap.end() ? iterator->second : empty;
+        }
+
+        bool enabled = true;
+        size_t threshold = DefaultThreshold;
+
+        seconds reportInterval{ 60 };
+        steady_clock::time_point lastReport = steady_clock::now();
+
+        std::vector<uint8_t> scratch;
+        std::string packBuffer;
+
+        std::unordered_map<std::string, std::string> dictionaryMap;
+        std::unordered_map<std::string, ChannelStatistics> statisticsMap;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<PacketCompressor> instance;
+
+    };
+
+    std::once_flag PacketCompressor::initializationFlag;
+    std::unique_ptr<PacketCompressor> PacketCompressor::instance;
+}
\ No newline at end of file
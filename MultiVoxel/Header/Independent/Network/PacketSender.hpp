@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <steam/steamnetworkingtypes.h>
 #include "Independent/Utility/IndexedString.hpp"
 
 using namespace MultiVoxel::Independent::Utility;
@@ -14,9 +15,16 @@ namespace MultiVoxel::Independent::Network
 
         virtual ~PacketSender() = default;
 
+        virtual void BeginTick() { }
+
         virtual bool SendPacket(std::string&, std::string&) = 0;
 
-        virtual void Reload() = 0;
+        virtual bool SendPacketTo(HSteamNetConnection, std::string&, std::string&)
+        {
+            return false;
+        }
+
+        virtual void Reload(HSteamNetConnection peer) = 0;
 
         bool sent = false;
     };
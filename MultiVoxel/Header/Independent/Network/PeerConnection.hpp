@@ -1,10 +1,18 @@
 #pragma once
 
-#include <mutex>
-#include <queue>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <memory>
 #include <vector>
-#include <steam/steamnetworkingsockets.h>
 #include "Independent/Network/Message.hpp"
+#include "Independent/Network/MessageBufferPool.hpp"
+#include "Independent/Network/Transport.hpp"
+#include "Independent/Network/Varint.hpp"
+#include "Independent/Thread/SpscRingBuffer.hpp"
+
+using namespace MultiVoxel::Independent::Thread;
 
 namespace MultiVoxel::Independent::Network
 {
@@ -13,10 +21,28 @@ namespace MultiVoxel::Independent::Network
 
     public:
 
+        enum class Lane : uint16_t
+        {
+            Reliable = 0,
+            Unreliable = 1
+        };
+
+        static constexpr int LaneCount = 2;
+
+        static constexpr size_t MaximumReliableFrameSize = 256 * 1024;
+        static constexpr size_t MaximumUnreliableFrameSize = 1200;
+        static constexpr size_t QueueCapacity = 4096;
+        static constexpr size_t MaximumOverflowSize = 8 * 1024 * 1024;
+
         ~PeerConnection()
         {
-            if (connection != k_HSteamNetConnection_Invalid)
-                sockets->CloseConnection(connection, 0, nullptr, false);
+            Close();
+        }
+
+        void Close()
+        {
+            if (connection != k_HSteamNetConnection_Invalid && !closed.exchange(true, std::memory_order_acq_rel))
+                transport->Close(connection);
         }
 
         [[nodiscard]]
@@ -25,64 +51,195 @@ namespace MultiVoxel::Independent::Network
             return connection;
         }
 
-        void Send(const Message& msg) const
+        void Send(const Message& msg)
         {
-            std::vector<uint8_t> buf;
+            if (IsOverflowed())
+                return;
+
+            Message copy = msg;
 
-            msg.Serialize(buf);
+            if (outboundOverflow.empty() && outboundRing.TryPush(std::move(copy)))
+                return;
 
-            sockets->SendMessageToConnection(connection, buf.data(), buf.size(), msg.IsReliable() ? k_nSteamNetworkingSend_Reliable : k_nSteamNetworkingSend_Unreliable, nullptr);
+            if (!copy.IsReliable())
+                return;
+
+            outboundOverflowSize += copy.GetFramedSize();
+            outboundOverflow.push_back(std::move(copy));
+
+            if (outboundOverflowSize > MaximumOverflowSize)
+                MarkOverflowed("outbound");
         }
 
-        void EnqueueReceived(SteamNetworkingMessage_t* incoming)  
-        {  
-            const auto* data = static_cast<const uint8_t*>(incoming->m_pData);
+        void RetryOutbound()
+        {
+            RetryOverflow(outboundRing, outboundOverflow, outboundOverflowSize);
+        }
 
-            if (const size_t bytes = incoming->m_cbSize; bytes >= 1)
+        bool Receive(Message& outMsg)
+        {
+            return inboundRing.TryPop(outMsg);
+        }
+
+        void CollectOutgoing(std::vector<TransportFrame>& out)
+        {
+            Message msg;
+
+            while (outboundRing.TryPop(msg))
+                AppendToLane(msg);
+
+            for (size_t index = 0; index < laneList.size(); ++index)
             {
-                const auto type = static_cast<Message::Type>(data[0]);
+                auto& lane = laneList[index];
 
-                const std::vector payload(data + 1, data + bytes);
-                std::lock_guard lock(mutex);
+                if (lane.current && !lane.current->empty())
+                    lane.readyList.push_back(std::move(lane.current));
 
-                messageQueue.emplace(Message::Create(type, payload.data(), payload.size(), true));  
-            }  
+                for (auto& frame : lane.readyList)
+                    out.push_back(TransportFrame{ connection, static_cast<uint16_t>(index), index == static_cast<size_t>(Lane::Reliable), !nagleEnabled.load(std::memory_order_relaxed), std::move(frame) });
 
-            incoming->Release();
+                lane.readyList.clear();
+            }
         }
 
-        bool Receive(Message& outMsg)
+        void EnqueueReceived(const uint8_t* data, const size_t size, const bool reliable)
         {
-            std::lock_guard lock(mutex);
+            const auto* cursor = data;
+            const auto* end = cursor + size;
+
+            if (IsOverflowed())
+                return;
+
+            RetryInbound();
+
+            while (cursor < end)
+            {
+                uint64_t recordSize;
+
+                if (!Varint::Read(cursor, end, recordSize) || recordSize < 1 || recordSize > static_cast<uint64_t>(end - cursor))
+                {
+                    std::cerr << "Dropping malformed frame from peer '" << connection << "'.\n";
+                    break;
+                }
+
+                const auto type = static_cast<Message::Type>(cursor[0]);
 
-            if (messageQueue.empty())
-                return false;
+                auto msg = Message::Create(type, cursor + 1, recordSize - 1, reliable);
 
-            outMsg = std::move(messageQueue.front());
-            messageQueue.pop();
+                cursor += recordSize;
 
-            return true;
+                if (inboundOverflow.empty() && inboundRing.TryPush(std::move(msg)))
+                    continue;
+
+                if (!reliable)
+                    continue;
+
+                inboundOverflowSize += msg.GetFramedSize();
+                inboundOverflow.push_back(std::move(msg));
+
+                if (inboundOverflowSize > MaximumOverflowSize)
+                {
+                    MarkOverflowed("inbound");
+                    break;
+                }
+            }
+        }
+
+        void RetryInbound()
+        {
+            RetryOverflow(inboundRing, inboundOverflow, inboundOverflowSize);
         }
 
-        static std::unique_ptr<PeerConnection> Create(const HSteamNetConnection connection, ISteamNetworkingSockets* sockets, const HSteamNetPollGroup pollGroup)
+        [[nodiscard]]
+        bool IsOverflowed() const
+        {
+            return overflowed.load(std::memory_order_acquire);
+        }
+
+        void SetNagleEnabled(const bool enabled)
+        {
+            nagleEnabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        bool IsNagleEnabled() const
+        {
+            return nagleEnabled.load(std::memory_order_relaxed);
+        }
+
+        static std::unique_ptr<PeerConnection> Create(const HSteamNetConnection connection, Transport* transport)
         {
             auto result = std::unique_ptr<PeerConnection>(new PeerConnection());
 
             result->connection = connection;
-            result->sockets = sockets;
-
-            sockets->SetConnectionPollGroup(connection, pollGroup);
+            result->transport = transport;
 
             return result;
         }
 
     private:
 
+        using MessageRing = SpscRingBuffer<Message, QueueCapacity>;
+
+        struct OutgoingLane
+        {
+            std::unique_ptr<MessageBufferPool::Buffer> current;
+            std::vector<std::unique_ptr<MessageBufferPool::Buffer>> readyList;
+        };
+
         PeerConnection() = default;
 
+        static void RetryOverflow(MessageRing& ring, std::deque<Message>& overflow, size_t& overflowSize)
+        {
+            while (!overflow.empty())
+            {
+                const size_t size = overflow.front().GetFramedSize();
+
+                if (!ring.TryPush(std::move(overflow.front())))
+                    break;
+
+                overflowSize -= size;
+                overflow.pop_front();
+            }
+        }
+
+        void MarkOverflowed(const char* direction)
+        {
+            if (!overflowed.exchange(true, std::memory_order_acq_rel))
+                std::cerr << "Peer '" << connection << "' exceeded its " << direction << " queue limit of " << MaximumOverflowSize << " bytes, disconnecting it.\n";
+        }
+
+        void AppendToLane(const Message& msg)
+        {
+            auto& lane = laneList[static_cast<size_t>(msg.IsReliable() ? Lane::Reliable : Lane::Unreliable)];
+
+            const size_t maximumFrameSize = msg.IsReliable() ? MaximumReliableFrameSize : MaximumUnreliableFrameSize;
+
+            if (lane.current && !lane.current->empty() && lane.current->size() + msg.GetFramedSize() > maximumFrameSize)
+                lane.readyList.push_back(std::move(lane.current));
+
+            if (!lane.current)
+                lane.current = MessageBufferPool::Acquire();
+
+            msg.AppendFramed(*lane.current);
+        }
+
         HSteamNetConnection connection = 0;
-        ISteamNetworkingSockets* sockets = nullptr;
-        std::mutex mutex;
-        std::queue<Message> messageQueue;
+        Transport* transport = nullptr;
+
+        MessageRing inboundRing;
+        MessageRing outboundRing;
+
+        std::deque<Message> inboundOverflow;
+        std::deque<Message> outboundOverflow;
+
+        size_t inboundOverflowSize = 0;
+        size_t outboundOverflowSize = 0;
+
+        std::atomic<bool> overflowed = false;
+        std::atomic<bool> closed = false;
+
+        std::array<OutgoingLane, LaneCount> laneList;
+        std::atomic<bool> nagleEnabled = false;
     };
 }
\ No newline at end of file
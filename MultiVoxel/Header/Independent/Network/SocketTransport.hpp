@@ -0,0 +1,285 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <steam/isteamnetworkingutils.h>
+#include <steam/steamnetworkingsockets.h>
+#include "Independent/Network/MessageBufferPool.hpp"
+#include "Independent/Network/Transport.hpp"
+
+namespace MultiVoxel::Independent::Network
+{
+    class SocketTransport final : public Transport
+    {
+
+    public:
+
+        static constexpr int LaneCount = 2;
+
+        SocketTransport(const SocketTransport&) = delete;
+        SocketTransport(SocketTransport&&) = delete;
+        SocketTransport& operator=(const SocketTransport&) = delete;
+        SocketTransport& operator=(SocketTransport&&) = delete;
+
+        ~SocketTransport() override
+        {
+            if (listenerSocket != k_HSteamListenSocket_Invalid)
+                sockets->CloseListenSocket(listenerSocket);
+
+            if (pollGroup)
+                sockets->DestroyPollGroup(pollGroup);
+
+            if (active == this)
+                active = nullptr;
+
+            GameNetworkingSockets_Kill();
+        }
+
+        bool Listen(const uint16_t port) override
+        {
+            SteamNetworkingIPAddr address = { };
+
+            address.Clear();
+            address.SetIPv4(0, port);
+
+            SteamNetworkingConfigValue_t opt = {};
+
+            opt.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged, (void*)OnSteamNetConnectionStatusChanged);
+
+            listenerSocket = sockets->CreateListenSocketIP(address, 1, &opt);
+
+            return listenerSocket != k_HSteamListenSocket_Invalid;
+        }
+
+        HSteamNetConnection Connect(const std::string& addressString, const uint16_t port) override
+        {
+            SteamNetworkingIPAddr address = { };
+
+            SteamNetworkingIPAddr_ParseString(&address, addressString.c_str());
+
+            address.m_port = port;
+
+            SteamNetworkingConfigValue_t opt = {};
+
+            opt.SetPtr(k_ESteamNetworkingConfig_Callback_ConnectionStatusChanged, (void*)OnSteamNetConnectionStatusChanged);
+
+            const HSteamNetConnection connection = sockets->ConnectByIPAddress(address, 1, &opt);
+
+            if (connection != k_HSteamNetConnection_Invalid)
+                ConfigureConnection(connection);
+
+            return connection;
+        }
+
+        void Close(const HSteamNetConnection connection) override
+        {
+            sockets->CloseConnection(connection, 0, nullptr, false);
+        }
+
+        void Send(std::vector<TransportFrame>& frameList) override
+        {
+            outgoingList.clear();
+            outgoingList.reserve(frameList.size());
+
+            for (auto& frame : frameList)
+            {
+                const int flags = (frame.reliable ? k_nSteamNetworkingSend_Reliable : k_nSteamNetworkingSend_Unreliable) | (frame.noNagle ? k_nSteamNetworkingSend_NoNagle : 0);
+
+                outgoingList.push_back(MessageBufferPool::Wrap(std::move(frame.buffer), frame.connection, flags, frame.lane));
+            }
+
+            frameList.clear();
+
+            if (!outgoingList.empty())
+                sockets->SendMessages(static_cast<int>(outgoingList.size()), outgoingList.data(), nullptr);
+
+            outgoingList.clear();
+        }
+
+        void Receive(const ReceiveCallback& callback) override
+        {
+            SteamNetworkingMessage_t* incoming = nullptr;
+
+            while (sockets->ReceiveMessagesOnPollGroup(pollGroup, &incoming, 1) > 0)
+            {
+                callback(incoming->m_conn, static_cast<const uint8_t*>(incoming->m_pData), static_cast<size_t>(incoming->m_cbSize), (incoming->m_nFlags & k_nSteamNetworkingSend_Reliable) != 0);
+
+                incoming->Release();
+            }
+        }
+
+        void RunCallbacks() override
+        {
+            sockets->RunCallbacks();
+        }
+
+        [[nodiscard]]
+        ConnectionState GetConnectionState(const HSteamNetConnection connection) const override
+        {
+            SteamNetConnectionInfo_t info;
+
+            if (!sockets->GetConnectionInfo(connection, &info))
+                return ConnectionState::Closed;
+
+            switch (info.m_eState)
+            {
+
+            case k_ESteamNetworkingConnectionState_Connecting:
+            case k_ESteamNetworkingConnectionState_FindingRoute:
+                return ConnectionState::Connecting;
+
+            case k_ESteamNetworkingConnectionState_Connected:
+                return ConnectionState::Connected;
+
+            default:
+                return ConnectionState::Closed;
+            }
+        }
+
+        bool GetConnectionStatus(const HSteamNetConnection connection, ConnectionStatus& outStatus) const override
+        {
+            SteamNetConnectionRealTimeStatus_t status;
+
+            if (sockets->GetConnectionRealTimeStatus(connection, &status, 0, nullptr) != k_EResultOK)
+                return false;
+
+            outStatus.ping = status.m_nPing;
+            outStatus.quality = status.m_flConnectionQualityLocal;
+            outStatus.outBytesPerSecond = status.m_flOutBytesPerSec;
+            outStatus.inBytesPerSecond = status.m_flInBytesPerSec;
+            outStatus.pendingReliableBytes = status.m_cbPendingReliable;
+            outStatus.pendingUnreliableBytes = status.m_cbPendingUnreliable;
+            outStatus.queueTime = status.m_usecQueueTime;
+
+            return true;
+        }
+
+        static std::unique_ptr<SocketTransport> Create()
+        {
+            if (active)
+            {
+                std::cerr << "Only one socket transport may exist per process.\n";
+                return nullptr;
+            }
+
+            SteamDatagramErrMsg errorMessage;
+
+            if (!GameNetworkingSockets_Init(nullptr, errorMessage))
+            {
+                std::cerr << "GNS_Init failed: " << errorMessage << "\n";
+                return nullptr;
+            }
+
+            auto result = std::unique_ptr<SocketTransport>(new SocketTransport());
+
+            result->sockets = SteamNetworkingSockets();
+            result->pollGroup = result->sockets->CreatePollGroup();
+
+            SteamNetworkingUtils()->SetDebugOutputFunction(k_ESteamNetworkingSocketsDebugOutputType_Verbose, &SocketTransport::OnDebugOutput);
+
+            if (!result->pollGroup)
+                return nullptr;
+
+            active = result.get();
+
+            return result;
+        }
+
+    private:
+
+        SocketTransport() = default;
+
+        void ConfigureConnection(const HSteamNetConnection connection) const
+        {
+            sockets->SetConnectionPollGroup(connection, pollGroup);
+
+            constexpr int lanePriorities[LaneCount] = { 0, 0 };
+            constexpr uint16 laneWeights[LaneCount] = { 1, 1 };
+
+            sockets->ConfigureConnectionLanes(connection, LaneCount, lanePriorities, laneWeights);
+        }
+
+        static void OnDebugOutput(ESteamNetworkingSocketsDebugOutputType eType, const char* message)
+        {
+            std::lock_guard lock(GetLogMutex());
+
+            switch (eType)
+            {
+                case k_ESteamNetworkingSocketsDebugOutputType_None:      break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Bug:       std::cerr << "[GNS][BUG] ";       break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Error:     std::cerr << "[GNS][ERROR] ";     break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Important: std::cerr << "[GNS][IMPORTANT] "; break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Warning:   std::cerr << "[GNS][WARNING] ";   break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Msg:       std::cerr << "[GNS][INFO] ";      break;
+                case k_ESteamNetworkingSocketsDebugOutputType_Verbose:   std::cerr << "[GNS][DEBUG] ";     break;
+
+                default:
+                    break;
+            }
+
+            std::cerr << message << "\n";
+        }
+
+        static void OnSteamNetConnectionStatusChanged(SteamNetConnectionStatusChangedCallback_t* info)
+        {
+            if (!active)
+                return;
+
+            if (info->m_info.m_eState == k_ESteamNetworkingConnectionState_Connecting && info->m_info.m_hListenSocket != k_HSteamListenSocket_Invalid)
+            {
+                if (active->sockets->AcceptConnection(info->m_hConn) != k_EResultOK)
+                {
+                    std::cerr << "Failed to accept connection (handle=" << info->m_hConn << ")\n";
+                    active->sockets->CloseConnection(info->m_hConn, 0, nullptr, false);
+
+                    return;
+                }
+
+                if (active->sockets->SetConnectionPollGroup(info->m_hConn, active->pollGroup) != k_EResultOK)
+                {
+                    std::cerr << "Failed to set poll group for connection (handle=" << info->m_hConn << ")\n";
+                    active->sockets->CloseConnection(info->m_hConn, 0, nullptr, false);
+
+                    return;
+                }
+
+                active->ConfigureConnection(info->m_hConn);
+                active->RaiseEvent(info->m_hConn, ConnectionEvent::Accepted);
+            }
+            else switch (info->m_info.m_eState)
+            {
+
+            case k_ESteamNetworkingConnectionState_Connected:
+                active->RaiseEvent(info->m_hConn, ConnectionEvent::Connected);
+                break;
+
+            case k_ESteamNetworkingConnectionState_ClosedByPeer:
+            case k_ESteamNetworkingConnectionState_ProblemDetectedLocally:
+                active->RaiseEvent(info->m_hConn, ConnectionEvent::Closed);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        static std::mutex& GetLogMutex()
+        {
+            static std::mutex mutex;
+
+            return mutex;
+        }
+
+        ISteamNetworkingSockets* sockets = nullptr;
+        HSteamNetPollGroup pollGroup = 0;
+        HSteamListenSocket listenerSocket = k_HSteamListenSocket_Invalid;
+
+        std::vector<SteamNetworkingMessage_t*> outgoingList;
+
+        static SocketTransport* active;
+
+    };
+
+    SocketTransport* SocketTransport::active = nullptr;
+}
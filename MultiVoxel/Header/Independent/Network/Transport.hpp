@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <steam/steamnetworkingtypes.h>
+#include "Independent/Network/MessageBufferPool.hpp"
+
+namespace MultiVoxel::Independent::Network
+{
+    struct TransportFrame
+    {
+        HSteamNetConnection connection = k_HSteamNetConnection_Invalid;
+        uint16_t lane = 0;
+        bool reliable = true;
+        bool noNagle = true;
+
+        std::unique_ptr<MessageBufferPool::Buffer> buffer;
+    };
+
+    struct ConnectionStatus
+    {
+        int ping = -1;
+        float quality = 1.0f;
+        float outBytesPerSecond = 0.0f;
+        float inBytesPerSecond = 0.0f;
+        int pendingReliableBytes = 0;
+        int pendingUnreliableBytes = 0;
+        int64_t queueTime = 0;
+    };
+
+    class Transport
+    {
+
+    public:
+
+        enum class ConnectionEvent : uint8_t
+        {
+            Accepted,
+            Connected,
+            Closed
+        };
+
+        enum class ConnectionState : uint8_t
+        {
+            Connecting,
+            Connected,
+            Closed
+        };
+
+        using EventCallback = std::function<void(HSteamNetConnection, ConnectionEvent)>;
+        using ReceiveCallback = std::function<void(HSteamNetConnection, const uint8_t*, size_t, bool)>;
+
+        virtual ~Transport() = default;
+
+        virtual bool Listen(uint16_t port) = 0;
+
+        virtual HSteamNetConnection Connect(const std::string& address, uint16_t port) = 0;
+
+        virtual void Close(HSteamNetConnection connection) = 0;
+
+        virtual void Send(std::vector<TransportFrame>& frameList) = 0;
+
+        virtual void Receive(const ReceiveCallback& callback) = 0;
+
+        virtual void RunCallbacks() = 0;
+
+        [[nodiscard]]
+        virtual ConnectionState GetConnectionState(HSteamNetConnection connection) const = 0;
+
+        virtual bool GetConnectionStatus(HSteamNetConnection connection, ConnectionStatus& outStatus) const = 0;
+
+        void SetEventCallback(EventCallback callback)
+        {
+            eventCallback = std::move(callback);
+        }
+
+    protected:
+
+        void RaiseEvent(const HSteamNetConnection connection, const ConnectionEvent event) const
+        {
+            if (eventCallback)
+                eventCallback(connection, event);
+        }
+
+    private:
+
+        EventCallback eventCallback;
+
+    };
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MultiVoxel::Independent::Network
+{
+    class Varint final
+    {
+
+    public:
+
+        static constexpr size_t MaximumSize = 10;
+
+        static void Write(std::vector<uint8_t>& out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value) | 0x80);
+                value >>= 7;
+            }
+
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        static bool Read(const uint8_t*& cursor, const uint8_t* end, uint64_t& out)
+        {
+            out = 0;
+
+            for (uint32_t shift = 0; shift < 64 && cursor < end; shift += 7)
+            {
+                const uint8_t byte = *cursor++;
+
+                out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+
+            return false;
+        }
+
+        [[nodiscard]]
+        static constexpr size_t SizeOf(uint64_t value)
+        {
+            size_t result = 1;
+
+            while (value >= 0x80)
+            {
+                value >>= 7;
+                ++result;
+            }
+
+            return result;
+        }
+
+    private:
+
+        Varint() = default;
+
+    };
+}
\ No newline at end of file
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Independent/Network/Varint.hpp"
+
+namespace MultiVoxel::Independent::Network
+{
+    class WireArchiveError final : public std::runtime_error
+    {
+
+    public:
+
+        using std::runtime_error::runtime_error;
+
+    };
+
+    namespace WireDetail
+    {
+        template <typename T, template <typename...> typename TEMPLATE>
+        struct IsSpecialization : std::false_type { };
+
+        template <template <typename...> typename TEMPLATE, typename... Arguments>
+        struct IsSpecialization<TEMPLATE<Arguments...>, TEMPLATE> : std::true_type { };
+
+        template <typename T>
+        struct IsArray : std::false_type { };
+
+        template <typename T, size_t N>
+        struct IsArray<std::array<T, N>> : std::true_type { };
+
+        template <typename T>
+        concept ByteLike = std::is_integral_v<T> && sizeof(T) == 1;
+
+        template <typename T>
+        concept RawCopyable = std::is_floating_point_v<T> || (ByteLike<T> && !std::same_as<T, bool>);
+
+        template <typename T>
+        concept StringLike = !std::same_as<T, std::string> && std::convertible_to<T, std::string> && std::constructible_from<T, std::string>;
+
+        template <typename T>
+        concept Map = IsSpecialization<T, std::map>::value || IsSpecialization<T, std::unordered_map>::value;
+
+        template <typename>
+        inline constexpr bool AlwaysFalse = false;
+
+        template <typename T>
+        constexpr uint64_t ZigZagEncode(const T value)
+        {
+            using Unsigned = std::make_unsigned_t<T>;
+
+            return static_cast<uint64_t>((static_cast<Unsigned>(value) << 1) ^ static_cast<Unsigned>(value >> (sizeof(T) * 8 - 1)));
+        }
+
+        template <typename T>
+        constexpr T ZigZagDecode(const uint64_t value)
+        {
+            return static_cast<T>(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+        }
+    }
+
+    class WireOutputArchive final
+    {
+
+    public:
+
+        explicit WireOutputArchive(std::string& buffer) : buffer(buffer) { }
+
+        WireOutputArchive(const WireOutputArchive&) = delete;
+        WireOutputArchive(WireOutputArchive&&) = delete;
+        WireOutputArchive& operator=(const WireOutputArchive&) = delete;
+        WireOutputArchive& operator=(WireOutputArchive&&) = delete;
+
+        template <typename... Arguments>
+        WireOutputArchive& operator()(const Arguments&... arguments)
+        {
+            (Write(arguments), ...);
+
+            return *this;
+        }
+
+        void WriteBytes(const void* data, const size_t size)
+        {
+            if (size)
+                buffer.append(static_cast<const char*>(data), size);
+        }
+
+        void WriteVarint(uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<char>(static_cast<uint8_t>(value) | 0x80));
+                value >>= 7;
+            }
+
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        void WriteLengthPrefixed(const void* data, const size_t size)
+        {
+            WriteVarint(size);
+            WriteBytes(data, size);
+        }
+
+        template <typename Function>
+        void WriteNested(Function&& function)
+        {
+            const size_t start = buffer.size();
+
+            function(*this);
+
+            const size_t size = buffer.size() - start;
+
+            char prefix[Varint::MaximumSize];
+            size_t prefixSize = 0;
+
+            for (uint64_t value = size; ; value >>= 7)
+            {
+                prefix[prefixSize++] = static_cast<char>(value >= 0x80 ? (static_cast<uint8_t>(value) | 0x80) : static_cast<uint8_t>(value));
+
+                if (value < 0x80)
+                    break;
+            }
+
+            buffer.insert(start, prefix, prefixSize);
+        }
+
+        [[nodiscard]]
+        size_t GetSize() const
+        {
+            return buffer.size();
+        }
+
+        [[nodiscard]]
+        std::string& GetBuffer()
+        {
+            return buffer;
+        }
+
+    private:
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            using namespace WireDetail;
+
+            if constexpr (std::is_enum_v<T>)
+                Write(static_cast<std::underlying_type_t<T>>(value));
+            else if constexpr (std::same_as<T, bool>)
+                buffer.push_back(value ? 1 : 0);
+            else if constexpr (ByteLike<T>)
+                buffer.push_back(static_cast<char>(value));
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                WriteVarint(ZigZagEncode(value));
+            else if constexpr (std::is_integral_v<T>)
+                WriteVarint(value);
+            else if constexpr (std::is_floating_point_v<T>)
+                WriteBytes(&value, sizeof(T));
+            else if constexpr (requires { const_cast<T&>(value).serialize(*this); })
+                const_cast<T&>(value).serialize(*this);
+            else if constexpr (requires { value.save(*this); })
+                value.save(*this);
+            else if constexpr (std::same_as<T, std::string>)
+                WriteLengthPrefixed(value.data(), value.size());
+            else if constexpr (StringLike<T>)
+                Write(static_cast<std::string>(value));
+            else if constexpr (IsSpecialization<T, std::vector>::value)
+            {
+                WriteVarint(value.size());
+
+                if constexpr (RawCopyable<typename T::value_type>)
+                    WriteBytes(value.data(), value.size() * sizeof(typename T::value_type));
+                else
+                {
+                    for (const auto& element : value)
+                        Write(element);
+                }
+            }
+            else if constexpr (IsArray<T>::value)
+            {
+                if constexpr (RawCopyable<typename T::value_type>)
+                    WriteBytes(value.data(), value.size() * sizeof(typename T::value_type));
+                else
+                {
+                    for (const auto& element : value)
+                        Write(element);
+                }
+            }
+            else if constexpr (IsSpecialization<T, std::optional>::value)
+            {
+                Write(value.has_value());
+
+                if (value)
+                    Write(*value);
+            }
+            else if constexpr (IsSpecialization<T, std::pair>::value || IsSpecialization<T, std::tuple>::value)
+                std::apply([&](const auto&... elements) { (Write(elements), ...); }, value);
+            else if constexpr (Map<T>)
+            {
+                WriteVarint(value.size());
+
+                for (const auto& [key, element] : value)
+                    (*this)(key, element);
+            }
+            else
+                static_assert(AlwaysFalse<T>, "Type has no wire serialization");
+        }
+
+        std::string& buffer;
+
+    };
+
+    class WireInputArchive final
+    {
+
+    public:
+
+        WireInputArchive(const uint8_t* data, const size_t size) : begin(data), cursor(data), end(data + size) { }
+
+        explicit WireInputArchive(const std::span<const uint8_t> data) : WireInputArchive(data.data(), data.size()) { }
+
+        explicit WireInputArchive(const std::string& data) : WireInputArchive(reinterpret_cast<const uint8_t*>(data.data()), data.size()) { }
+
+        WireInputArchive(const WireInputArchive&) = delete;
+        WireInputArchive(WireInputArchive&&) = delete;
+        WireInputArchive& operator=(const WireInputArchive&) = delete;
+        WireInputArchive& operator=(WireInputArchive&&) = delete;
+
+        template <typename... Arguments>
+        WireInputArchive& operator()(Arguments&... arguments)
+        {
+            (Read(arguments), ...);
+
+            return *this;
+        }
+
+        void ReadBytes(void* data, const size_t size)
+        {
+            Require(size);
+
+            if (size)
+                std::memcpy(data, cursor, size);
+
+            cursor += size;
+        }
+
+        uint64_t ReadVarint()
+        {
+            uint64_t result;
+
+            if (!Varint::Read(cursor, end, result))
+                throw WireArchiveError("Truncated varint in wire archive");
+
+            return result;
+        }
+
+        std::span<const uint8_t> ReadLengthPrefixed()
+        {
+            const auto size = ReadSize();
+
+            const std::span<const uint8_t> result(cursor, size);
+
+            cursor += size;
+
+            return result;
+        }
+
+        void Skip(const size_t size)
+        {
+            Require(size);
+
+            cursor += size;
+        }
+
+        [[nodiscard]]
+        size_t GetPosition() const
+        {
+            return static_cast<size_t>(cursor - begin);
+        }
+
+        void SetPosition(const size_t position)
+        {
+            if (position > static_cast<size_t>(end - begin))
+                throw WireArchiveError("Wire archive position out of range");
+
+            cursor = begin + position;
+        }
+
+        [[nodiscard]]
+        size_t GetRemaining() const
+        {
+            return static_cast<size_t>(end - cursor);
+        }
+
+        [[nodiscard]]
+        bool IsAtEnd() const
+        {
+            return cursor == end;
+        }
+
+    private:
+
+        void Require(const size_t size) const
+        {
+            if (size > static_cast<size_t>(end - cursor))
+                throw WireArchiveError("Unexpected end of wire archive");
+        }
+
+        size_t ReadSize()
+        {
+            const uint64_t size = ReadVarint();
+
+            Require(size);
+
+            return static_cast<size_t>(size);
+        }
+
+        template <typename T>
+        void Read(T& value)
+        {
+            using namespace WireDetail;
+
+            if constexpr (std::is_enum_v<T>)
+            {
+                std::underlying_type_t<T> underlying;
+
+                Read(underlying);
+
+                value = static_cast<T>(underlying);
+            }
+            else if constexpr (std::same_as<T, bool>)
+            {
+                uint8_t byte;
+
+                ReadBytes(&byte, 1);
+
+                value = byte != 0;
+            }
+            else if constexpr (ByteLike<T>)
+                ReadBytes(&value, 1);
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+                value = ZigZagDecode<T>(ReadVarint());
+            else if constexpr (std::is_integral_v<T>)
+                value = static_cast<T>(ReadVarint());
+            else if constexpr (std::is_floating_point_v<T>)
+                ReadBytes(&value, sizeof(T));
+            else if constexpr (requires { value.serialize(*this); })
+                value.serialize(*this);
+            else if constexpr (requires { value.load(*this); })
+                value.load(*this);
+            else if constexpr (std::same_as<T, std::string>)
+            {
+                const auto size = ReadSize();
+
+                value.assign(reinterpret_cast<const char*>(cursor), size);
+
+                cursor += size;
+            }
+            else if constexpr (StringLike<T>)
+            {
+                std::string string;
+
+                Read(string);
+
+                value = T(string);
+            }
+            else if constexpr (IsSpecialization<T, std::vector>::value)
+            {
+                const auto size = ReadSize();
+
+                value.resize(size);
+
+                if constexpr (RawCopyable<typename T::value_type>)
+                    ReadBytes(value.data(), size * sizeof(typename T::value_type));
+                else
+                {
+                    for (auto& element : value)
+                        Read(element);
+                }
+            }
+            else if constexpr (IsArray<T>::value)
+            {
+                if constexpr (RawCopyable<typename T::value_type>)
+                    ReadBytes(value.data(), value.size() * sizeof(typename T::value_type));
+                else
+                {
+                    for (auto& element : value)
+                        Read(element);
+                }
+            }
+            else if constexpr (IsSpecialization<T, std::optional>::value)
+            {
+                bool hasValue;
+
+                Read(hasValue);
+
+                if (!hasValue)
+                {
+                    value.reset();
+                    return;
+                }
+
+                typename T::value_type element{ };
+
+                Read(element);
+
+                value = std::move(element);
+            }
+            else if constexpr (IsSpecialization<T, std::pair>::value || IsSpecialization<T, std::tuple>::value)
+                std::apply([&](auto&... elements) { (Read(elements), ...); }, value);
+            else if constexpr (Map<T>)
+            {
+                const auto size = ReadSize();
+
+                value.clear();
+
+                for (size_t index = 0; index < size; ++index)
+                {
+                    typename T::key_type key{ };
+                    typename T::mapped_type element{ };
+
+                    (*this)(key, element);
+
+                    value.emplace(std::move(key), std::move(element));
+                }
+            }
+            else
+                static_assert(AlwaysFalse<T>, "Type has no wire serialization");
+        }
+
+        const uint8_t* begin;
+        const uint8_t* cursor;
+        const uint8_t* end;
+
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace MultiVoxel::Independent::Thread
+{
+    template <typename T, size_t CAPACITY>
+    class SpscRingBuffer final
+    {
+
+        static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+    public:
+
+        SpscRingBuffer() : slotList(CAPACITY) { }
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer(SpscRingBuffer&&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+        bool TryPush(T&& value)
+        {
+            const size_t tail = this->tail.load(std::memory_order_relaxed);
+
+            if (tail - cachedHead == CAPACITY)
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+
+                if (tail - cachedHead == CAPACITY)
+                    return false;
+            }
+
+            slotList[tail & Mask] = std::move(value);
+
+            this->tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        bool TryPop(T& outValue)
+        {
+            const size_t head = this->head.load(std::memory_order_relaxed);
+
+            if (head == cachedTail)
+            {
+                cachedTail = tail.load(std::memory_order_acquire);
+
+                if (head == cachedTail)
+                    return false;
+            }
+
+            outValue = std::move(slotList[head & Mask]);
+            slotList[head & Mask] = T{ };
+
+            this->head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        [[nodiscard]]
+        bool IsEmpty() const
+        {
+            return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]]
+        static constexpr size_t GetCapacity()
+        {
+            return CAPACITY;
+        }
+
+    private:
+
+        static constexpr size_t Mask = CAPACITY - 1;
+        static constexpr size_t CacheLineSize = 64;
+
+        std::vector<T> slotList;
+
+        alignas(CacheLineSize) std::atomic<size_t> head = 0;
+        size_t cachedTail = 0;
+
+        alignas(CacheLineSize) std::atomic<size_t> tail = 0;
+        size_t cachedHead = 0;
+
+    };
+}
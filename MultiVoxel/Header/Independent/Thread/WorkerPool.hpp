@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MultiVoxel::Independent::Thread
+{
+    class WorkerPool final
+    {
+
+    public:
+
+        explicit WorkerPool(const size_t threadCount)
+        {
+            for (size_t index = 0; index < std::max<size_t>(threadCount, 1); ++index)
+                threadList.emplace_back([this]() { WorkerLoop(); });
+        }
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard lock(mutex);
+
+                stopping = true;
+            }
+
+            taskAvailable.notify_all();
+
+            for (auto& thread : threadList)
+                thread.join();
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool(WorkerPool&&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        WorkerPool& operator=(WorkerPool&&) = delete;
+
+        void Submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard lock(mutex);
+
+                taskQueue.push_back(std::move(task));
+            }
+
+            taskAvailable.notify_one();
+        }
+
+        void Wait()
+        {
+            std::unique_lock lock(mutex);
+
+            idle.wait(lock, [this]() { return taskQueue.empty() && activeCount == 0; });
+        }
+
+        [[nodiscard]]
+        size_t GetThreadCount() const
+        {
+            return threadList.size();
+        }
+
+    private:
+
+        void WorkerLoop()
+        {
+            while (true)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock lock(mutex);
+
+                    taskAvailable.wait(lock, [this]() { return stopping || !taskQueue.empty(); });
+
+                    if (taskQueue.empty())
+                        return;
+
+                    task = std::move(taskQueue.front());
+                    taskQueue.pop_front();
+
+                    activeCount++;
+                }
+
+                task();
+
+                {
+                    std::lock_guard lock(mutex);
+
+                    activeCount--;
+
+                    if (taskQueue.empty() && activeCount == 0)
+                        idle.notify_all();
+                }
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable idle;
+
+        std::deque<std::function<void()>> taskQueue;
+        size_t activeCount = 0;
+        bool stopping = false;
+
+        std::vector<std::thread> threadList;
+
+    };
+}
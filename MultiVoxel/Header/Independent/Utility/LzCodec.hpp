@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace MultiVoxel::Independent::Utility
+{
+    class LzCodec final
+    {
+
+    public:
+
+        static constexpr size_t MinimumMatch = 4;
+        static constexpr size_t MaximumOffset = 65535;
+        static constexpr size_t MaximumDictionarySize = MaximumOffset;
+
+        static void Compress(const uint8_t* dictionary, const size_t dictionarySize, const uint8_t* input, const size_t inputSize, std::vector<uint8_t>& out)
+        {
+            auto& window = GetScratch();
+            auto& table = GetHashTable();
+
+            const size_t usedDictionarySize = dictionarySize > MaximumDictionarySize ? MaximumDictionarySize : dictionarySize;
+
+            window.resize(usedDictionarySize + inputSize);
+
+            if (usedDictionarySize)
+                std::memcpy(window.data(), dictionary + dictionarySize - usedDictionarySize, usedDictionarySize);
+
+            if (inputSize)
+                std::memcpy(window.data() + usedDictionarySize, input, inputSize);
+
+            table.fill(-1);
+
+            const uint8_t* data = window.data();
+            const size_t total = window.size();
+
+            for (size_t position = 0; position + MinimumMatch <= usedDictionarySize; ++position)
+                table[Hash(Read32(data + position))] = static_cast<int32_t>(position);
+
+            out.clear();
+            out.reserve(inputSize / 2 + 16);
+
+            size_t anchor = usedDictionarySize;
+            size_t position = usedDictionarySize;
+
+            while (position + MinimumMatch <= total)
+            {
+                const uint32_t sequence = Read32(data + position);
+                const uint32_t hash = Hash(sequence);
+                const int32_t candidate = table[hash];
+
+                table[hash] = static_cast<int32_t>(position);
+
+                if (candidate < 0 || position - candidate > MaximumOffset || Read32(data + candidate) != sequence)
+                {
+                    ++position;
+                    continue;
+                }
+
+                size_t matchLength = MinimumMatch;
+
+                while (position + matchLength < total && data[candidate + matchLength] == data[position + matchLength])
+                    ++matchLength;
+
+                EmitSequence(out, data + anchor, position - anchor, position - candidate, matchLength);
+
+                position += matchLength;
+                anchor = position;
+
+                if (position >= 2 && position + MinimumMatch <= total + 2)
+                    table[Hash(Read32(data + position - 2))] = static_cast<int32_t>(position - 2);
+            }
+
+            EmitSequence(out, data + anchor, total - anchor, 0, 0);
+        }
+
+        static bool Decompress(const uint8_t* dictionary, const size_t dictionarySize, const uint8_t* input, const size_t inputSize, const size_t originalSize, std::vector<uint8_t>& out)
+        {
+            auto& window = GetScratch();
+
+            const size_t usedDictionarySize = dictionarySize > MaximumDictionarySize ? MaximumDictionarySize : dictionarySize;
+
+            window.clear();
+            window.reserve(usedDictionarySize + originalSize);
+            window.insert(window.end(), dictionary + dictionarySize - usedDictionarySize, dictionary + dictionarySize);
+
+            const uint8_t* cursor = input;
+            const uint8_t* end = input + inputSize;
+
+            const size_t limit = usedDictionarySize + originalSize;
+
+            while (cursor < end)
+            {
+                const uint8_t token = *cursor++;
+
+                size_t literalLength = token >> 4;
+
+                if (literalLength == 15 && !ReadExtendedLength(cursor, end, literalLength))
+                    return false;
+
+                if (literalLength > static_cast<size_t>(end - cursor) || window.size() + literalLength > limit)
+                    return false;
+
+                window.insert(window.end(), cursor, cursor + literalLength);
+                cursor += literalLength;
+
+                if (cursor == end)
+                    break;
+
+                if (end - cursor < 2)
+                    return false;
+
+                const size_t offset = cursor[0] | static_cast<size_t>(cursor[1]) << 8;
+                cursor += 2;
+
+                size_t matchLength = token & 0x0F;
+
+                if (matchLength == 15 && !ReadExtendedLength(cursor, end, matchLength))
+                    return false;
+
+                matchLength += MinimumMatch;
+
+                if (offset == 0 || offset > window.size() || window.size() + matchLength > limit)
+                    return false;
+
+                size_t source = window.size() - offset;
+
+                for (size_t index = 0; index < matchLength; ++index)
+                    window.push_back(window[source++]);
+            }
+
+            if (window.size() != limit)
+                return false;
+
+            out.assign(window.begin() + static_cast<std::ptrdiff_t>(usedDictionarySize), window.end());
+
+            return true;
+        }
+
+    private:
+
+        LzCodec() = default;
+
+        static constexpr uint32_t HashBits = 14;
+
+        static uint32_t Read32(const uint8_t* data)
+        {
+            uint32_t result;
+
+            std::memcpy(&result, data, sizeof(result));
+
+            return result;
+        }
+
+        static uint32_t Hash(const uint32_t sequence)
+        {
+            return (sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        static void WriteExtendedLength(std::vector<uint8_t>& out, size_t length)
+        {
+            while (length >= 255)
+            {
+                out.push_back(255);
+                length -= 255;
+            }
+
+            out.push_back(static_cast<uint8_t>(length));
+        }
+
+        static bool ReadExtendedLength(const uint8_t*& cursor, const uint8_t* end, size_t& length)
+        {
+            while (cursor < end)
+            {
+                const uint8_t byte = *cursor++;
+
+                length += byte;
+
+                if (byte != 255)
+                    return true;
+            }
+
+            return false;
+        }
+
+        static void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, const size_t literalLength, const size_t offset, const size_t matchLength)
+        {
+            const size_t matchCode = matchLength ? matchLength - MinimumMatch : 0;
+
+            out.push_back(static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4 | (matchCode < 15 ? matchCode : 15)));
+
+            if (literalLength >= 15)
+                WriteExtendedLength(out, literalLength - 15);
+
+            out.insert(out.end(), literals, literals + literalLength);
+
+            if (!matchLength)
+                return;
+
+            out.push_back(static_cast<uint8_t>(offset & 0xFF));
+            out.push_back(static_cast<uint8_t>(offset >> 8));
+
+            if (matchCode >= 15)
+                WriteExtendedLength(out, matchCode - 15);
+        }
+
+        static std::vector<uint8_t>& GetScratch()
+        {
+            thread_local std::vector<uint8_t> scratch;
+
+            return scratch;
+        }
+
+        static std::array<int32_t, 1 << HashBits>& GetHashTable()
+        {
+            thread_local std::array<int32_t, 1 << HashBits> table;
+
+            return table;
+        }
+    };
+}
\ No newline at end of file
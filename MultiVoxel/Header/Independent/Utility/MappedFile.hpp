@@ -0,0 +1,213 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace MultiVoxel::Independent::Utility
+{
+    class MappedFile final
+    {
+
+    public:
+
+        MappedFile() = default;
+
+        ~MappedFile()
+        {
+            Close();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        bool Open(const std::filesystem::path& path)
+        {
+            Close();
+
+#ifdef _WIN32
+            handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+            if (handle == INVALID_HANDLE_VALUE)
+#else
+            descriptor = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+
+            if (descriptor < 0)
+#endif
+            {
+                std::cerr << "Failed to open file '" << path.string() << "'.\n";
+                return false;
+            }
+
+            return Remap();
+        }
+
+        void Close()
+        {
+            Unmap();
+
+#ifdef _WIN32
+            if (handle != INVALID_HANDLE_VALUE)
+                CloseHandle(handle);
+
+            handle = INVALID_HANDLE_VALUE;
+#else
+            if (descriptor >= 0)
+                close(descriptor);
+
+            descriptor = -1;
+#endif
+        }
+
+        bool Write(const uint64_t offset, const void* data, const size_t size)
+        {
+#ifdef _WIN32
+            OVERLAPPED overlapped = { };
+
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD written = 0;
+
+            if (!WriteFile(handle, data, static_cast<DWORD>(size), &written, &overlapped) || written != size)
+                return false;
+#else
+            for (size_t done = 0; done < size; )
+            {
+                const auto result = pwrite(descriptor, static_cast<const uint8_t*>(data) + done, size - done, static_cast<off_t>(offset + done));
+
+                if (result <= 0)
+                    return false;
+
+                done += static_cast<size_t>(result);
+            }
+#endif
+            return true;
+        }
+
+        bool Remap()
+        {
+            Unmap();
+
+#ifdef _WIN32
+            LARGE_INTEGER fileSize;
+
+            if (!GetFileSizeEx(handle, &fileSize))
+                return false;
+
+            size = static_cast<size_t>(fileSize.QuadPart);
+
+            if (size == 0)
+                return true;
+
+            mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+            if (!mapping)
+                return false;
+
+            data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            struct stat status = { };
+
+            if (fstat(descriptor, &status) != 0)
+                return false;
+
+            size = static_cast<size_t>(status.st_size);
+
+            if (size == 0)
+                return true;
+
+            void* address = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+            data = address != MAP_FAILED ? static_cast<const uint8_t*>(address) : nullptr;
+#endif
+            if (!data)
+            {
+                std::cerr << "Failed to map " << size << " bytes.\n";
+                size = 0;
+                return false;
+            }
+
+            return true;
+        }
+
+        void Flush()
+        {
+#ifdef _WIN32
+            FlushFileBuffers(handle);
+#else
+            fsync(descriptor);
+#endif
+        }
+
+        [[nodiscard]]
+        bool IsOpen() const
+        {
+#ifdef _WIN32
+            return handle != INVALID_HANDLE_VALUE;
+#else
+            return descriptor >= 0;
+#endif
+        }
+
+        [[nodiscard]]
+        const uint8_t* GetData() const
+        {
+            return data;
+        }
+
+        [[nodiscard]]
+        size_t GetSize() const
+        {
+            return size;
+        }
+
+    private:
+
+        void Unmap()
+        {
+#ifdef _WIN32
+            if (data)
+                UnmapViewOfFile(data);
+
+            if (mapping)
+                CloseHandle(mapping);
+
+            mapping = nullptr;
+#else
+            if (data)
+                munmap(const_cast<uint8_t*>(data), size);
+#endif
+            data = nullptr;
+            size = 0;
+        }
+
+#ifdef _WIN32
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int descriptor = -1;
+#endif
+
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+
+    };
+}
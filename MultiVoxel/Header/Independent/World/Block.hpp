@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Independent/World/Chunk.hpp"
+
+namespace MultiVoxel::Independent::World
+{
+    inline constexpr BlockId StoneBlock = 1;
+    inline constexpr BlockId DirtBlock = 2;
+    inline constexpr BlockId GrassBlock = 3;
+    inline constexpr BlockId SandBlock = 4;
+    inline constexpr BlockId WaterBlock = 5;
+    inline constexpr BlockId LogBlock = 6;
+    inline constexpr BlockId LeavesBlock = 7;
+    inline constexpr BlockId LampBlock = 8;
+    inline constexpr BlockId LavaBlock = 9;
+
+    inline constexpr uint8_t MaximumLight = 15;
+
+    [[nodiscard]]
+    constexpr uint8_t GetLightOpacity(const BlockId block)
+    {
+        switch (block)
+        {
+            case AirBlock:
+                return 0;
+
+            case LeavesBlock:
+                return 1;
+
+            case WaterBlock:
+                return 2;
+
+            default:
+                return MaximumLight;
+        }
+    }
+
+    [[nodiscard]]
+    constexpr uint8_t GetLightEmission(const BlockId block)
+    {
+        return block == LampBlock || block == LavaBlock ? MaximumLight : 0;
+    }
+
+    [[nodiscard]]
+    constexpr bool IsFluid(const BlockId block)
+    {
+        return block == WaterBlock || block == LavaBlock;
+    }
+}
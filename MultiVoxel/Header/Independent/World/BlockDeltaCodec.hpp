@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Independent/Network/WireArchive.hpp"
+#include "Independent/Utility/LzCodec.hpp"
+#include "Independent/World/ChunkChangeTracker.hpp"
+
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Independent::Utility;
+
+namespace MultiVoxel::Independent::World
+{
+    inline const std::string BlockDeltaChannelName = "BlockDeltaChannel";
+
+    enum class BlockDeltaType : uint8_t
+    {
+        Delta,
+        Resync,
+        ResyncRequest
+    };
+
+    enum class SectionEncoding : uint8_t
+    {
+        Runs,
+        Section
+    };
+
+    class BlockDeltaCodec final
+    {
+
+    public:
+
+        static constexpr size_t MinimumSectionResendSize = 32;
+        static constexpr size_t MaximumChunkSize = 1 << 20;
+
+        struct Statistics
+        {
+            size_t runSectionCount = 0;
+            size_t resendSectionCount = 0;
+        };
+
+        BlockDeltaCodec(const BlockDeltaCodec&) = delete;
+        BlockDeltaCodec(BlockDeltaCodec&&) = delete;
+        BlockDeltaCodec& operator=(const BlockDeltaCodec&) = delete;
+        BlockDeltaCodec& operator=(BlockDeltaCodec&&) = delete;
+
+        static void WriteSections(WireOutputArchive& archive, const Chunk& chunk, const ChunkDirtyRegion& region, Statistics& statistics)
+        {
+            auto& changeListBySection = GetSectionChangeList();
+
+            for (auto& changeList : changeListBySection)
+                changeList.clear();
+
+            for (const auto& change : region.changeList)
+            {
+                const int32_t sectionIndex = change.y / ChunkSection::Size;
+
+                changeListBySection[sectionIndex].emplace_back(static_cast<uint16_t>(ChunkSection::GetIndex(change.x & (Chunk::Width - 1), change.y % ChunkSection::Size, change.z & (Chunk::Width - 1))), change.current);
+            }
+
+            archive(region.sectionMask);
+
+            std::string runs;
+            std::string section;
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                if (!region.IsSectionDirty(sectionIndex))
+                    continue;
+
+                runs.clear();
+                section.clear();
+
+                WriteRuns(runs, changeListBySection[sectionIndex]);
+
+                if (runs.size() >= MinimumSectionResendSize)
+                    WriteCompressed(section, [&](WireOutputArchive& sectionArchive) { chunk.GetSection(sectionIndex).Serialize(sectionArchive); });
+
+                if (!section.empty() && section.size() < runs.size())
+                {
+                    archive(SectionEncoding::Section);
+                    archive.WriteBytes(section.data(), section.size());
+
+                    statistics.resendSectionCount++;
+                }
+                else
+                {
+                    archive(SectionEncoding::Runs);
+                    archive.WriteBytes(runs.data(), runs.size());
+
+                    statistics.runSectionCount++;
+                }
+            }
+        }
+
+        static void ApplySections(WireInputArchive& archive, Chunk& chunk)
+        {
+            uint16_t sectionMask;
+
+            archive(sectionMask);
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                if ((sectionMask >> sectionIndex & 1) == 0)
+                    continue;
+
+                SectionEncoding encoding;
+
+                archive(encoding);
+
+                if (encoding == SectionEncoding::Section)
+                {
+                    ReadCompressed(archive, [&](WireInputArchive& sectionArchive) { chunk.GetSection(sectionIndex).Deserialize(sectionArchive); });
+
+                    chunk.MarkDirty();
+                    continue;
+                }
+
+                if (encoding != SectionEncoding::Runs)
+                    throw WireArchiveError("Unknown block delta section encoding");
+
+                uint32_t runCount;
+
+                archive(runCount);
+
+                size_t index = 0;
+
+                while (runCount--)
+                {
+                    uint32_t skip;
+                    uint32_t length;
+
+                    BlockId block;
+
+                    archive(skip, length, block);
+
+                    index += skip;
+
+                    if (index + length > ChunkSection::VolumeSize)
+                        throw WireArchiveError("Block delta run exceeds its section");
+
+                    for (const size_t end = index + length; index < end; ++index)
+                    {
+                        const auto x = static_cast<int32_t>(index % ChunkSection::Size);
+                        const auto z = static_cast<int32_t>(index / ChunkSection::Size % ChunkSection::Size);
+                        const auto y = static_cast<int32_t>(index / (ChunkSection::Size * ChunkSection::Size));
+
+                        chunk.Set(x, sectionIndex * ChunkSection::Size + y, z, block);
+                    }
+                }
+            }
+        }
+
+        static void WriteChunk(WireOutputArchive& archive, const Chunk& chunk)
+        {
+            std::string compressed;
+
+            WriteCompressed(compressed, [&](WireOutputArchive& chunkArchive) { chunk.Serialize(chunkArchive); });
+
+            archive.WriteBytes(compressed.data(), compressed.size());
+        }
+
+        [[nodiscard]]
+        static std::unique_ptr<Chunk> ReadChunk(WireInputArchive& archive, const ChunkCoordinate coordinate)
+        {
+            auto result = std::make_unique<Chunk>(coordinate);
+
+            ReadCompressed(archive, [&](WireInputArchive& chunkArchive) { result->Deserialize(chunkArchive); });
+
+            if (result->GetCoordinate() != coordinate)
+                throw WireArchiveError("Resynced chunk does not match its coordinate");
+
+            return result;
+        }
+
+    private:
+
+        using SectionChangeList = std::vector<std::pair<uint16_t, BlockId>>;
+
+        BlockDeltaCodec() = default;
+
+        static void WriteRuns(std::string& buffer, SectionChangeList& changeList)
+        {
+            std::ranges::sort(changeList);
+
+            WireOutputArchive archive(buffer);
+
+            uint32_t runCount = 0;
+
+            for (size_t index = 0; index < changeList.size(); ++index)
+            {
+                if (index == 0 || changeList[index].first != changeList[index - 1].first + 1 || changeList[index].second != changeList[index - 1].second)
+                    runCount++;
+            }
+
+            archive(runCount);
+
+            uint32_t cursor = 0;
+
+            for (size_t start = 0; start < changeList.size(); )
+            {
+                size_t end = start + 1;
+
+                while (end < changeList.size() && changeList[end].first == changeList[end - 1].first + 1 && changeList[end].second == changeList[start].second)
+                    end++;
+
+                archive(changeList[start].first - cursor, static_cast<uint32_t>(end - start), changeList[start].second);
+
+                cursor = changeList[end - 1].first + 1u;
+                start = end;
+            }
+        }
+
+        template <typename Function>
+        static void WriteCompressed(std::string& buffer, Function&& function)
+        {
+            std::string raw;
+            {
+                WireOutputArchive rawArchive(raw);
+                function(rawArchive);
+            }
+
+            std::vector<uint8_t> compressed;
+
+            LzCodec::Compress(nullptr, 0, reinterpret_cast<const uint8_t*>(raw.data()), raw.size(), compressed);
+
+            WireOutputArchive archive(buffer);
+
+            archive(static_cast<uint32_t>(raw.size()));
+            archive.WriteLengthPrefixed(compressed.data(), compressed.size());
+        }
+
+        template <typename Function>
+        static void ReadCompressed(WireInputArchive& archive, Function&& function)
+        {
+            uint32_t originalSize;
+
+            archive(originalSize);
+
+            const auto compressed = archive.ReadLengthPrefixed();
+
+            if (originalSize > MaximumChunkSize)
+                throw WireArchiveError("Block delta payload exceeds the maximum chunk size");
+
+            std::vector<uint8_t> raw;
+
+            if (!LzCodec::Decompress(nullptr, 0, compressed.data(), compressed.size(), originalSize, raw))
+                throw WireArchiveError("Block delta payload failed to decompress");
+
+            WireInputArchive rawArchive(raw.data(), raw.size());
+
+            function(rawArchive);
+        }
+
+        static std::array<SectionChangeList, Chunk::SectionCount>& GetSectionChangeList()
+        {
+            thread_local std::array<SectionChangeList, Chunk::SectionCount> result;
+
+            return result;
+        }
+
+    };
+}
@@ -0,0 +1,754 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Independent/World/ChunkChangeTracker.hpp"
+
+namespace MultiVoxel::Independent::World
+{
+    class BrickPool final
+    {
+
+    public:
+
+        static constexpr int32_t Size = 4;
+        static constexpr size_t VolumeSize = Size * Size * Size;
+
+        BrickPool() = default;
+
+        BrickPool(const BrickPool&) = delete;
+        BrickPool(BrickPool&&) = delete;
+        BrickPool& operator=(const BrickPool&) = delete;
+        BrickPool& operator=(BrickPool&&) = delete;
+
+        [[nodiscard]]
+        static constexpr size_t GetIndex(const int32_t x, const int32_t y, const int32_t z)
+        {
+            return (static_cast<size_t>(y) * Size + static_cast<size_t>(z)) * Size + static_cast<size_t>(x);
+        }
+
+        uint32_t Allocate(uint32_t* owner)
+        {
+            uint32_t slot;
+
+            if (!freeList.empty())
+            {
+                slot = freeList.back();
+                freeList.pop_back();
+            }
+            else
+            {
+                slot = static_cast<uint32_t>(ownerList.size());
+
+                ownerList.push_back(nullptr);
+                voxelList.resize(voxelList.size() + VolumeSize);
+            }
+
+            ownerList[slot] = owner;
+
+            return slot;
+        }
+
+        void Release(const uint32_t slot)
+        {
+            ownerList[slot] = nullptr;
+            freeList.push_back(slot);
+        }
+
+        [[nodiscard]]
+        BlockId* Get(const uint32_t slot)
+        {
+            return voxelList.data() + static_cast<size_t>(slot) * VolumeSize;
+        }
+
+        [[nodiscard]]
+        const BlockId* Get(const uint32_t slot) const
+        {
+            return voxelList.data() + static_cast<size_t>(slot) * VolumeSize;
+        }
+
+        void Compact()
+        {
+            std::ranges::sort(freeList, std::greater());
+
+            while (!freeList.empty())
+            {
+                const uint32_t last = static_cast<uint32_t>(ownerList.size() - 1);
+
+                if (ownerList[last] != nullptr)
+                {
+                    const uint32_t hole = freeList.back();
+
+                    freeList.pop_back();
+
+                    std::memcpy(Get(hole), Get(last), VolumeSize * sizeof(BlockId));
+
+                    ownerList[hole] = ownerList[last];
+                    *ownerList[hole] = hole;
+                }
+                else
+                    freeList.erase(std::ranges::find(freeList, last));
+
+                ownerList.pop_back();
+                voxelList.resize(voxelList.size() - VolumeSize);
+            }
+
+            ownerList.shrink_to_fit();
+            voxelList.shrink_to_fit();
+        }
+
+        void Clear()
+        {
+            voxelList.clear();
+            voxelList.shrink_to_fit();
+            ownerList.clear();
+            ownerList.shrink_to_fit();
+            freeList.clear();
+            freeList.shrink_to_fit();
+        }
+
+        [[nodiscard]]
+        size_t GetUsedCount() const
+        {
+            return ownerList.size() - freeList.size();
+        }
+
+        [[nodiscard]]
+        size_t GetFreeCount() const
+        {
+            return freeList.size();
+        }
+
+    private:
+
+        std::vector<BlockId> voxelList;
+        std::vector<uint32_t*> ownerList;
+        std::vector<uint32_t> freeList;
+
+    };
+
+    class BrickmapStore final
+    {
+
+    public:
+
+        static constexpr int32_t LevelCount = 5;
+        static constexpr size_t MaximumIncrementalChangeCount = 1024;
+        static constexpr size_t MaximumRefineCount = 4;
+
+        BrickmapStore(const BrickmapStore&) = delete;
+        BrickmapStore(BrickmapStore&&) = delete;
+        BrickmapStore& operator=(const BrickmapStore&) = delete;
+        BrickmapStore& operator=(BrickmapStore&&) = delete;
+
+        [[nodiscard]]
+        static constexpr int32_t GetLevelWidth(const int32_t level)
+        {
+            return Chunk::Width >> level;
+        }
+
+        [[nodiscard]]
+        static constexpr int32_t GetLevelHeight(const int32_t level)
+        {
+            return Chunk::Height >> level;
+        }
+
+        bool Update(const Chunk& chunk)
+        {
+            const auto coordinate = chunk.GetCoordinate();
+
+            auto [iterator, inserted] = entryMap.try_emplace(coordinate);
+
+            auto& entry = iterator->second;
+
+            if (!inserted && entry.version == chunk.GetVersion())
+                return false;
+
+            Rebuild(entry, chunk);
+
+            EnforceBudget();
+
+            return true;
+        }
+
+        template <typename Function>
+        size_t Refine(Function&& findChunk)
+        {
+            if (GetMemoryUsage() > budget / 4 * 3)
+                return 0;
+
+            std::vector<std::pair<int32_t, ChunkCoordinate>> candidateList;
+
+            for (const auto& [coordinate, entry] : entryMap)
+            {
+                if (entry.finestLevel > 0)
+                    candidateList.emplace_back(GetFocusDistance(coordinate), coordinate);
+            }
+
+            std::ranges::sort(candidateList, [](const auto& left, const auto& right) { return left.first < right.first; });
+
+            size_t result = 0;
+
+            for (const auto& [distance, coordinate] : candidateList)
+            {
+                if (result >= MaximumRefineCount)
+                    break;
+
+                const Chunk* chunk = findChunk(coordinate);
+
+                if (chunk == nullptr)
+                    continue;
+
+                auto& entry = entryMap.at(coordinate);
+
+                entry.finestLevel--;
+
+                Rebuild(entry, *chunk);
+
+                if (GetMemoryUsage() > budget)
+                {
+                    DropLevel(entry, entry.finestLevel++);
+                    break;
+                }
+
+                result++;
+            }
+
+            return result;
+        }
+
+        void OnChunkChanged(const Chunk& chunk, const ChunkDirtyRegion& region)
+        {
+            const auto iterator = entryMap.find(chunk.GetCoordinate());
+
+            if (iterator == entryMap.end() || iterator->second.finestLevel > 0 || iterator->second.version != region.baseVersion || region.changeList.size() > MaximumIncrementalChangeCount)
+            {
+                Update(chunk);
+                return;
+            }
+
+            auto& entry = iterator->second;
+
+            for (const auto& change : region.changeList)
+                WriteBlock(entry, chunk, change.x & (Chunk::Width - 1), change.y, change.z & (Chunk::Width - 1));
+
+            entry.version = chunk.GetVersion();
+
+            EnforceBudget();
+        }
+
+        void Remove(const ChunkCoordinate coordinate)
+        {
+            const auto iterator = entryMap.find(coordinate);
+
+            if (iterator == entryMap.end())
+                return;
+
+            for (int32_t level = iterator->second.finestLevel; level < LevelCount; ++level)
+                DropLevel(iterator->second, level);
+
+            entryMap.erase(iterator);
+        }
+
+        [[nodiscard]]
+        BlockId GetCell(const ChunkCoordinate coordinate, const int32_t level, int32_t x, int32_t y, int32_t z) const
+        {
+            const auto iterator = entryMap.find(coordinate);
+
+            if (iterator == entryMap.end())
+                return AirBlock;
+
+            const auto& entry = iterator->second;
+
+            for (int32_t current = level; current < entry.finestLevel; ++current)
+            {
+                x /= 2;
+                y /= 2;
+                z /= 2;
+            }
+
+            return ReadCell(entry, std::max(level, entry.finestLevel), x, y, z);
+        }
+
+        [[nodiscard]]
+        BlockId GetBlock(const int32_t x, const int32_t y, const int32_t z, const int32_t level = 0) const
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return AirBlock;
+
+            return GetCell(ChunkCoordinate::FromBlock(x, z), level, (x & (Chunk::Width - 1)) >> level, y >> level, (z & (Chunk::Width - 1)) >> level);
+        }
+
+        bool Extract(const ChunkCoordinate coordinate, const int32_t level, std::vector<BlockId>& cellList) const
+        {
+            const auto iterator = entryMap.find(coordinate);
+
+            if (iterator == entryMap.end())
+                return false;
+
+            const auto& entry = iterator->second;
+
+            const int32_t width = GetLevelWidth(level);
+            const int32_t source = std::max(level, entry.finestLevel);
+            const int32_t shift = source - level;
+
+            cellList.resize(static_cast<size_t>(width) * GetLevelHeight(level) * width);
+
+            for (int32_t y = 0; y < GetLevelHeight(level); ++y)
+            {
+                for (int32_t z = 0; z < width; ++z)
+                {
+                    for (int32_t x = 0; x < width; ++x)
+                        cellList[GetCellIndex(level, x, y, z)] = ReadCell(entry, source, x >> shift, y >> shift, z >> shift);
+                }
+            }
+
+            return true;
+        }
+
+        void Clear()
+        {
+            entryMap.clear();
+
+            pool.Clear();
+
+            referenceByteCount = 0;
+        }
+
+        [[nodiscard]]
+        static constexpr size_t GetCellIndex(const int32_t level, const int32_t x, const int32_t y, const int32_t z)
+        {
+            return (static_cast<size_t>(y) * GetLevelWidth(level) + static_cast<size_t>(z)) * GetLevelWidth(level) + static_cast<size_t>(x);
+        }
+
+        [[nodiscard]]
+        bool Has(const ChunkCoordinate coordinate) const
+        {
+            return entryMap.contains(coordinate);
+        }
+
+        [[nodiscard]]
+        int32_t GetFinestLevel(const ChunkCoordinate coordinate) const
+        {
+            const auto iterator = entryMap.find(coordinate);
+
+            return iterator == entryMap.end() ? LevelCount : iterator->second.finestLevel;
+        }
+
+        void SetFocus(std::vector<ChunkCoordinate> coordinateList)
+        {
+            focusList = std::move(coordinateList);
+        }
+
+        void SetBudget(const size_t byteCount)
+        {
+            budget = byteCount;
+
+            EnforceBudget();
+        }
+
+        [[nodiscard]]
+        size_t GetBudget() const
+        {
+            return budget;
+        }
+
+        [[nodiscard]]
+        size_t GetMemoryUsage() const
+        {
+            return pool.GetUsedCount() * BrickPool::VolumeSize * sizeof(BlockId) + referenceByteCount + entryMap.size() * sizeof(std::pair<const ChunkCoordinate, Entry>);
+        }
+
+        [[nodiscard]]
+        size_t GetEntryCount() const
+        {
+            return entryMap.size();
+        }
+
+        [[nodiscard]]
+        size_t GetBrickCount() const
+        {
+            return pool.GetUsedCount();
+        }
+
+        [[nodiscard]]
+        size_t GetLastChangedBrickCount() const
+        {
+            return lastChangedBrickCount;
+        }
+
+        static BrickmapStore& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<BrickmapStore>(new BrickmapStore());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        static constexpr uint32_t UniformFlag = 0x80000000u;
+        static constexpr size_t DefaultBudget = 256ull << 20;
+
+        struct Entry
+        {
+            std::array<std::vector<uint32_t>, LevelCount> brickList;
+
+            int32_t finestLevel = 0;
+            uint64_t version = 0;
+        };
+
+        BrickmapStore()
+        {
+            for (int32_t level = 0; level < LevelCount; ++level)
+                scratchList[level].resize(static_cast<size_t>(GetLevelWidth(level)) * GetLevelHeight(level) * GetLevelWidth(level));
+        }
+
+        [[nodiscard]]
+        static constexpr int32_t GetBrickWidth(const int32_t level)
+        {
+            return std::max(GetLevelWidth(level) / BrickPool::Size, 1);
+        }
+
+        [[nodiscard]]
+        static constexpr size_t GetBrickCount(const int32_t level)
+        {
+            return static_cast<size_t>(GetBrickWidth(level)) * GetBrickWidth(level) * (GetLevelHeight(level) / BrickPool::Size);
+        }
+
+        [[nodiscard]]
+        static BlockId Downsample(const std::array<BlockId, 8>& childList)
+        {
+            BlockId result = AirBlock;
+
+            int32_t solidCount = 0;
+            int32_t bestCount = 0;
+
+            for (size_t index = 0; index < childList.size(); ++index)
+            {
+                if (childList[index] == AirBlock)
+                    continue;
+
+                solidCount++;
+
+                const auto count = static_cast<int32_t>(std::count(childList.begin() + static_cast<ptrdiff_t>(index), childList.end(), childList[index]));
+
+                if (count > bestCount)
+                {
+                    bestCount = count;
+                    result = childList[index];
+                }
+            }
+
+            return solidCount * 2 >= static_cast<int32_t>(childList.size()) ? result : AirBlock;
+        }
+
+        void Sample(const Chunk& chunk)
+        {
+            auto& finest = scratchList[0];
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                const auto& section = chunk.GetSection(sectionIndex);
+                const size_t offset = GetCellIndex(0, 0, sectionIndex * ChunkSection::Size, 0);
+
+                if (section.IsUniform())
+                {
+                    std::fill_n(finest.begin() + static_cast<ptrdiff_t>(offset), ChunkSection::VolumeSize, section.GetUniformBlock());
+                    continue;
+                }
+
+                for (int32_t y = 0; y < ChunkSection::Size; ++y)
+                {
+                    for (int32_t z = 0; z < Chunk::Width; ++z)
+                    {
+                        for (int32_t x = 0; x < Chunk::Width; ++x)
+                            finest[offset + ChunkSection::GetIndex(x, y, z)] = section.Get(x, y, z);
+                    }
+                }
+            }
+
+            for (int32_t level = 1; level < LevelCount; ++level)
+            {
+                const auto& source = scratchList[level - 1];
+
+                auto& target = scratchList[level];
+
+                const int32_t width = GetLevelWidth(level);
+
+                std::array<BlockId, 8> childList;
+
+                for (int32_t y = 0; y < GetLevelHeight(level); ++y)
+                {
+                    for (int32_t z = 0; z < width; ++z)
+                    {
+                        for (int32_t x = 0; x < width; ++x)
+                        {
+                            for (int32_t child = 0; child < 8; ++child)
+                                childList[child] = source[GetCellIndex(level - 1, x * 2 + (child & 1), y * 2 + (child >> 2 & 1), z * 2 + (child >> 1 & 1))];
+
+                            target[GetCellIndex(level, x, y, z)] = Downsample(childList);
+                        }
+                    }
+                }
+            }
+        }
+
+        void Rebuild(Entry& entry, const Chunk& chunk)
+        {
+            Sample(chunk);
+
+            lastChangedBrickCount = 0;
+
+            for (int32_t level = entry.finestLevel; level < LevelCount; ++level)
+            {
+                auto& brickList = entry.brickList[level];
+
+                if (brickList.empty())
+                {
+                    brickList.assign(GetBrickCount(level), UniformFlag | AirBlock);
+                    referenceByteCount += brickList.capacity() * sizeof(uint32_t);
+                }
+
+                const int32_t width = GetLevelWidth(level);
+                const int32_t height = GetLevelHeight(level);
+                const int32_t brickWidth = GetBrickWidth(level);
+
+                const auto& source = scratchList[level];
+
+                std::array<BlockId, BrickPool::VolumeSize> content;
+
+                for (int32_t brickY = 0; brickY < height / BrickPool::Size; ++brickY)
+                {
+                    for (int32_t brickZ = 0; brickZ < brickWidth; ++brickZ)
+                    {
+                        for (int32_t brickX = 0; brickX < brickWidth; ++brickX)
+                        {
+                            for (int32_t y = 0; y < BrickPool::Size; ++y)
+                            {
+                                for (int32_t z = 0; z < BrickPool::Size; ++z)
+                                {
+                                    for (int32_t x = 0; x < BrickPool::Size; ++x)
+                                    {
+                                        const int32_t cellX = std::min(brickX * BrickPool::Size + x, width - 1);
+                                        const int32_t cellZ = std::min(brickZ * BrickPool::Size + z, width - 1);
+
+                                        content[BrickPool::GetIndex(x, y, z)] = source[GetCellIndex(level, cellX, brickY * BrickPool::Size + y, cellZ)];
+                                    }
+                                }
+                            }
+
+                            if (WriteBrick(brickList[(static_cast<size_t>(brickY) * brickWidth + brickZ) * brickWidth + brickX], content))
+                                lastChangedBrickCount++;
+                        }
+                    }
+                }
+            }
+
+            entry.version = chunk.GetVersion();
+        }
+
+        void WriteBlock(Entry& entry, const Chunk& chunk, int32_t cellX, int32_t cellY, int32_t cellZ)
+        {
+            if (!WriteCell(entry, 0, cellX, cellY, cellZ, chunk.Get(cellX, cellY, cellZ)))
+                return;
+
+            for (int32_t level = 1; level < LevelCount; ++level)
+            {
+                cellX /= 2;
+                cellY /= 2;
+                cellZ /= 2;
+
+                std::array<BlockId, 8> childList;
+
+                for (int32_t child = 0; child < 8; ++child)
+                    childList[child] = ReadCell(entry, level - 1, cellX * 2 + (child & 1), cellY * 2 + (child >> 2 & 1), cellZ * 2 + (child >> 1 & 1));
+
+                if (!WriteCell(entry, level, cellX, cellY, cellZ, Downsample(childList)))
+                    return;
+            }
+        }
+
+        [[nodiscard]]
+        int32_t GetFocusDistance(const ChunkCoordinate coordinate) const
+        {
+            if (focusList.empty())
+                return std::max(std::abs(coordinate.x), std::abs(coordinate.z));
+
+            int32_t result = std::numeric_limits<int32_t>::max();
+
+            for (const auto& focus : focusList)
+                result = std::min(result, std::max(std::abs(coordinate.x - focus.x), std::abs(coordinate.z - focus.z)));
+
+            return result;
+        }
+
+        bool WriteBrick(uint32_t& reference, const std::array<BlockId, BrickPool::VolumeSize>& content)
+        {
+            const bool uniform = std::ranges::all_of(content, [&](const BlockId block) { return block == content[0]; });
+
+            if (reference & UniformFlag)
+            {
+                if (uniform && static_cast<BlockId>(reference) == content[0])
+                    return false;
+
+                if (uniform)
+                {
+                    reference = UniformFlag | content[0];
+                    return true;
+                }
+
+                reference = pool.Allocate(&reference);
+            }
+            else
+            {
+                if (std::memcmp(pool.Get(reference), content.data(), sizeof(content)) == 0)
+                    return false;
+
+                if (uniform)
+                {
+                    pool.Release(reference);
+                    reference = UniformFlag | content[0];
+
+                    return true;
+                }
+            }
+
+            std::memcpy(pool.Get(reference), content.data(), sizeof(content));
+
+            return true;
+        }
+
+        [[nodiscard]]
+        BlockId ReadCell(const Entry& entry, const int32_t level, const int32_t x, const int32_t y, const int32_t z) const
+        {
+            const int32_t brickWidth = GetBrickWidth(level);
+            const uint32_t reference = entry.brickList[level][(static_cast<size_t>(y / BrickPool::Size) * brickWidth + z / BrickPool::Size) * brickWidth + x / BrickPool::Size];
+
+            if (reference & UniformFlag)
+                return static_cast<BlockId>(reference);
+
+            return pool.Get(reference)[BrickPool::GetIndex(x % BrickPool::Size, y % BrickPool::Size, z % BrickPool::Size)];
+        }
+
+        bool WriteCell(Entry& entry, const int32_t level, const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            const int32_t brickWidth = GetBrickWidth(level);
+
+            auto& reference = entry.brickList[level][(static_cast<size_t>(y / BrickPool::Size) * brickWidth + z / BrickPool::Size) * brickWidth + x / BrickPool::Size];
+
+            if (reference & UniformFlag)
+            {
+                const auto uniformBlock = static_cast<BlockId>(reference);
+
+                if (uniformBlock == block)
+                    return false;
+
+                reference = pool.Allocate(&reference);
+
+                std::fill_n(pool.Get(reference), BrickPool::VolumeSize, uniformBlock);
+            }
+
+            BlockId* voxelList = pool.Get(reference);
+
+            if (voxelList[BrickPool::GetIndex(x % BrickPool::Size, y % BrickPool::Size, z % BrickPool::Size)] == block)
+                return false;
+
+            const int32_t width = GetLevelWidth(level);
+
+            for (int32_t cellZ = z % BrickPool::Size; cellZ <= (z == width - 1 ? BrickPool::Size - 1 : z % BrickPool::Size); ++cellZ)
+            {
+                for (int32_t cellX = x % BrickPool::Size; cellX <= (x == width - 1 ? BrickPool::Size - 1 : x % BrickPool::Size); ++cellX)
+                    voxelList[BrickPool::GetIndex(cellX, y % BrickPool::Size, cellZ)] = block;
+            }
+
+            if (std::all_of(voxelList, voxelList + BrickPool::VolumeSize, [&](const BlockId current) { return current == block; }))
+            {
+                pool.Release(reference);
+                reference = UniformFlag | block;
+            }
+
+            return true;
+        }
+
+        void DropLevel(Entry& entry, const int32_t level)
+        {
+            auto& brickList = entry.brickList[level];
+
+            for (const uint32_t reference : brickList)
+            {
+                if (!(reference & UniformFlag))
+                    pool.Release(reference);
+            }
+
+            referenceByteCount -= brickList.capacity() * sizeof(uint32_t);
+
+            brickList.clear();
+            brickList.shrink_to_fit();
+        }
+
+        void EnforceBudget()
+        {
+            if (GetMemoryUsage() <= budget)
+                return;
+
+            std::vector<std::pair<int32_t, Entry*>> candidateList;
+
+            candidateList.reserve(entryMap.size());
+
+            for (auto& [coordinate, entry] : entryMap)
+                candidateList.emplace_back(GetFocusDistance(coordinate), &entry);
+
+            std::ranges::sort(candidateList, [](const auto& left, const auto& right) { return left.first > right.first; });
+
+            bool dropped = true;
+
+            while (dropped && GetMemoryUsage() > budget)
+            {
+                dropped = false;
+
+                for (auto& [distance, entry] : candidateList)
+                {
+                    if (entry->finestLevel >= LevelCount - 1)
+                        continue;
+
+                    DropLevel(*entry, entry->finestLevel++);
+                    dropped = true;
+
+                    if (GetMemoryUsage() <= budget)
+                        break;
+                }
+            }
+
+            if (pool.GetFreeCount() * 4 > pool.GetUsedCount())
+                pool.Compact();
+        }
+
+        std::unordered_map<ChunkCoordinate, Entry, ChunkCoordinateHash> entryMap;
+        std::array<std::vector<BlockId>, LevelCount> scratchList;
+
+        BrickPool pool;
+
+        std::vector<ChunkCoordinate> focusList;
+
+        size_t budget = DefaultBudget;
+        size_t referenceByteCount = 0;
+        size_t lastChangedBrickCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<BrickmapStore> instance;
+
+    };
+
+    std::once_flag BrickmapStore::initializationFlag;
+    std::unique_ptr<BrickmapStore> BrickmapStore::instance;
+}
@@ -0,0 +1,349 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Independent/Network/WireArchive.hpp"
+
+using namespace MultiVoxel::Independent::Network;
+
+namespace MultiVoxel::Independent::World
+{
+    using BlockId = uint16_t;
+
+    inline constexpr BlockId AirBlock = 0;
+
+    struct ChunkCoordinate
+    {
+        int32_t x = 0;
+        int32_t z = 0;
+
+        [[nodiscard]]
+        static constexpr ChunkCoordinate FromBlock(const int32_t blockX, const int32_t blockZ)
+        {
+            return { blockX >> 4, blockZ >> 4 };
+        }
+
+        bool operator==(const ChunkCoordinate&) const = default;
+
+        template <typename Archive>
+        void serialize(Archive& archive)
+        {
+            archive(x, z);
+        }
+    };
+
+    struct ChunkCoordinateHash
+    {
+        size_t operator()(const ChunkCoordinate& coordinate) const noexcept
+        {
+            return std::hash<uint64_t>{ }(static_cast<uint64_t>(static_cast<uint32_t>(coordinate.x)) << 32 | static_cast<uint32_t>(coordinate.z));
+        }
+    };
+
+    class ChunkSection final
+    {
+
+    public:
+
+        static constexpr int32_t Size = 16;
+        static constexpr size_t VolumeSize = Size * Size * Size;
+
+        [[nodiscard]]
+        static constexpr size_t GetIndex(const int32_t x, const int32_t y, const int32_t z)
+        {
+            return (static_cast<size_t>(y) * Size + static_cast<size_t>(z)) * Size + static_cast<size_t>(x);
+        }
+
+        [[nodiscard]]
+        BlockId Get(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            return blockList.empty() ? uniformBlock : blockList[GetIndex(x, y, z)];
+        }
+
+        bool Set(const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            if (blockList.empty())
+            {
+                if (block == uniformBlock)
+                    return false;
+
+                blockList.assign(VolumeSize, uniformBlock);
+            }
+
+            auto& current = blockList[GetIndex(x, y, z)];
+
+            if (current == block)
+                return false;
+
+            solidCount += (block != AirBlock) - (current != AirBlock);
+            current = block;
+
+            return true;
+        }
+
+        void Fill(const BlockId block)
+        {
+            blockList.clear();
+            blockList.shrink_to_fit();
+
+            uniformBlock = block;
+            solidCount = block != AirBlock ? VolumeSize : 0;
+        }
+
+        void Compact()
+        {
+            if (blockList.empty())
+                return;
+
+            for (const auto block : blockList)
+            {
+                if (block != blockList.front())
+                    return;
+            }
+
+            Fill(blockList.front());
+        }
+
+        [[nodiscard]]
+        uint8_t GetLight(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            return lightList.empty() ? uniformLight : lightList[GetIndex(x, y, z)];
+        }
+
+        bool SetLight(const int32_t x, const int32_t y, const int32_t z, const uint8_t light)
+        {
+            if (lightList.empty())
+            {
+                if (light == uniformLight)
+                    return false;
+
+                lightList.assign(VolumeSize, uniformLight);
+            }
+
+            auto& current = lightList[GetIndex(x, y, z)];
+
+            if (current == light)
+                return false;
+
+            current = light;
+
+            return true;
+        }
+
+        void FillLight(const uint8_t light)
+        {
+            lightList.clear();
+            lightList.shrink_to_fit();
+
+            uniformLight = light;
+        }
+
+        void CompactLight()
+        {
+            if (lightList.empty())
+                return;
+
+            for (const auto light : lightList)
+            {
+                if (light != lightList.front())
+                    return;
+            }
+
+            FillLight(lightList.front());
+        }
+
+        [[nodiscard]]
+        bool IsUniform() const
+        {
+            return blockList.empty();
+        }
+
+        [[nodiscard]]
+        BlockId GetUniformBlock() const
+        {
+            return uniformBlock;
+        }
+
+        [[nodiscard]]
+        bool IsEmpty() const
+        {
+            return solidCount == 0;
+        }
+
+        [[nodiscard]]
+        size_t GetSolidCount() const
+        {
+            return solidCount;
+        }
+
+        void Serialize(WireOutputArchive& archive) const
+        {
+            archive(IsUniform());
+
+            if (IsUniform())
+                archive(uniformBlock);
+            else
+                archive.WriteBytes(blockList.data(), blockList.size() * sizeof(BlockId));
+        }
+
+        void Deserialize(WireInputArchive& archive)
+        {
+            bool uniform;
+
+            archive(uniform);
+
+            if (uniform)
+            {
+                BlockId block;
+
+                archive(block);
+
+                Fill(block);
+                FillLight(0);
+                return;
+            }
+
+            FillLight(0);
+
+            blockList.resize(VolumeSize);
+
+            archive.ReadBytes(blockList.data(), blockList.size() * sizeof(BlockId));
+
+            solidCount = VolumeSize - static_cast<size_t>(std::count(blockList.begin(), blockList.end(), AirBlock));
+        }
+
+    private:
+
+        std::vector<BlockId> blockList;
+
+        BlockId uniformBlock = AirBlock;
+        size_t solidCount = 0;
+
+        std::vector<uint8_t> lightList;
+
+        uint8_t uniformLight = 0;
+
+    };
+
+    class Chunk final
+    {
+
+    public:
+
+        static constexpr int32_t Width = ChunkSection::Size;
+        static constexpr int32_t SectionCount = 16;
+        static constexpr int32_t Height = SectionCount * ChunkSection::Size;
+
+        explicit Chunk(const ChunkCoordinate coordinate) : coordinate(coordinate) { }
+
+        Chunk(const Chunk&) = delete;
+        Chunk(Chunk&&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+        Chunk& operator=(Chunk&&) = delete;
+
+        [[nodiscard]]
+        static constexpr bool IsInside(const int32_t x, const int32_t y, const int32_t z)
+        {
+            return x >= 0 && x < Width && y >= 0 && y < Height && z >= 0 && z < Width;
+        }
+
+        [[nodiscard]]
+        BlockId Get(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            return sectionList[y / ChunkSection::Size].Get(x, y % ChunkSection::Size, z);
+        }
+
+        bool Set(const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            if (!sectionList[y / ChunkSection::Size].Set(x, y % ChunkSection::Size, z, block))
+                return false;
+
+            MarkDirty();
+
+            return true;
+        }
+
+        [[nodiscard]]
+        uint8_t GetLight(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            return sectionList[y / ChunkSection::Size].GetLight(x, y % ChunkSection::Size, z);
+        }
+
+        bool SetLight(const int32_t x, const int32_t y, const int32_t z, const uint8_t light)
+        {
+            return sectionList[y / ChunkSection::Size].SetLight(x, y % ChunkSection::Size, z, light);
+        }
+
+        [[nodiscard]]
+        ChunkCoordinate GetCoordinate() const
+        {
+            return coordinate;
+        }
+
+        [[nodiscard]]
+        ChunkSection& GetSection(const int32_t index)
+        {
+            return sectionList[index];
+        }
+
+        [[nodiscard]]
+        const ChunkSection& GetSection(const int32_t index) const
+        {
+            return sectionList[index];
+        }
+
+        [[nodiscard]]
+        uint32_t GetVersion() const
+        {
+            return version;
+        }
+
+        void MarkDirty()
+        {
+            version++;
+            dirty = true;
+        }
+
+        [[nodiscard]]
+        bool IsDirty() const
+        {
+            return dirty;
+        }
+
+        void ClearDirty()
+        {
+            dirty = false;
+        }
+
+        void Serialize(WireOutputArchive& archive) const
+        {
+            archive(coordinate, version);
+
+            for (const auto& section : sectionList)
+                section.Serialize(archive);
+        }
+
+        void Deserialize(WireInputArchive& archive)
+        {
+            archive(coordinate, version);
+
+            for (auto& section : sectionList)
+                section.Deserialize(archive);
+
+            dirty = false;
+        }
+
+    private:
+
+        ChunkCoordinate coordinate;
+
+        std::array<ChunkSection, SectionCount> sectionList;
+
+        uint32_t version = 0;
+        bool dirty = false;
+
+    };
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Independent/World/ChunkManager.hpp"
+
+namespace MultiVoxel::Independent::World
+{
+    struct BlockChange
+    {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        BlockId previous;
+        BlockId current;
+    };
+
+    struct ChunkDirtyRegion
+    {
+        ChunkCoordinate coordinate;
+
+        std::array<int32_t, 3> minimum = { Chunk::Width, Chunk::Height, Chunk::Width };
+        std::array<int32_t, 3> maximum = { -1, -1, -1 };
+
+        uint16_t sectionMask = 0;
+
+        uint32_t baseVersion = 0;
+
+        std::vector<BlockChange> changeList;
+
+        [[nodiscard]]
+        bool IsSectionDirty(const int32_t sectionIndex) const
+        {
+            return (sectionMask >> sectionIndex & 1) != 0;
+        }
+    };
+
+    class ChunkChangeTracker final
+    {
+
+    public:
+
+        using Listener = std::function<void(Chunk&, const ChunkDirtyRegion&)>;
+
+        ChunkChangeTracker(const ChunkChangeTracker&) = delete;
+        ChunkChangeTracker(ChunkChangeTracker&&) = delete;
+        ChunkChangeTracker& operator=(const ChunkChangeTracker&) = delete;
+        ChunkChangeTracker& operator=(ChunkChangeTracker&&) = delete;
+
+        bool SetBlock(const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            auto& manager = ChunkManager::GetInstance();
+
+            const auto chunk = manager.GetChunk(ChunkCoordinate::FromBlock(x, z));
+
+            if (!chunk)
+                return false;
+
+            const uint32_t version = chunk->GetVersion();
+            const BlockId previous = manager.GetBlock(x, y, z);
+
+            if (!manager.SetBlock(x, y, z, block))
+                return false;
+
+            Record(x, y, z, previous, block, version);
+
+            return true;
+        }
+
+        void Record(const int32_t x, const int32_t y, const int32_t z, const BlockId previous, const BlockId current, const uint32_t baseVersion)
+        {
+            const auto coordinate = ChunkCoordinate::FromBlock(x, z);
+
+            const auto [pendingIterator, inserted] = pendingMap.try_emplace(coordinate);
+
+            auto& [region, indexMap] = pendingIterator->second;
+
+            if (inserted)
+            {
+                region.coordinate = coordinate;
+                region.baseVersion = baseVersion;
+            }
+
+            const int32_t localX = x & (Chunk::Width - 1);
+            const int32_t localZ = z & (Chunk::Width - 1);
+
+            const auto key = static_cast<uint32_t>((y * Chunk::Width + localZ) * Chunk::Width + localX);
+
+            if (const auto iterator = indexMap.find(key); iterator != indexMap.end())
+            {
+                region.changeList[iterator->second].current = current;
+                return;
+            }
+
+            indexMap.emplace(key, static_cast<uint32_t>(region.changeList.size()));
+            region.changeList.push_back({ x, y, z, previous, current });
+
+            region.minimum = { std::min(region.minimum[0], localX), std::min(region.minimum[1], y), std::min(region.minimum[2], localZ) };
+            region.maximum = { std::max(region.maximum[0], localX), std::max(region.maximum[1], y), std::max(region.maximum[2], localZ) };
+            region.sectionMask |= static_cast<uint16_t>(1u << (y / ChunkSection::Size));
+        }
+
+        void AddListener(Listener listener)
+        {
+            listenerList.push_back(std::move(listener));
+        }
+
+        void Flush()
+        {
+            lastChunkCount = 0;
+            lastChangeCount = 0;
+
+            if (pendingMap.empty())
+                return;
+
+            std::swap(pendingMap, flushingMap);
+
+            for (auto& [coordinate, pending] : flushingMap)
+            {
+                auto& changeList = pending.region.changeList;
+
+                std::erase_if(changeList, [](const BlockChange& change) { return change.previous == change.current; });
+
+                const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+                if (changeList.empty() || !chunk)
+                    continue;
+
+                lastChunkCount++;
+                lastChangeCount += changeList.size();
+
+                for (const auto& listener : listenerList)
+                    listener(*chunk, pending.region);
+            }
+
+            flushingMap.clear();
+        }
+
+        [[nodiscard]]
+        bool HasPendingChanges() const
+        {
+            return !pendingMap.empty();
+        }
+
+        [[nodiscard]]
+        size_t GetLastChunkCount() const
+        {
+            return lastChunkCount;
+        }
+
+        [[nodiscard]]
+        size_t GetLastChangeCount() const
+        {
+            return lastChangeCount;
+        }
+
+        static ChunkChangeTracker& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<ChunkChangeTracker>(new ChunkChangeTracker());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct PendingRegion
+        {
+            ChunkDirtyRegion region;
+
+            std::unordered_map<uint32_t, uint32_t> indexMap;
+        };
+
+        ChunkChangeTracker() = default;
+
+        std::unordered_map<ChunkCoordinate, PendingRegion, ChunkCoordinateHash> pendingMap;
+        std::unordered_map<ChunkCoordinate, PendingRegion, ChunkCoordinateHash> flushingMap;
+
+        std::vector<Listener> listenerList;
+
+        size_t lastChunkCount = 0;
+        size_t lastChangeCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<ChunkChangeTracker> instance;
+
+    };
+
+    std::once_flag ChunkChangeTracker::initializationFlag;
+    std::unique_ptr<ChunkChangeTracker> ChunkChangeTracker::instance;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Independent/World/Chunk.hpp"
+
+namespace MultiVoxel::Independent::World
+{
+    class ChunkManager final
+    {
+
+    public:
+
+        ChunkManager(const ChunkManager&) = delete;
+        ChunkManager(ChunkManager&&) = delete;
+        ChunkManager& operator=(const ChunkManager&) = delete;
+        ChunkManager& operator=(ChunkManager&&) = delete;
+
+        Chunk& Insert(std::unique_ptr<Chunk> chunk)
+        {
+            const auto coordinate = chunk->GetCoordinate();
+
+            auto& slot = chunkMap[coordinate];
+
+            slot = std::move(chunk);
+
+            return *slot;
+        }
+
+        std::unique_ptr<Chunk> Remove(const ChunkCoordinate coordinate)
+        {
+            const auto iterator = chunkMap.find(coordinate);
+
+            if (iterator == chunkMap.end())
+                return nullptr;
+
+            auto result = std::move(iterator->second);
+
+            chunkMap.erase(iterator);
+
+            return result;
+        }
+
+        [[nodiscard]]
+        Chunk* GetChunk(const ChunkCoordinate coordinate)
+        {
+            const auto iterator = chunkMap.find(coordinate);
+
+            return iterator != chunkMap.end() ? iterator->second.get() : nullptr;
+        }
+
+        [[nodiscard]]
+        const Chunk* GetChunk(const ChunkCoordinate coordinate) const
+        {
+            const auto iterator = chunkMap.find(coordinate);
+
+            return iterator != chunkMap.end() ? iterator->second.get() : nullptr;
+        }
+
+        [[nodiscard]]
+        bool Has(const ChunkCoordinate coordinate) const
+        {
+            return chunkMap.contains(coordinate);
+        }
+
+        [[nodiscard]]
+        BlockId GetBlock(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return AirBlock;
+
+            const auto chunk = GetChunk(ChunkCoordinate::FromBlock(x, z));
+
+            return chunk ? chunk->Get(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1)) : AirBlock;
+        }
+
+        bool SetBlock(const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return false;
+
+            const auto chunk = GetChunk(ChunkCoordinate::FromBlock(x, z));
+
+            return chunk && chunk->Set(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1), block);
+        }
+
+        [[nodiscard]]
+        size_t GetChunkCount() const
+        {
+            return chunkMap.size();
+        }
+
+        template <typename Function>
+        void ForEach(Function&& function)
+        {
+            for (auto& [coordinate, chunk] : chunkMap)
+                function(*chunk);
+        }
+
+        void Clear()
+        {
+            chunkMap.clear();
+        }
+
+        static ChunkManager& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<ChunkManager>(new ChunkManager());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        ChunkManager() = default;
+
+        std::unordered_map<ChunkCoordinate, std::unique_ptr<Chunk>, ChunkCoordinateHash> chunkMap;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<ChunkManager> instance;
+
+    };
+
+    std::once_flag ChunkManager::initializationFlag;
+    std::unique_ptr<ChunkManager> ChunkManager::instance;
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Independent/Thread/WorkerPool.hpp"
+#include "Independent/World/Block.hpp"
+#include "Independent/World/ChunkChangeTracker.hpp"
+
+using namespace MultiVoxel::Independent::Thread;
+
+namespace MultiVoxel::Independent::World
+{
+    struct FluidProperties
+    {
+        uint32_t interval;
+        uint8_t spreadThreshold;
+    };
+
+    class FluidSimulation final
+    {
+
+    public:
+
+        static constexpr uint8_t MaximumLevel = 8;
+
+        FluidSimulation(const FluidSimulation&) = delete;
+        FluidSimulation(FluidSimulation&&) = delete;
+        FluidSimulation& operator=(const FluidSimulation&) = delete;
+        FluidSimulation& operator=(FluidSimulation&&) = delete;
+
+        [[nodiscard]]
+        static constexpr FluidProperties GetProperties(const BlockId fluid)
+        {
+            return fluid == LavaBlock ? FluidProperties{ 6, 4 } : FluidProperties{ 1, 2 };
+        }
+
+        bool AddFluid(const int32_t x, const int32_t y, const int32_t z, const BlockId fluid, const uint8_t level = MaximumLevel)
+        {
+            if (!IsFluid(fluid) || level == 0 || y < 0 || y >= Chunk::Height)
+                return false;
+
+            const auto coordinate = ChunkCoordinate::FromBlock(x, z);
+            const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+            if (!chunk)
+                return false;
+
+            const auto index = GetIndex(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1));
+            const BlockId block = chunk->Get(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1));
+
+            if (block != AirBlock && block != fluid)
+                return false;
+
+            auto& column = GetColumn(coordinate);
+
+            column.cellMap[index] = { fluid, std::min(level, MaximumLevel) };
+
+            ChunkChangeTracker::GetInstance().SetBlock(x, y, z, fluid);
+
+            WakeAround(x, y, z);
+
+            return true;
+        }
+
+        void Displace(const int32_t fromX, const int32_t fromY, const int32_t fromZ, const int32_t toX, const int32_t toY, const int32_t toZ)
+        {
+            if (fromY < 0 || fromY >= Chunk::Height || toY < 0 || toY >= Chunk::Height)
+                return;
+
+            const auto coordinate = ChunkCoordinate::FromBlock(fromX, fromZ);
+            const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+            if (!chunk)
+                return;
+
+            const auto index = GetIndex(fromX & (Chunk::Width - 1), fromY, fromZ & (Chunk::Width - 1));
+            const BlockId block = chunk->Get(fromX & (Chunk::Width - 1), fromY, fromZ & (Chunk::Width - 1));
+
+            if (!IsFluid(block))
+                return;
+
+            FluidCell cell = { block, MaximumLevel };
+
+            if (const auto iterator = columnMap.find(coordinate); iterator != columnMap.end())
+            {
+                if (const auto source = iterator->second.cellMap.find(index); source != iterator->second.cellMap.end())
+                {
+                    cell = source->second;
+                    iterator->second.cellMap.erase(source);
+                }
+
+                iterator->second.blockMap.erase(index);
+            }
+
+            auto& column = GetColumn(ChunkCoordinate::FromBlock(toX, toZ));
+
+            const auto target = GetIndex(toX & (Chunk::Width - 1), toY, toZ & (Chunk::Width - 1));
+
+            column.cellMap[target] = cell;
+            column.blockMap.erase(target);
+
+            WakeAround(toX, toY, toZ);
+        }
+
+        void OnBlockChanged(const int32_t x, const int32_t y, const int32_t z, BlockId, const BlockId current)
+        {
+            const auto coordinate = ChunkCoordinate::FromBlock(x, z);
+            const auto index = GetIndex(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1));
+
+            if (IsFluid(current))
+                GetColumn(coordinate).cellMap.try_emplace(index, FluidCell{ current, MaximumLevel });
+            else if (const auto iterator = columnMap.find(coordinate); iterator != columnMap.end())
+            {
+                iterator->second.cellMap.erase(index);
+                iterator->second.blockMap.erase(index);
+            }
+
+            WakeAround(x, y, z);
+        }
+
+        void Step(const uint64_t tick, WorkerPool* pool = nullptr)
+        {
+            lastUpdatedCount = 0;
+            lastMovedCount = 0;
+
+            auto& manager = ChunkManager::GetInstance();
+
+            for (int32_t phase = 0; phase < 4; ++phase)
+            {
+                batchList.clear();
+
+                for (auto& [coordinate, column] : columnMap)
+                {
+                    if (column.activeSet.empty() || ((coordinate.x & 1) | (coordinate.z & 1) << 1) != phase)
+                        continue;
+
+                    column.chunk = manager.GetChunk(coordinate);
+
+                    if (!column.chunk)
+                    {
+                        column.activeSet.clear();
+                        continue;
+                    }
+
+                    for (size_t direction = 0; direction < DirectionList.size(); ++direction)
+                    {
+                        const ChunkCoordinate neighbour = { coordinate.x + DirectionList[direction][0], coordinate.z + DirectionList[direction][1] };
+
+                        const auto iterator = columnMap.find(neighbour);
+
+                        column.neighbourChunkList[direction] = manager.GetChunk(neighbour);
+                        column.neighbourColumnList[direction] = iterator == columnMap.end() ? nullptr : &iterator->second;
+                    }
+
+                    batchList.push_back(&column);
+                }
+
+                if (pool != nullptr && batchList.size() > 1)
+                {
+                    for (auto* column : batchList)
+                        pool->Submit([column, tick]() { Process(*column, tick); });
+
+                    pool->Wait();
+                }
+                else
+                {
+                    for (auto* column : batchList)
+                        Process(*column, tick);
+                }
+
+                for (auto* column : batchList)
+                {
+                    lastUpdatedCount += column->updatedCount;
+                    lastMovedCount += column->movedCount;
+
+                    column->updatedCount = 0;
+                    column->movedCount = 0;
+
+                    auto transferList = std::move(column->outbox);
+
+                    column->outbox.clear();
+
+                    for (const auto& transfer : transferList)
+                        Apply(transfer);
+                }
+            }
+
+            auto& tracker = ChunkChangeTracker::GetInstance();
+
+            for (auto& [coordinate, column] : columnMap)
+            {
+                for (const auto& [index, block] : column.blockMap)
+                    tracker.SetBlock(coordinate.x * Chunk::Width + (index & 15), index >> 8, coordinate.z * Chunk::Width + (index >> 4 & 15), block);
+
+                column.blockMap.clear();
+            }
+
+            std::erase_if(columnMap, [](const auto& pair) { return pair.second.cellMap.empty() && pair.second.activeSet.empty(); });
+        }
+
+        [[nodiscard]]
+        uint8_t GetLevel(const int32_t x, const int32_t y, const int32_t z) const
+        {
+            const auto iterator = columnMap.find(ChunkCoordinate::FromBlock(x, z));
+
+            if (iterator == columnMap.end() || y < 0 || y >= Chunk::Height)
+                return 0;
+
+            const auto cell = iterator->second.cellMap.find(GetIndex(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1)));
+
+            return cell == iterator->second.cellMap.end() ? 0 : cell->second.level;
+        }
+
+        [[nodiscard]]
+        size_t GetCellCount() const
+        {
+            size_t result = 0;
+
+            for (const auto& column : columnMap | std::views::values)
+                result += column.cellMap.size();
+
+            return result;
+        }
+
+        [[nodiscard]]
+        size_t GetActiveCount() const
+        {
+            size_t result = 0;
+
+            for (const auto& column : columnMap | std::views::values)
+                result += column.activeSet.size();
+
+            return result;
+        }
+
+        [[nodiscard]]
+        uint64_t GetVolume() const
+        {
+            uint64_t result = 0;
+
+            for (const auto& column : columnMap | std::views::values)
+            {
+                for (const auto& cell : column.cellMap | std::views::values)
+                    result += cell.level;
+            }
+
+            return result;
+        }
+
+        [[nodiscard]]
+        size_t GetColumnCount() const
+        {
+            return columnMap.size();
+        }
+
+        [[nodiscard]]
+        size_t GetLastUpdatedCount() const
+        {
+            return lastUpdatedCount;
+        }
+
+        [[nodiscard]]
+        size_t GetLastMovedCount() const
+        {
+            return lastMovedCount;
+        }
+
+        void Clear()
+        {
+            columnMap.clear();
+            batchList.clear();
+        }
+
+        static FluidSimulation& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<FluidSimulation>(new FluidSimulation());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct FluidCell
+        {
+            BlockId fluid;
+            uint8_t level;
+        };
+
+        struct Transfer
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+
+            BlockId fluid;
+            uint8_t amount;
+
+            bool reaction;
+        };
+
+        struct Column
+        {
+            const Chunk* chunk = nullptr;
+
+            std::array<const Chunk*, 4> neighbourChunkList = { };
+            std::array<const Column*, 4> neighbourColumnList = { };
+
+            std::unordered_map<uint16_t, FluidCell> cellMap;
+            std::unordered_map<uint16_t, BlockId> blockMap;
+            std::unordered_set<uint16_t> activeSet;
+
+            std::vector<uint16_t> updateList;
+            std::vector<Transfer> outbox;
+
+            ChunkCoordinate coordinate;
+
+            size_t updatedCount = 0;
+            size_t movedCount = 0;
+        };
+
+        static constexpr std::array<std::array<int32_t, 2>, 4> DirectionList = { { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } } };
+
+        FluidSimulation() = default;
+
+        [[nodiscard]]
+        static constexpr uint16_t GetIndex(const int32_t x, const int32_t y, const int32_t z)
+        {
+            return static_cast<uint16_t>((y * Chunk::Width + z) * Chunk::Width + x);
+        }
+
+        Column& GetColumn(const ChunkCoordinate coordinate)
+        {
+            const auto [iterator, inserted] = columnMap.try_emplace(coordinate);
+
+            if (inserted)
+                iterator->second.coordinate = coordinate;
+
+            return iterator->second;
+        }
+
+        static void Process(Column& column, const uint64_t tick)
+        {
+            column.updateList.assign(column.activeSet.begin(), column.activeSet.end());
+            column.activeSet.clear();
+
+            std::ranges::sort(column.updateList);
+
+            for (const auto index : column.updateList)
+                Update(column, index, tick);
+        }
+
+        static void Update(Column& column, const uint16_t index, const uint64_t tick)
+        {
+            const auto iterator = column.cellMap.find(index);
+
+            if (iterator == column.cellMap.end())
+                return;
+
+            const BlockId fluid = iterator->second.fluid;
+            const auto properties = GetProperties(fluid);
+
+            if (tick % properties.interval != 0)
+            {
+                column.activeSet.insert(index);
+                return;
+            }
+
+            column.updatedCount++;
+
+            const int32_t x = index & 15;
+            const int32_t y = index >> 8;
+            const int32_t z = index >> 4 & 15;
+
+            bool moved = false;
+            bool fell = false;
+
+            uint8_t level;
+            bool reaction;
+
+            if (y > 0 && Probe(&column, column.chunk, index - Chunk::Width * Chunk::Width, fluid, level, reaction) && (reaction || level < MaximumLevel))
+            {
+                Move(column, index, x, y - 1, z, fluid, reaction ? 0 : std::min<uint8_t>(iterator->second.level, MaximumLevel - level), reaction);
+
+                moved = true;
+                fell = !reaction;
+            }
+
+            for (size_t offset = 0; !fell && offset < DirectionList.size(); ++offset)
+            {
+                const auto cell = column.cellMap.find(index);
+
+                if (cell == column.cellMap.end())
+                    break;
+
+                const size_t direction = (offset + tick) & 3;
+
+                const int32_t neighbourX = x + DirectionList[direction][0];
+                const int32_t neighbourZ = z + DirectionList[direction][1];
+
+                const bool isInside = neighbourX >= 0 && neighbourX < Chunk::Width && neighbourZ >= 0 && neighbourZ < Chunk::Width;
+
+                const auto neighbourIndex = GetIndex(neighbourX & (Chunk::Width - 1), y, neighbourZ & (Chunk::Width - 1));
+
+                if (!Probe(isInside ? &column : column.neighbourColumnList[direction], isInside ? column.chunk : column.neighbourChunkList[direction], neighbourIndex, fluid, level, reaction))
+                    continue;
+
+                if (reaction)
+                    Move(column, index, neighbourX, y, neighbourZ, fluid, 0, true);
+                else if (cell->second.level >= level + properties.spreadThreshold)
+                    Move(column, index, neighbourX, y, neighbourZ, fluid, static_cast<uint8_t>((cell->second.level - level) / 2), false);
+                else
+                    continue;
+
+                moved = true;
+            }
+
+            if (!moved)
+                return;
+
+            column.movedCount++;
+
+            if (column.cellMap.contains(index))
+                column.activeSet.insert(index);
+        }
+
+        [[nodiscard]]
+        static bool Probe(const Column* column, const Chunk* chunk, const uint16_t index, const BlockId fluid, uint8_t& level, bool& reaction)
+        {
+            level = 0;
+            reaction = false;
+
+            if (!chunk)
+                return false;
+
+            if (column)
+            {
+                if (const auto iterator = column->cellMap.find(index); iterator != column->cellMap.end())
+                {
+                    level = iterator->second.level;
+                    reaction = iterator->second.fluid != fluid;
+
+                    return true;
+                }
+
+                if (const auto iterator = column->blockMap.find(index); iterator != column->blockMap.end())
+                    return iterator->second == AirBlock;
+            }
+
+            const BlockId block = chunk->Get(index & 15, index >> 8, index >> 4 & 15);
+
+            if (IsFluid(block))
+            {
+                level = MaximumLevel;
+                reaction = block != fluid;
+            }
+
+            return block == AirBlock || IsFluid(block);
+        }
+
+        static void Move(Column& column, const uint16_t index, const int32_t targetX, const int32_t targetY, const int32_t targetZ, const BlockId fluid, const uint8_t amount, const bool reaction)
+        {
+            if (amount > 0)
+            {
+                auto& cell = column.cellMap.at(index);
+
+                cell.level -= amount;
+
+                if (cell.level == 0)
+                {
+                    column.cellMap.erase(index);
+                    column.blockMap[index] = AirBlock;
+                }
+            }
+
+            WakeAround(column, index & 15, index >> 8, index >> 4 & 15);
+
+            if (targetX < 0 || targetX >= Chunk::Width || targetZ < 0 || targetZ >= Chunk::Width)
+            {
+                column.outbox.push_back({ column.coordinate.x * Chunk::Width + targetX, targetY, column.coordinate.z * Chunk::Width + targetZ, fluid, amount, reaction });
+                return;
+            }
+
+            Deposit(column, GetIndex(targetX, targetY, targetZ), fluid, amount, reaction);
+
+            WakeAround(column, targetX, targetY, targetZ);
+        }
+
+        static void Deposit(Column& column, const uint16_t index, const BlockId fluid, const uint8_t amount, const bool reaction)
+        {
+            if (reaction)
+            {
+                column.cellMap.erase(index);
+                column.blockMap[index] = StoneBlock;
+                return;
+            }
+
+            if (amount == 0)
+                return;
+
+            const auto [iterator, inserted] = column.cellMap.try_emplace(index, FluidCell{ fluid, 0 });
+
+            iterator->second.level += amount;
+
+            if (inserted)
+                column.blockMap[index] = fluid;
+        }
+
+        static void WakeAround(Column& column, const int32_t x, const int32_t y, const int32_t z)
+        {
+            Wake(column, x, y, z);
+
+            for (const auto& [offsetX, offsetZ] : DirectionList)
+            {
+                if (x + offsetX < 0 || x + offsetX >= Chunk::Width || z + offsetZ < 0 || z + offsetZ >= Chunk::Width)
+                    column.outbox.push_back({ column.coordinate.x * Chunk::Width + x + offsetX, y, column.coordinate.z * Chunk::Width + z + offsetZ, AirBlock, 0, false });
+                else
+                    Wake(column, x + offsetX, y, z + offsetZ);
+            }
+
+            if (y > 0)
+                Wake(column, x, y - 1, z);
+
+            if (y + 1 < Chunk::Height)
+                Wake(column, x, y + 1, z);
+        }
+
+        static void Wake(Column& column, const int32_t x, const int32_t y, const int32_t z)
+        {
+            const auto index = GetIndex(x, y, z);
+
+            if (column.cellMap.contains(index))
+            {
+                column.activeSet.insert(index);
+                return;
+            }
+
+            if (column.blockMap.contains(index) || !column.chunk)
+                return;
+
+            if (const BlockId block = column.chunk->Get(x, y, z); IsFluid(block))
+            {
+                column.cellMap.emplace(index, FluidCell{ block, MaximumLevel });
+                column.activeSet.insert(index);
+            }
+        }
+
+        void WakeAround(const int32_t x, const int32_t y, const int32_t z)
+        {
+            WakeAt(x, y, z);
+
+            for (const auto& [offsetX, offsetZ] : DirectionList)
+                WakeAt(x + offsetX, y, z + offsetZ);
+
+            WakeAt(x, y - 1, z);
+            WakeAt(x, y + 1, z);
+        }
+
+        void WakeAt(const int32_t x, const int32_t y, const int32_t z)
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return;
+
+            const auto coordinate = ChunkCoordinate::FromBlock(x, z);
+            const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+            if (!chunk)
+                return;
+
+            if (!columnMap.contains(coordinate) && !IsFluid(chunk->Get(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1))))
+                return;
+
+            auto& column = GetColumn(coordinate);
+
+            column.chunk = chunk;
+
+            Wake(column, x & (Chunk::Width - 1), y, z & (Chunk::Width - 1));
+        }
+
+        void Apply(const Transfer& transfer)
+        {
+            if (transfer.amount == 0 && !transfer.reaction)
+            {
+                WakeAt(transfer.x, transfer.y, transfer.z);
+                return;
+            }
+
+            const auto coordinate = ChunkCoordinate::FromBlock(transfer.x, transfer.z);
+
+            auto& column = GetColumn(coordinate);
+
+            column.chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+            Deposit(column, GetIndex(transfer.x & (Chunk::Width - 1), transfer.y, transfer.z & (Chunk::Width - 1)), transfer.fluid, transfer.amount, transfer.reaction);
+
+            WakeAround(transfer.x, transfer.y, transfer.z);
+        }
+
+        std::unordered_map<ChunkCoordinate, Column, ChunkCoordinateHash> columnMap;
+        std::vector<Column*> batchList;
+
+        size_t lastUpdatedCount = 0;
+        size_t lastMovedCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<FluidSimulation> instance;
+
+    };
+
+    std::once_flag FluidSimulation::initializationFlag;
+    std::unique_ptr<FluidSimulation> FluidSimulation::instance;
+}
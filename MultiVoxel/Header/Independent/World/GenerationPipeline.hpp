@@ -0,0 +1,295 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Independent/Thread/WorkerPool.hpp"
+#include "Independent/World/TerrainGenerator.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Thread;
+
+namespace MultiVoxel::Independent::World
+{
+    enum class GenerationStage : uint8_t
+    {
+        None,
+        Heightmap,
+        Caves,
+        Decorated
+    };
+
+    class GenerationPipeline final
+    {
+
+    public:
+
+        static constexpr size_t StageCount = 3;
+
+        GenerationPipeline(const uint64_t seed, const size_t threadCount) : generator(seed), workerPool(threadCount) { }
+
+        ~GenerationPipeline()
+        {
+            workerPool.Wait();
+        }
+
+        GenerationPipeline(const GenerationPipeline&) = delete;
+        GenerationPipeline(GenerationPipeline&&) = delete;
+        GenerationPipeline& operator=(const GenerationPipeline&) = delete;
+        GenerationPipeline& operator=(GenerationPipeline&&) = delete;
+
+        void Request(const ChunkCoordinate coordinate)
+        {
+            std::lock_guard lock(mutex);
+
+            Require(coordinate, GenerationStage::Decorated);
+
+            for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                {
+                    if (offsetX != 0 || offsetZ != 0)
+                        Require({ coordinate.x + offsetX, coordinate.z + offsetZ }, GenerationStage::Caves);
+                }
+            }
+        }
+
+        template <typename Function>
+        size_t Collect(Function&& function)
+        {
+            std::vector<std::unique_ptr<Chunk>> readyList;
+
+            {
+                std::lock_guard lock(mutex);
+
+                readyList.swap(completedList);
+            }
+
+            for (auto& chunk : readyList)
+                function(std::move(chunk));
+
+            return readyList.size();
+        }
+
+        void Wait()
+        {
+            workerPool.Wait();
+        }
+
+        [[nodiscard]]
+        size_t GetPendingCount() const
+        {
+            std::lock_guard lock(mutex);
+
+            return pendingCount;
+        }
+
+        [[nodiscard]]
+        size_t GetEntryCount() const
+        {
+            std::lock_guard lock(mutex);
+
+            return entryMap.size();
+        }
+
+        [[nodiscard]]
+        size_t GetThreadCount() const
+        {
+            return workerPool.GetThreadCount();
+        }
+
+        [[nodiscard]]
+        uint64_t GetStageCount(const GenerationStage stage) const
+        {
+            return stageCountList[static_cast<size_t>(stage) - 1];
+        }
+
+        [[nodiscard]]
+        double GetStageSeconds(const GenerationStage stage) const
+        {
+            return static_cast<double>(stageNanosecondList[static_cast<size_t>(stage) - 1]) / 1e9;
+        }
+
+    private:
+
+        struct Entry
+        {
+            std::unique_ptr<Chunk> chunk;
+            SurfaceMap surface;
+
+            GenerationStage stage = GenerationStage::None;
+            GenerationStage target = GenerationStage::None;
+
+            bool running = false;
+        };
+
+        void Require(const ChunkCoordinate coordinate, const GenerationStage target)
+        {
+            auto& entry = entryMap[coordinate];
+
+            if (!entry)
+            {
+                entry = std::make_unique<Entry>();
+                entry->chunk = std::make_unique<Chunk>(coordinate);
+            }
+
+            if (target <= entry->target)
+                return;
+
+            if (target == GenerationStage::Decorated)
+                pendingCount++;
+
+            entry->target = target;
+
+            Schedule(coordinate, *entry);
+        }
+
+        void Schedule(const ChunkCoordinate coordinate, Entry& entry)
+        {
+            if (entry.running || entry.stage >= entry.target)
+                return;
+
+            if (entry.stage == GenerationStage::Caves)
+            {
+                for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+                {
+                    for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                    {
+                        const auto iterator = entryMap.find({ coordinate.x + offsetX, coordinate.z + offsetZ });
+
+                        if (iterator == entryMap.end() || iterator->second->stage < GenerationStage::Caves)
+                            return;
+                    }
+                }
+            }
+
+            entry.running = true;
+
+            workerPool.Submit([this, coordinate]() { Run(coordinate); });
+        }
+
+        void Run(const ChunkCoordinate coordinate)
+        {
+            Entry* entry;
+            std::array<const SurfaceMap*, 9> neighbourhood = { };
+
+            {
+                std::lock_guard lock(mutex);
+
+                entry = entryMap.at(coordinate).get();
+
+                if (entry->stage == GenerationStage::Caves)
+                {
+                    for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+                    {
+                        for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                            neighbourhood[(offsetZ + 1) * 3 + offsetX + 1] = &entryMap.at({ coordinate.x + offsetX, coordinate.z + offsetZ })->surface;
+                    }
+                }
+            }
+
+            const auto stage = static_cast<GenerationStage>(static_cast<uint8_t>(entry->stage) + 1);
+            const auto start = steady_clock::now();
+
+            switch (stage)
+            {
+                case GenerationStage::Heightmap:
+                    generator.GenerateHeightmap(*entry->chunk, entry->surface);
+                    break;
+
+                case GenerationStage::Caves:
+                    generator.GenerateCaves(*entry->chunk, entry->surface);
+                    break;
+
+                default:
+                    generator.GenerateDecorations(*entry->chunk, neighbourhood);
+                    break;
+            }
+
+            stageCountList[static_cast<size_t>(stage) - 1]++;
+            stageNanosecondList[static_cast<size_t>(stage) - 1] += static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+
+            std::lock_guard lock(mutex);
+
+            entry->stage = stage;
+            entry->running = false;
+
+            if (stage == GenerationStage::Decorated)
+            {
+                completedList.push_back(std::move(entry->chunk));
+                pendingCount--;
+
+                ReleaseAround(coordinate);
+                return;
+            }
+
+            Schedule(coordinate, *entry);
+
+            if (stage != GenerationStage::Caves)
+                return;
+
+            for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                {
+                    const ChunkCoordinate neighbour = { coordinate.x + offsetX, coordinate.z + offsetZ };
+
+                    if (const auto iterator = entryMap.find(neighbour); iterator != entryMap.end() && (offsetX != 0 || offsetZ != 0))
+                        Schedule(neighbour, *iterator->second);
+                }
+            }
+        }
+
+        [[nodiscard]]
+        bool IsNeeded(const ChunkCoordinate coordinate, const Entry& entry) const
+        {
+            if (entry.running)
+                return true;
+
+            for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                {
+                    const auto iterator = entryMap.find({ coordinate.x + offsetX, coordinate.z + offsetZ });
+
+                    if (iterator != entryMap.end() && iterator->second->target == GenerationStage::Decorated && iterator->second->stage < GenerationStage::Decorated)
+                        return true;
+                }
+            }
+
+            return false;
+        }
+
+        void ReleaseAround(const ChunkCoordinate coordinate)
+        {
+            for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                {
+                    const ChunkCoordinate candidate = { coordinate.x + offsetX, coordinate.z + offsetZ };
+
+                    if (const auto iterator = entryMap.find(candidate); iterator != entryMap.end() && !IsNeeded(candidate, *iterator->second))
+                        entryMap.erase(iterator);
+                }
+            }
+        }
+
+        TerrainGenerator generator;
+
+        mutable std::mutex mutex;
+
+        std::unordered_map<ChunkCoordinate, std::unique_ptr<Entry>, ChunkCoordinateHash> entryMap;
+        std::vector<std::unique_ptr<Chunk>> completedList;
+        size_t pendingCount = 0;
+
+        std::array<std::atomic<uint64_t>, StageCount> stageCountList = { };
+        std::array<std::atomic<uint64_t>, StageCount> stageNanosecondList = { };
+
+        WorkerPool workerPool;
+
+    };
+}
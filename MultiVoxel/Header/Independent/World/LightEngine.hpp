@@ -0,0 +1,511 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Independent/World/Block.hpp"
+#include "Independent/World/ChunkManager.hpp"
+
+namespace MultiVoxel::Independent::World
+{
+    enum class LightChannel : uint8_t
+    {
+        Block,
+        Sky
+    };
+
+    class LightEngine final
+    {
+
+    public:
+
+        LightEngine(const LightEngine&) = delete;
+        LightEngine(LightEngine&&) = delete;
+        LightEngine& operator=(const LightEngine&) = delete;
+        LightEngine& operator=(LightEngine&&) = delete;
+
+        [[nodiscard]]
+        static uint8_t GetChannel(const uint8_t light, const LightChannel channel)
+        {
+            return channel == LightChannel::Sky ? light >> 4 : light & 0x0F;
+        }
+
+        [[nodiscard]]
+        static uint8_t SetChannel(const uint8_t light, const LightChannel channel, const uint8_t level)
+        {
+            return channel == LightChannel::Sky ? static_cast<uint8_t>((light & 0x0F) | level << 4) : static_cast<uint8_t>((light & 0xF0) | level);
+        }
+
+        [[nodiscard]]
+        uint8_t GetLight(const int32_t x, const int32_t y, const int32_t z, const LightChannel channel)
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return channel == LightChannel::Sky && y >= Chunk::Height ? MaximumLight : 0;
+
+            const auto chunk = ChunkManager::GetInstance().GetChunk(ChunkCoordinate::FromBlock(x, z));
+
+            return chunk ? GetChannel(chunk->GetLight(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1)), channel) : 0;
+        }
+
+        void InitializeChunk(Chunk& chunk)
+        {
+            BeginUpdate();
+
+            const auto coordinate = chunk.GetCoordinate();
+            const int32_t baseX = coordinate.x * Chunk::Width;
+            const int32_t baseZ = coordinate.z * Chunk::Width;
+
+            std::array<int16_t, Chunk::Width * Chunk::Width> topList;
+
+            for (int32_t z = 0; z < Chunk::Width; ++z)
+            {
+                for (int32_t x = 0; x < Chunk::Width; ++x)
+                    topList[z * Chunk::Width + x] = static_cast<int16_t>(GetSkyTop(chunk, x, z));
+            }
+
+            const auto [minimum, maximum] = std::ranges::minmax(topList);
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                const int32_t bottom = sectionIndex * ChunkSection::Size;
+
+                auto& section = chunk.GetSection(sectionIndex);
+
+                if (bottom >= maximum)
+                    section.FillLight(MaximumLight << 4);
+                else if (bottom + ChunkSection::Size <= minimum)
+                    section.FillLight(0);
+                else
+                {
+                    for (int32_t y = 0; y < ChunkSection::Size; ++y)
+                    {
+                        for (int32_t z = 0; z < Chunk::Width; ++z)
+                        {
+                            for (int32_t x = 0; x < Chunk::Width; ++x)
+                                section.SetLight(x, y, z, bottom + y >= topList[z * Chunk::Width + x] ? MaximumLight << 4 : 0);
+                        }
+                    }
+                }
+            }
+
+            for (int32_t z = 0; z < Chunk::Width; ++z)
+            {
+                for (int32_t x = 0; x < Chunk::Width; ++x)
+                {
+                    const int32_t top = topList[z * Chunk::Width + x];
+
+                    int32_t upper = top + 1;
+
+                    for (const auto& [offsetX, offsetY, offsetZ] : HorizontalOffsetList)
+                    {
+                        const int32_t neighbourX = x + offsetX;
+                        const int32_t neighbourZ = z + offsetZ;
+
+                        if (neighbourX >= 0 && neighbourX < Chunk::Width && neighbourZ >= 0 && neighbourZ < Chunk::Width)
+                            upper = std::max<int32_t>(upper, topList[neighbourZ * Chunk::Width + neighbourX]);
+                        else if (const auto neighbour = FindChunk(baseX + neighbourX, baseZ + neighbourZ))
+                            upper = std::max(upper, GetSkyTop(*neighbour, neighbourX & (Chunk::Width - 1), neighbourZ & (Chunk::Width - 1)));
+                    }
+
+                    for (int32_t y = top; y < std::min(upper, Chunk::Height); ++y)
+                        Enqueue(LightChannel::Sky, baseX + x, y, baseZ + z);
+                }
+            }
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                const auto& section = chunk.GetSection(sectionIndex);
+
+                if (section.IsUniform() && GetLightEmission(section.GetUniformBlock()) == 0)
+                    continue;
+
+                for (int32_t y = 0; y < ChunkSection::Size; ++y)
+                {
+                    for (int32_t z = 0; z < Chunk::Width; ++z)
+                    {
+                        for (int32_t x = 0; x < Chunk::Width; ++x)
+                        {
+                            if (const uint8_t emission = GetLightEmission(section.Get(x, y, z)); emission > 0)
+                            {
+                                const int32_t worldY = sectionIndex * ChunkSection::Size + y;
+
+                                Write(chunk, x, worldY, z, LightChannel::Block, emission);
+                                Enqueue(LightChannel::Block, baseX + x, worldY, baseZ + z);
+                            }
+                        }
+                    }
+                }
+            }
+
+            for (const auto& [offsetX, offsetY, offsetZ] : HorizontalOffsetList)
+            {
+                const auto neighbour = ChunkManager::GetInstance().GetChunk({ coordinate.x + offsetX, coordinate.z + offsetZ });
+
+                if (!neighbour)
+                    continue;
+
+                for (int32_t step = 0; step < Chunk::Width; ++step)
+                {
+                    const int32_t localX = offsetX == 0 ? step : offsetX < 0 ? Chunk::Width - 1 : 0;
+                    const int32_t localZ = offsetZ == 0 ? step : offsetZ < 0 ? Chunk::Width - 1 : 0;
+
+                    for (int32_t y = 0; y < Chunk::Height; ++y)
+                    {
+                        const uint8_t light = neighbour->GetLight(localX, y, localZ);
+
+                        if (GetChannel(light, LightChannel::Sky) > 1)
+                            Enqueue(LightChannel::Sky, baseX + offsetX * Chunk::Width + localX, y, baseZ + offsetZ * Chunk::Width + localZ);
+
+                        if (GetChannel(light, LightChannel::Block) > 1)
+                            Enqueue(LightChannel::Block, baseX + offsetX * Chunk::Width + localX, y, baseZ + offsetZ * Chunk::Width + localZ);
+                    }
+                }
+            }
+
+            Propagate();
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+                chunk.GetSection(sectionIndex).CompactLight();
+
+            EndUpdate();
+        }
+
+        bool SetBlock(const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            const BlockId previous = ChunkManager::GetInstance().GetBlock(x, y, z);
+
+            if (!ChunkManager::GetInstance().SetBlock(x, y, z, block))
+                return false;
+
+            OnBlockChanged(x, y, z, previous, block);
+
+            return true;
+        }
+
+        void OnBlockChanged(const int32_t x, const int32_t y, const int32_t z, const BlockId previous, const BlockId current)
+        {
+            BeginUpdate();
+
+            Seed(x, y, z, previous, current);
+            Propagate();
+
+            EndUpdate();
+        }
+
+        template <typename Range>
+        void OnBlocksChanged(const Range& changeList)
+        {
+            BeginUpdate();
+
+            for (const auto& change : changeList)
+                Seed(change.x, change.y, change.z, change.previous, change.current);
+
+            Propagate();
+
+            EndUpdate();
+        }
+
+        [[nodiscard]]
+        uint64_t GetLastRelitCount() const
+        {
+            return lastRelitCount;
+        }
+
+        [[nodiscard]]
+        uint64_t GetTotalRelitCount() const
+        {
+            return totalRelitCount;
+        }
+
+        static LightEngine& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<LightEngine>(new LightEngine());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct Offset
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+        };
+
+        struct Node
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+        };
+
+        struct RemovalNode
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+
+            uint8_t level;
+        };
+
+        static constexpr std::array<Offset, 6> OffsetList = { { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 0, 1, 0 }, { 0, -1, 0 } } };
+        static constexpr std::array<Offset, 4> HorizontalOffsetList = { { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 0, 1 }, { 0, 0, -1 } } };
+
+        LightEngine() = default;
+
+        [[nodiscard]]
+        static int32_t GetSkyTop(const Chunk& chunk, const int32_t x, const int32_t z)
+        {
+            for (int32_t sectionIndex = Chunk::SectionCount - 1; sectionIndex >= 0; --sectionIndex)
+            {
+                const auto& section = chunk.GetSection(sectionIndex);
+
+                if (section.IsUniform() && GetLightOpacity(section.GetUniformBlock()) == 0)
+                    continue;
+
+                for (int32_t y = ChunkSection::Size - 1; y >= 0; --y)
+                {
+                    if (GetLightOpacity(section.Get(x, y, z)) != 0)
+                        return sectionIndex * ChunkSection::Size + y + 1;
+                }
+            }
+
+            return 0;
+        }
+
+        void Seed(const int32_t x, const int32_t y, const int32_t z, const BlockId previous, const BlockId current)
+        {
+            const auto chunk = FindChunk(x, z);
+
+            if (!chunk)
+                return;
+
+            const int32_t localX = x & (Chunk::Width - 1);
+            const int32_t localZ = z & (Chunk::Width - 1);
+
+            const uint8_t previousOpacity = GetLightOpacity(previous);
+            const uint8_t currentOpacity = GetLightOpacity(current);
+            const uint8_t emission = GetLightEmission(current);
+
+            const uint8_t blockLight = GetChannel(chunk->GetLight(localX, y, localZ), LightChannel::Block);
+
+            if (blockLight > emission && (currentOpacity > previousOpacity || GetLightEmission(previous) > emission))
+            {
+                Write(*chunk, localX, y, localZ, LightChannel::Block, 0);
+                removeQueueList[static_cast<size_t>(LightChannel::Block)].push_back({ x, y, z, blockLight });
+            }
+
+            if (emission > GetChannel(chunk->GetLight(localX, y, localZ), LightChannel::Block))
+            {
+                Write(*chunk, localX, y, localZ, LightChannel::Block, emission);
+                Enqueue(LightChannel::Block, x, y, z);
+            }
+
+            const uint8_t skyLight = GetChannel(chunk->GetLight(localX, y, localZ), LightChannel::Sky);
+
+            if (skyLight > 0 && currentOpacity > previousOpacity)
+            {
+                Write(*chunk, localX, y, localZ, LightChannel::Sky, 0);
+                removeQueueList[static_cast<size_t>(LightChannel::Sky)].push_back({ x, y, z, skyLight });
+            }
+
+            if (currentOpacity < previousOpacity)
+            {
+                for (const auto& [offsetX, offsetY, offsetZ] : OffsetList)
+                {
+                    Enqueue(LightChannel::Block, x + offsetX, y + offsetY, z + offsetZ);
+                    Enqueue(LightChannel::Sky, x + offsetX, y + offsetY, z + offsetZ);
+                }
+
+                if (y + 1 == Chunk::Height && currentOpacity == 0)
+                {
+                    Write(*chunk, localX, y, localZ, LightChannel::Sky, MaximumLight);
+                    Enqueue(LightChannel::Sky, x, y, z);
+                }
+            }
+        }
+
+
+        void BeginUpdate()
+        {
+            cachedChunk = nullptr;
+            lastRelitCount = 0;
+        }
+
+        void EndUpdate()
+        {
+            cachedChunk = nullptr;
+            totalRelitCount += lastRelitCount;
+        }
+
+        Chunk* FindChunk(const int32_t x, const int32_t z)
+        {
+            const auto coordinate = ChunkCoordinate::FromBlock(x, z);
+
+            if (!cachedChunk || coordinate != cachedCoordinate)
+            {
+                cachedChunk = ChunkManager::GetInstance().GetChunk(coordinate);
+                cachedCoordinate = coordinate;
+            }
+
+            return cachedChunk;
+        }
+
+        void Write(Chunk& chunk, const int32_t x, const int32_t y, const int32_t z, const LightChannel channel, const uint8_t level)
+        {
+            if (chunk.SetLight(x, y, z, SetChannel(chunk.GetLight(x, y, z), channel, level)))
+                lastRelitCount++;
+        }
+
+        void Enqueue(const LightChannel channel, const int32_t x, const int32_t y, const int32_t z)
+        {
+            if (y >= 0 && y < Chunk::Height)
+                addQueueList[static_cast<size_t>(channel)].push_back({ x, y, z });
+        }
+
+        void Propagate()
+        {
+            for (const auto channel : { LightChannel::Block, LightChannel::Sky })
+            {
+                PropagateRemoval(channel);
+                PropagateAddition(channel);
+            }
+        }
+
+        void PropagateRemoval(const LightChannel channel)
+        {
+            auto& queue = removeQueueList[static_cast<size_t>(channel)];
+
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                const auto [x, y, z, level] = queue[head];
+
+                for (const auto& [offsetX, offsetY, offsetZ] : OffsetList)
+                {
+                    const int32_t neighbourX = x + offsetX;
+                    const int32_t neighbourY = y + offsetY;
+                    const int32_t neighbourZ = z + offsetZ;
+
+                    if (neighbourY < 0 || neighbourY >= Chunk::Height)
+                        continue;
+
+                    const auto chunk = FindChunk(neighbourX, neighbourZ);
+
+                    if (!chunk)
+                        continue;
+
+                    const int32_t localX = neighbourX & (Chunk::Width - 1);
+                    const int32_t localZ = neighbourZ & (Chunk::Width - 1);
+
+                    const uint8_t neighbourLevel = GetChannel(chunk->GetLight(localX, neighbourY, localZ), channel);
+
+                    if (neighbourLevel == 0)
+                        continue;
+
+                    const bool sunlitBelow = channel == LightChannel::Sky && offsetY < 0 && level == MaximumLight && neighbourLevel == MaximumLight;
+
+                    if (neighbourLevel < level || sunlitBelow)
+                    {
+                        Write(*chunk, localX, neighbourY, localZ, channel, 0);
+                        queue.push_back({ neighbourX, neighbourY, neighbourZ, neighbourLevel });
+
+                        if (const uint8_t emission = GetLightEmission(chunk->Get(localX, neighbourY, localZ)); channel == LightChannel::Block && emission > 0)
+                        {
+                            Write(*chunk, localX, neighbourY, localZ, channel, emission);
+                            Enqueue(channel, neighbourX, neighbourY, neighbourZ);
+                        }
+                    }
+                    else
+                        Enqueue(channel, neighbourX, neighbourY, neighbourZ);
+                }
+            }
+
+            queue.clear();
+        }
+
+        void PropagateAddition(const LightChannel channel)
+        {
+            auto& queue = addQueueList[static_cast<size_t>(channel)];
+
+            for (size_t head = 0; head < queue.size(); ++head)
+            {
+                const auto [x, y, z] = queue[head];
+
+                const auto source = FindChunk(x, z);
+
+                if (!source)
+                    continue;
+
+                const uint8_t level = GetChannel(source->GetLight(x & (Chunk::Width - 1), y, z & (Chunk::Width - 1)), channel);
+
+                if (level <= 1)
+                    continue;
+
+                for (const auto& [offsetX, offsetY, offsetZ] : OffsetList)
+                {
+                    const int32_t neighbourX = x + offsetX;
+                    const int32_t neighbourY = y + offsetY;
+                    const int32_t neighbourZ = z + offsetZ;
+
+                    if (neighbourY < 0 || neighbourY >= Chunk::Height)
+                        continue;
+
+                    const auto chunk = FindChunk(neighbourX, neighbourZ);
+
+                    if (!chunk)
+                        continue;
+
+                    const int32_t localX = neighbourX & (Chunk::Width - 1);
+                    const int32_t localZ = neighbourZ & (Chunk::Width - 1);
+
+                    const uint8_t opacity = GetLightOpacity(chunk->Get(localX, neighbourY, localZ));
+
+                    if (opacity >= MaximumLight)
+                        continue;
+
+                    const uint8_t attenuation = std::max<uint8_t>(opacity, 1);
+
+                    uint8_t next;
+
+                    if (channel == LightChannel::Sky && offsetY < 0 && level == MaximumLight && opacity == 0)
+                        next = MaximumLight;
+                    else if (level > attenuation)
+                        next = static_cast<uint8_t>(level - attenuation);
+                    else
+                        continue;
+
+                    if (GetChannel(chunk->GetLight(localX, neighbourY, localZ), channel) >= next)
+                        continue;
+
+                    Write(*chunk, localX, neighbourY, localZ, channel, next);
+                    queue.push_back({ neighbourX, neighbourY, neighbourZ });
+                }
+            }
+
+            queue.clear();
+        }
+
+        std::array<std::vector<Node>, 2> addQueueList;
+        std::array<std::vector<RemovalNode>, 2> removeQueueList;
+
+        Chunk* cachedChunk = nullptr;
+        ChunkCoordinate cachedCoordinate;
+
+        uint64_t lastRelitCount = 0;
+        uint64_t totalRelitCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<LightEngine> instance;
+
+    };
+
+    std::once_flag LightEngine::initializationFlag;
+    std::unique_ptr<LightEngine> LightEngine::instance;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Independent/Math/Vector.hpp"
+#include "Independent/World/Brickmap.hpp"
+
+using namespace MultiVoxel::Independent::Math;
+
+namespace MultiVoxel::Independent::World
+{
+    struct LodVertex
+    {
+        Vector<float, 3> position;
+        Vector<float, 3> normal;
+
+        BlockId block = AirBlock;
+    };
+
+    struct LodMesh
+    {
+        std::vector<LodVertex> vertexList;
+        std::vector<uint32_t> indexList;
+
+        int32_t level = 0;
+
+        [[nodiscard]]
+        size_t GetTriangleCount() const
+        {
+            return indexList.size() / 3;
+        }
+    };
+
+    class LodMesher final
+    {
+
+    public:
+
+        static constexpr int32_t LevelCount = 4;
+
+        LodMesher() = default;
+
+        LodMesher(const LodMesher&) = delete;
+        LodMesher(LodMesher&&) = delete;
+        LodMesher& operator=(const LodMesher&) = delete;
+        LodMesher& operator=(LodMesher&&) = delete;
+
+        void Generate(const BrickmapStore& store, const ChunkCoordinate coordinate, const int32_t level, const std::array<int32_t, 4>& neighbourLevelList, LodMesh& mesh)
+        {
+            mesh.vertexList.clear();
+            mesh.indexList.clear();
+            mesh.level = level;
+
+            if (!store.Extract(coordinate, level, cellList))
+                return;
+
+            for (size_t face = 0; face < neighbourLevelList.size(); ++face)
+            {
+                const auto& direction = FaceList[face].direction;
+
+                if (neighbourLevelList[face] < 0 || !store.Extract({ coordinate.x + direction[0], coordinate.z + direction[2] }, neighbourLevelList[face], neighbourCellList[face]))
+                    neighbourCellList[face].clear();
+            }
+
+            const int32_t width = BrickmapStore::GetLevelWidth(level);
+            const int32_t height = BrickmapStore::GetLevelHeight(level);
+
+            for (int32_t y = 0; y < height; ++y)
+            {
+                for (int32_t z = 0; z < width; ++z)
+                {
+                    for (int32_t x = 0; x < width; ++x)
+                    {
+                        const BlockId block = cellList[BrickmapStore::GetCellIndex(level, x, y, z)];
+
+                        if (block == AirBlock)
+                            continue;
+
+                        for (size_t face = 0; face < FaceList.size(); ++face)
+                        {
+                            const auto& direction = FaceList[face].direction;
+
+                            const int32_t neighbourX = x + direction[0];
+                            const int32_t neighbourY = y + direction[1];
+                            const int32_t neighbourZ = z + direction[2];
+
+                            bool open;
+
+                            if (neighbourY < 0)
+                                open = false;
+                            else if (neighbourY >= height)
+                                open = true;
+                            else if (neighbourX >= 0 && neighbourX < width && neighbourZ >= 0 && neighbourZ < width)
+                                open = cellList[BrickmapStore::GetCellIndex(level, neighbourX, neighbourY, neighbourZ)] == AirBlock;
+                            else
+                                open = IsBorderOpen(face, level, neighbourLevelList[face], x, y, z);
+
+                            if (open)
+                                Emit(mesh, face, level, x, y, z, block);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+
+        struct Face
+        {
+            std::array<int32_t, 3> direction;
+            std::array<std::array<float, 3>, 4> cornerList;
+        };
+
+        static constexpr std::array<Face, 6> FaceList =
+        { {
+            { { 1, 0, 0 }, { { { 1, 0, 0 }, { 1, 1, 0 }, { 1, 1, 1 }, { 1, 0, 1 } } } },
+            { { -1, 0, 0 }, { { { 0, 0, 0 }, { 0, 0, 1 }, { 0, 1, 1 }, { 0, 1, 0 } } } },
+            { { 0, 0, 1 }, { { { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } } } },
+            { { 0, 0, -1 }, { { { 0, 0, 0 }, { 0, 1, 0 }, { 1, 1, 0 }, { 1, 0, 0 } } } },
+            { { 0, 1, 0 }, { { { 0, 1, 0 }, { 0, 1, 1 }, { 1, 1, 1 }, { 1, 1, 0 } } } },
+            { { 0, -1, 0 }, { { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 0, 1 }, { 0, 0, 1 } } } }
+        } };
+
+        bool IsBorderOpen(const size_t face, const int32_t level, const int32_t neighbourLevel, const int32_t x, const int32_t y, const int32_t z) const
+        {
+            const auto& neighbourCells = neighbourCellList[face];
+
+            if (neighbourCells.empty())
+                return false;
+
+            const auto& direction = FaceList[face].direction;
+
+            const int32_t neighbourWidth = BrickmapStore::GetLevelWidth(neighbourLevel);
+            const int32_t first = (direction[0] != 0 ? z : x) << level >> neighbourLevel;
+            const int32_t last = ((((direction[0] != 0 ? z : x) + 1) << level) - 1) >> neighbourLevel;
+            const int32_t bottom = y << level >> neighbourLevel;
+            const int32_t top = (((y + 1) << level) - 1) >> neighbourLevel;
+            const int32_t edge = direction[0] + direction[2] > 0 ? 0 : neighbourWidth - 1;
+
+            for (int32_t neighbourY = bottom; neighbourY <= top; ++neighbourY)
+            {
+                for (int32_t along = first; along <= last; ++along)
+                {
+                    const size_t index = direction[0] != 0 ? BrickmapStore::GetCellIndex(neighbourLevel, edge, neighbourY, along) : BrickmapStore::GetCellIndex(neighbourLevel, along, neighbourY, edge);
+
+                    if (neighbourCells[index] == AirBlock)
+                        return true;
+                }
+            }
+
+            return false;
+        }
+
+        static void Emit(LodMesh& mesh, const size_t face, const int32_t level, const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            const auto& [direction, cornerList] = FaceList[face];
+
+            const float size = static_cast<float>(1 << level);
+            const auto base = static_cast<uint32_t>(mesh.vertexList.size());
+
+            for (const auto& corner : cornerList)
+            {
+                LodVertex vertex;
+
+                vertex.position = { (static_cast<float>(x) + corner[0]) * size, (static_cast<float>(y) + corner[1]) * size, (static_cast<float>(z) + corner[2]) * size };
+                vertex.normal = { static_cast<float>(direction[0]), static_cast<float>(direction[1]), static_cast<float>(direction[2]) };
+                vertex.block = block;
+
+                mesh.vertexList.push_back(vertex);
+            }
+
+            mesh.indexList.insert(mesh.indexList.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+
+        std::vector<BlockId> cellList;
+        std::array<std::vector<BlockId>, 4> neighbourCellList;
+
+    };
+}
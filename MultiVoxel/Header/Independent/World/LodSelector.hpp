@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Independent/Math/Vector.hpp"
+#include "Independent/World/LodMesher.hpp"
+
+using namespace MultiVoxel::Independent::Math;
+
+namespace MultiVoxel::Independent::World
+{
+    class LodSelector final
+    {
+
+    public:
+
+        explicit LodSelector(const float baseDistance = 4.0f, const float hysteresis = 0.5f) : baseDistance(baseDistance), hysteresis(hysteresis) { }
+
+        LodSelector(const LodSelector&) = delete;
+        LodSelector(LodSelector&&) = delete;
+        LodSelector& operator=(const LodSelector&) = delete;
+        LodSelector& operator=(LodSelector&&) = delete;
+
+        [[nodiscard]]
+        static int32_t GetLevelForDistance(const float distance, const float baseDistance)
+        {
+            int32_t level = 0;
+
+            for (float threshold = baseDistance; level < LodMesher::LevelCount - 1 && distance >= threshold; threshold *= 2.0f)
+                level++;
+
+            return level;
+        }
+
+        const std::vector<ChunkCoordinate>& Update(const Vector<float, 3>& position, const int32_t radius)
+        {
+            remeshSet.clear();
+
+            const float cameraX = position[0] / static_cast<float>(Chunk::Width);
+            const float cameraZ = position[2] / static_cast<float>(Chunk::Width);
+
+            const auto center = ChunkCoordinate::FromBlock(static_cast<int32_t>(std::floor(position[0])), static_cast<int32_t>(std::floor(position[2])));
+
+            std::erase_if(levelMap, [&](const auto& pair)
+            {
+                const auto& [coordinate, level] = pair;
+
+                if (IsInside(coordinate, center, radius))
+                    return false;
+
+                MarkNeighbours(coordinate);
+
+                return true;
+            });
+
+            for (int32_t z = center.z - radius; z <= center.z + radius; ++z)
+            {
+                for (int32_t x = center.x - radius; x <= center.x + radius; ++x)
+                {
+                    const ChunkCoordinate coordinate = { x, z };
+
+                    if (!IsInside(coordinate, center, radius))
+                        continue;
+
+                    const float distance = std::hypot(static_cast<float>(x) + 0.5f - cameraX, static_cast<float>(z) + 0.5f - cameraZ);
+
+                    const auto [iterator, inserted] = levelMap.try_emplace(coordinate, GetLevelForDistance(distance, baseDistance));
+
+                    if (!inserted)
+                    {
+                        const int32_t nearest = GetLevelForDistance(distance - hysteresis, baseDistance);
+                        const int32_t farthest = GetLevelForDistance(distance + hysteresis, baseDistance);
+
+                        if (iterator->second >= nearest && iterator->second <= farthest)
+                            continue;
+
+                        iterator->second = GetLevelForDistance(distance, baseDistance);
+                    }
+
+                    remeshSet.insert(coordinate);
+
+                    MarkNeighbours(coordinate);
+                }
+            }
+
+            std::erase_if(remeshSet, [&](const ChunkCoordinate coordinate) { return !levelMap.contains(coordinate); });
+
+            remeshList.assign(remeshSet.begin(), remeshSet.end());
+
+            return remeshList;
+        }
+
+        [[nodiscard]]
+        int32_t GetLevel(const ChunkCoordinate coordinate) const
+        {
+            const auto iterator = levelMap.find(coordinate);
+
+            return iterator == levelMap.end() ? -1 : iterator->second;
+        }
+
+        [[nodiscard]]
+        std::array<int32_t, 4> GetNeighbourLevelList(const ChunkCoordinate coordinate) const
+        {
+            return
+            {
+                GetLevel({ coordinate.x + 1, coordinate.z }),
+                GetLevel({ coordinate.x - 1, coordinate.z }),
+                GetLevel({ coordinate.x, coordinate.z + 1 }),
+                GetLevel({ coordinate.x, coordinate.z - 1 })
+            };
+        }
+
+        template <typename Function>
+        void ForEach(Function&& function) const
+        {
+            for (const auto& [coordinate, level] : levelMap)
+                function(coordinate, level);
+        }
+
+        [[nodiscard]]
+        size_t GetChunkCount() const
+        {
+            return levelMap.size();
+        }
+
+    private:
+
+        [[nodiscard]]
+        static bool IsInside(const ChunkCoordinate coordinate, const ChunkCoordinate center, const int32_t radius)
+        {
+            const int32_t x = coordinate.x - center.x;
+            const int32_t z = coordinate.z - center.z;
+
+            return x * x + z * z <= radius * radius;
+        }
+
+        void MarkNeighbours(const ChunkCoordinate coordinate)
+        {
+            for (const auto neighbour : { ChunkCoordinate{ coordinate.x + 1, coordinate.z }, ChunkCoordinate{ coordinate.x - 1, coordinate.z }, ChunkCoordinate{ coordinate.x, coordinate.z + 1 }, ChunkCoordinate{ coordinate.x, coordinate.z - 1 } })
+            {
+                if (levelMap.contains(neighbour))
+                    remeshSet.insert(neighbour);
+            }
+        }
+
+        float baseDistance;
+        float hysteresis;
+
+        std::unordered_map<ChunkCoordinate, int32_t, ChunkCoordinateHash> levelMap;
+        std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> remeshSet;
+        std::vector<ChunkCoordinate> remeshList;
+
+    };
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include "Independent/Utility/LzCodec.hpp"
+#include "Independent/Utility/MappedFile.hpp"
+#include "Independent/World/Chunk.hpp"
+
+using namespace MultiVoxel::Independent::Utility;
+
+namespace MultiVoxel::Independent::World
+{
+    class RegionFile final
+    {
+
+    public:
+
+        static constexpr int32_t Size = 32;
+        static constexpr size_t EntryCount = Size * Size;
+        static constexpr size_t SectorSize = 4096;
+        static constexpr size_t MaximumSectorCount = 255;
+
+        RegionFile() = default;
+
+        RegionFile(const RegionFile&) = delete;
+        RegionFile(RegionFile&&) = delete;
+        RegionFile& operator=(const RegionFile&) = delete;
+        RegionFile& operator=(RegionFile&&) = delete;
+
+        [[nodiscard]]
+        static ChunkCoordinate GetRegionCoordinate(const ChunkCoordinate coordinate)
+        {
+            return { coordinate.x >> 5, coordinate.z >> 5 };
+        }
+
+        [[nodiscard]]
+        static std::string GetFileName(const ChunkCoordinate regionCoordinate)
+        {
+            return std::format("r.{}.{}.mvr", regionCoordinate.x, regionCoordinate.z);
+        }
+
+        bool Open(const std::filesystem::path& path)
+        {
+            std::unique_lock lock(mutex);
+
+            if (!file.Open(path))
+                return false;
+
+            if (file.GetSize() < SectorSize)
+            {
+                const std::array<uint8_t, SectorSize> header = { };
+
+                if (!file.Write(0, header.data(), header.size()) || !file.Remap())
+                {
+                    std::cerr << "Failed to initialize region file '" << path.string() << "'.\n";
+                    return false;
+                }
+            }
+
+            std::memcpy(offsetTable.data(), file.GetData(), sizeof(offsetTable));
+
+            sectorUsage.assign((file.GetSize() + SectorSize - 1) / SectorSize, false);
+            sectorUsage[0] = true;
+
+            for (auto& entry : offsetTable)
+            {
+                if (entry == 0)
+                    continue;
+
+                const size_t sector = entry >> 8;
+                const size_t count = entry & 0xFF;
+
+                if (sector == 0 || count == 0 || sector + count > sectorUsage.size())
+                {
+                    std::cerr << "Region file '" << path.string() << "' has a corrupt offset entry, discarding it.\n";
+                    entry = 0;
+                    continue;
+                }
+
+                std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(sector), count, true);
+            }
+
+            return true;
+        }
+
+        bool Read(const ChunkCoordinate coordinate, std::vector<uint8_t>& out) const
+        {
+            std::shared_lock lock(mutex);
+
+            const uint32_t entry = offsetTable[GetIndex(coordinate)];
+
+            if (entry == 0)
+                return false;
+
+            const size_t offset = (entry >> 8) * SectorSize;
+            const size_t capacity = (entry & 0xFF) * SectorSize;
+
+            if (offset + capacity > file.GetSize())
+                return false;
+
+            const uint8_t* cursor = file.GetData() + offset;
+
+            EntryHeader header;
+
+            std::memcpy(&header, cursor, sizeof(header));
+
+            if (header.length > capacity - sizeof(header))
+            {
+                std::cerr << "Chunk (" << coordinate.x << ", " << coordinate.z << ") overruns its region sectors.\n";
+                return false;
+            }
+
+            cursor += sizeof(header);
+
+            if (header.encoding == RawEncoding)
+            {
+                out.assign(cursor, cursor + header.length);
+                return true;
+            }
+
+            return LzCodec::Decompress(nullptr, 0, cursor, header.length, header.originalSize, out);
+        }
+
+        bool Write(const ChunkCoordinate coordinate, const uint8_t* data, const size_t size)
+        {
+            std::vector<uint8_t> compressed;
+
+            LzCodec::Compress(nullptr, 0, data, size, compressed);
+
+            const bool isCompressed = compressed.size() < size;
+            const EntryHeader header{ static_cast<uint32_t>(isCompressed ? compressed.size() : size), isCompressed ? LzEncoding : RawEncoding, static_cast<uint32_t>(size) };
+
+            std::vector<uint8_t> payload(reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+
+            if (isCompressed)
+                payload.insert(payload.end(), compressed.begin(), compressed.end());
+            else
+                payload.insert(payload.end(), data, data + size);
+
+            payload.resize((payload.size() + SectorSize - 1) / SectorSize * SectorSize);
+
+            const size_t count = payload.size() / SectorSize;
+
+            if (count > MaximumSectorCount)
+            {
+                std::cerr << "Chunk (" << coordinate.x << ", " << coordinate.z << ") needs " << count << " sectors, which exceeds the region limit.\n";
+                return false;
+            }
+
+            std::unique_lock lock(mutex);
+
+            const size_t index = GetIndex(coordinate);
+            const uint32_t previous = offsetTable[index];
+            const size_t sector = Allocate(count);
+
+            if (!file.Write(static_cast<uint64_t>(sector) * SectorSize, payload.data(), payload.size()))
+            {
+                std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(sector), count, false);
+                return false;
+            }
+
+            const auto entry = static_cast<uint32_t>(sector << 8 | count);
+
+            if (!file.Write(index * sizeof(uint32_t), &entry, sizeof(uint32_t)))
+            {
+                std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(sector), count, false);
+                return false;
+            }
+
+            offsetTable[index] = entry;
+
+            if (previous != 0)
+                std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(previous >> 8), previous & 0xFF, false);
+
+            if ((sector + count) * SectorSize > file.GetSize())
+                return file.Remap();
+
+            return true;
+        }
+
+        [[nodiscard]]
+        bool Contains(const ChunkCoordinate coordinate) const
+        {
+            std::shared_lock lock(mutex);
+
+            return offsetTable[GetIndex(coordinate)] != 0;
+        }
+
+        void Flush()
+        {
+            std::unique_lock lock(mutex);
+
+            file.Flush();
+        }
+
+    private:
+
+        static constexpr uint8_t RawEncoding = 0;
+        static constexpr uint8_t LzEncoding = 1;
+
+#pragma pack(push, 1)
+        struct EntryHeader
+        {
+            uint32_t length = 0;
+            uint8_t encoding = RawEncoding;
+            uint32_t originalSize = 0;
+        };
+#pragma pack(pop)
+
+        [[nodiscard]]
+        static size_t GetIndex(const ChunkCoordinate coordinate)
+        {
+            return static_cast<size_t>(coordinate.x & (Size - 1)) + static_cast<size_t>(coordinate.z & (Size - 1)) * Size;
+        }
+
+        size_t Allocate(const size_t count)
+        {
+            size_t run = 0;
+
+            for (size_t sector = 1; sector < sectorUsage.size(); ++sector)
+            {
+                run = sectorUsage[sector] ? 0 : run + 1;
+
+                if (run == count)
+                {
+                    std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(sector + 1 - count), count, true);
+                    return sector + 1 - count;
+                }
+            }
+
+            const size_t result = sectorUsage.size() - run;
+
+            sectorUsage.resize(result + count, false);
+            std::fill_n(sectorUsage.begin() + static_cast<std::ptrdiff_t>(result), count, true);
+
+            return result;
+        }
+
+        mutable std::shared_mutex mutex;
+
+        MappedFile file;
+
+        std::array<uint32_t, EntryCount> offsetTable = { };
+        std::vector<bool> sectorUsage;
+
+    };
+}
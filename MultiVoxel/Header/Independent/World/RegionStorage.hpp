@@ -0,0 +1,309 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+#include "Independent/Thread/SpscRingBuffer.hpp"
+#include "Independent/World/ChunkManager.hpp"
+#include "Independent/World/RegionFile.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Thread;
+
+namespace MultiVoxel::Independent::World
+{
+    class RegionStorage final
+    {
+
+    public:
+
+        RegionStorage(const RegionStorage&) = delete;
+        RegionStorage(RegionStorage&&) = delete;
+        RegionStorage& operator=(const RegionStorage&) = delete;
+        RegionStorage& operator=(RegionStorage&&) = delete;
+
+        bool Open(const std::filesystem::path& path)
+        {
+            Close();
+
+            std::error_code error;
+
+            std::filesystem::create_directories(path, error);
+
+            if (error)
+            {
+                std::cerr << "Failed to create world directory '" << path.string() << "': " << error.message() << "\n";
+                return false;
+            }
+
+            directory = path;
+            writerRunning = true;
+            writerThread = std::thread([this]() { WriterLoop(); });
+
+            return true;
+        }
+
+        void Close()
+        {
+            if (!writerThread.joinable())
+                return;
+
+            while (!overflowQueue.empty())
+            {
+                RetryOverflow();
+                std::this_thread::sleep_for(WriterIdleInterval);
+            }
+
+            writerRunning = false;
+            writerThread.join();
+
+            DrainCompletions();
+
+            inFlightMap.clear();
+
+            std::lock_guard lock(regionMutex);
+
+            for (const auto& region : regionMap | std::views::values)
+                region->Flush();
+
+            regionMap.clear();
+        }
+
+        [[nodiscard]]
+        bool IsOpen() const
+        {
+            return writerThread.joinable();
+        }
+
+        std::unique_ptr<Chunk> Load(const ChunkCoordinate coordinate)
+        {
+            if (!IsOpen())
+                return nullptr;
+
+            auto chunk = std::make_unique<Chunk>(coordinate);
+
+            try
+            {
+                if (const auto iterator = inFlightMap.find(coordinate); iterator != inFlightMap.end())
+                {
+                    WireInputArchive archive(*iterator->second);
+
+                    chunk->Deserialize(archive);
+
+                    return chunk;
+                }
+
+                const auto region = GetRegion(RegionFile::GetRegionCoordinate(coordinate), false);
+
+                if (!region || !region->Read(coordinate, readBuffer))
+                    return nullptr;
+
+                WireInputArchive archive(readBuffer.data(), readBuffer.size());
+
+                chunk->Deserialize(archive);
+            }
+            catch (const WireArchiveError& error)
+            {
+                std::cerr << "Chunk (" << coordinate.x << ", " << coordinate.z << ") failed to load: " << error.what() << "\n";
+                return nullptr;
+            }
+
+            loadedChunkCount++;
+
+            return chunk;
+        }
+
+        void QueueSave(const Chunk& chunk)
+        {
+            if (!IsOpen())
+                return;
+
+            auto data = std::make_shared<std::string>();
+
+            WireOutputArchive archive(*data);
+
+            chunk.Serialize(archive);
+
+            inFlightMap[chunk.GetCoordinate()] = data;
+
+            WriteRequest request{ chunk.GetCoordinate(), std::move(data) };
+
+            if (!overflowQueue.empty() || !writeRing.TryPush(std::move(request)))
+                overflowQueue.push_back(std::move(request));
+        }
+
+        void SaveDirty(ChunkManager& manager)
+        {
+            manager.ForEach([&](Chunk& chunk)
+            {
+                if (!chunk.IsDirty())
+                    return;
+
+                QueueSave(chunk);
+                chunk.ClearDirty();
+            });
+        }
+
+        void Update(const steady_clock::time_point now)
+        {
+            if (!IsOpen())
+                return;
+
+            RetryOverflow();
+            DrainCompletions();
+
+            if (now - lastSave >= SaveInterval)
+            {
+                SaveDirty(ChunkManager::GetInstance());
+                lastSave = now;
+            }
+        }
+
+        [[nodiscard]]
+        uint64_t GetSavedChunkCount() const
+        {
+            return savedChunkCount;
+        }
+
+        [[nodiscard]]
+        uint64_t GetLoadedChunkCount() const
+        {
+            return loadedChunkCount;
+        }
+
+        [[nodiscard]]
+        size_t GetPendingCount() const
+        {
+            return inFlightMap.size();
+        }
+
+        static RegionStorage& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<RegionStorage>(new RegionStorage());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        static constexpr seconds SaveInterval{ 5 };
+        static constexpr milliseconds WriterIdleInterval{ 2 };
+
+        struct WriteRequest
+        {
+            ChunkCoordinate coordinate;
+
+            std::shared_ptr<const std::string> data;
+        };
+
+        RegionStorage() = default;
+
+        RegionFile* GetRegion(const ChunkCoordinate regionCoordinate, const bool create)
+        {
+            std::lock_guard lock(regionMutex);
+
+            if (const auto iterator = regionMap.find(regionCoordinate); iterator != regionMap.end())
+                return iterator->second.get();
+
+            const auto path = directory / RegionFile::GetFileName(regionCoordinate);
+
+            if (!create && !std::filesystem::exists(path))
+                return nullptr;
+
+            auto region = std::make_unique<RegionFile>();
+
+            if (!region->Open(path))
+                return nullptr;
+
+            return regionMap.emplace(regionCoordinate, std::move(region)).first->second.get();
+        }
+
+        void RetryOverflow()
+        {
+            while (!overflowQueue.empty() && writeRing.TryPush(std::move(overflowQueue.front())))
+                overflowQueue.pop_front();
+        }
+
+        void DrainCompletions()
+        {
+            WriteRequest request;
+
+            while (completionRing.TryPop(request))
+            {
+                if (const auto iterator = inFlightMap.find(request.coordinate); iterator != inFlightMap.end() && iterator->second == request.data)
+                    inFlightMap.erase(iterator);
+            }
+        }
+
+        void WriterLoop()
+        {
+            std::deque<WriteRequest> completionOverflow;
+
+            while (true)
+            {
+                const bool running = writerRunning;
+
+                WriteRequest request;
+
+                if (!writeRing.TryPop(request))
+                {
+                    if (!running)
+                        break;
+
+                    std::this_thread::sleep_for(WriterIdleInterval);
+                    continue;
+                }
+
+                const auto region = GetRegion(RegionFile::GetRegionCoordinate(request.coordinate), true);
+
+                if (region && region->Write(request.coordinate, reinterpret_cast<const uint8_t*>(request.data->data()), request.data->size()))
+                    savedChunkCount++;
+                else
+                    std::cerr << "Failed to save chunk (" << request.coordinate.x << ", " << request.coordinate.z << ").\n";
+
+                completionOverflow.push_back(std::move(request));
+
+                while (!completionOverflow.empty() && completionRing.TryPush(std::move(completionOverflow.front())))
+                    completionOverflow.pop_front();
+            }
+        }
+
+        std::filesystem::path directory;
+
+        std::thread writerThread;
+        std::atomic<bool> writerRunning = false;
+
+        SpscRingBuffer<WriteRequest, 1024> writeRing;
+        SpscRingBuffer<WriteRequest, 1024> completionRing;
+        std::deque<WriteRequest> overflowQueue;
+
+        std::unordered_map<ChunkCoordinate, std::shared_ptr<const std::string>, ChunkCoordinateHash> inFlightMap;
+
+        std::mutex regionMutex;
+        std::unordered_map<ChunkCoordinate, std::unique_ptr<RegionFile>, ChunkCoordinateHash> regionMap;
+
+        std::vector<uint8_t> readBuffer;
+
+        steady_clock::time_point lastSave = steady_clock::now();
+
+        std::atomic<uint64_t> savedChunkCount = 0;
+        uint64_t loadedChunkCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<RegionStorage> instance;
+
+    };
+
+    std::once_flag RegionStorage::initializationFlag;
+    std::unique_ptr<RegionStorage> RegionStorage::instance;
+}
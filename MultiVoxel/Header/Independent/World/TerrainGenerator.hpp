@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "Independent/Math/Noise.hpp"
+#include "Independent/Math/Random.hpp"
+#include "Independent/World/Block.hpp"
+#include "Independent/World/Chunk.hpp"
+
+using namespace MultiVoxel::Independent::Math;
+
+namespace MultiVoxel::Independent::World
+{
+    struct SurfaceMap
+    {
+        std::array<int16_t, Chunk::Width * Chunk::Width> heightList = { };
+        std::array<BlockId, Chunk::Width * Chunk::Width> blockList = { };
+
+        [[nodiscard]]
+        static constexpr size_t GetIndex(const int32_t x, const int32_t z)
+        {
+            return static_cast<size_t>(z) * Chunk::Width + static_cast<size_t>(x);
+        }
+    };
+
+    class TerrainGenerator final
+    {
+
+    public:
+
+        static constexpr int32_t SeaLevel = 62;
+
+        explicit TerrainGenerator(const uint64_t seed) : seed(seed), heightNoise(seed), detailNoise(Random::Mix(seed + 1)), caveNoiseA(Random::Mix(seed + 2)), caveNoiseB(Random::Mix(seed + 3)) { }
+
+        void GenerateHeightmap(Chunk& chunk, SurfaceMap& surface) const
+        {
+            const int32_t baseX = chunk.GetCoordinate().x * Chunk::Width;
+            const int32_t baseZ = chunk.GetCoordinate().z * Chunk::Width;
+
+            std::array<float, ColumnCount> heightX;
+            std::array<float, ColumnCount> heightZ;
+            std::array<float, ColumnCount> detailX;
+            std::array<float, ColumnCount> detailZ;
+
+            for (int32_t z = 0; z < Chunk::Width; ++z)
+            {
+                for (int32_t x = 0; x < Chunk::Width; ++x)
+                {
+                    const size_t index = SurfaceMap::GetIndex(x, z);
+
+                    const float worldX = static_cast<float>(baseX + x);
+                    const float worldZ = static_cast<float>(baseZ + z);
+
+                    heightX[index] = worldX * HeightFrequency;
+                    heightZ[index] = worldZ * HeightFrequency;
+                    detailX[index] = worldX * DetailFrequency;
+                    detailZ[index] = worldZ * DetailFrequency;
+                }
+            }
+
+            std::array<float, ColumnCount> elevationList;
+            std::array<float, ColumnCount> detailList;
+
+            heightNoise.Fractal(NoiseType::Perlin, heightX.data(), heightZ.data(), elevationList.data(), ColumnCount, HeightOctaveCount);
+            detailNoise.Perlin(detailX.data(), detailZ.data(), detailList.data(), ColumnCount);
+
+            int32_t minimum = Chunk::Height;
+            int32_t maximum = SeaLevel;
+
+            for (size_t index = 0; index < ColumnCount; ++index)
+            {
+                const float elevation = elevationList[index] * HeightAmplitude + detailList[index] * DetailAmplitude;
+                const int32_t height = std::clamp(BaseHeight + static_cast<int32_t>(std::floor(elevation)), 1, Chunk::Height - 2);
+
+                surface.heightList[index] = static_cast<int16_t>(height);
+                surface.blockList[index] = height <= SeaLevel + 1 ? SandBlock : GrassBlock;
+
+                minimum = std::min(minimum, height);
+                maximum = std::max(maximum, height);
+            }
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+            {
+                const int32_t bottom = sectionIndex * ChunkSection::Size;
+
+                auto& section = chunk.GetSection(sectionIndex);
+
+                if (bottom + ChunkSection::Size <= minimum - SoilDepth)
+                {
+                    section.Fill(StoneBlock);
+                    continue;
+                }
+
+                if (bottom > maximum)
+                    continue;
+
+                for (int32_t y = 0; y < ChunkSection::Size; ++y)
+                {
+                    for (int32_t z = 0; z < Chunk::Width; ++z)
+                    {
+                        for (int32_t x = 0; x < Chunk::Width; ++x)
+                        {
+                            const size_t index = SurfaceMap::GetIndex(x, z);
+
+                            section.Set(x, y, z, GetColumnBlock(bottom + y, surface.heightList[index], surface.blockList[index]));
+                        }
+                    }
+                }
+
+                section.Compact();
+            }
+        }
+
+        void GenerateCaves(Chunk& chunk, SurfaceMap& surface) const
+        {
+            const int32_t baseX = chunk.GetCoordinate().x * Chunk::Width;
+            const int32_t baseZ = chunk.GetCoordinate().z * Chunk::Width;
+
+            std::array<int16_t, ColumnCount> ceilingList;
+
+            int32_t maximum = 0;
+
+            for (size_t index = 0; index < ceilingList.size(); ++index)
+            {
+                const int32_t height = surface.heightList[index];
+
+                ceilingList[index] = static_cast<int16_t>(height <= SeaLevel + 1 ? height - SoilDepth - 1 : height);
+                maximum = std::max<int32_t>(maximum, ceilingList[index]);
+            }
+
+            std::array<float, ColumnCount> caveX;
+            std::array<float, ColumnCount> caveY;
+            std::array<float, ColumnCount> caveZ;
+            std::array<float, ColumnCount> caveA;
+            std::array<float, ColumnCount> caveB;
+
+            for (int32_t z = 0; z < Chunk::Width; ++z)
+            {
+                for (int32_t x = 0; x < Chunk::Width; ++x)
+                {
+                    caveX[SurfaceMap::GetIndex(x, z)] = static_cast<float>(baseX + x) * CaveFrequency;
+                    caveZ[SurfaceMap::GetIndex(x, z)] = static_cast<float>(baseZ + z) * CaveFrequency;
+                }
+            }
+
+            for (int32_t y = MinimumCaveHeight; y <= maximum; ++y)
+            {
+                auto& section = chunk.GetSection(y / ChunkSection::Size);
+
+                const int32_t localY = y % ChunkSection::Size;
+
+                if (section.IsUniform() && (section.GetUniformBlock() == AirBlock || section.GetUniformBlock() == WaterBlock))
+                    continue;
+
+                caveY.fill(static_cast<float>(y) * CaveVerticalFrequency);
+
+                caveNoiseA.Perlin(caveX.data(), caveY.data(), caveZ.data(), caveA.data(), ColumnCount);
+                caveNoiseB.Perlin(caveX.data(), caveY.data(), caveZ.data(), caveB.data(), ColumnCount);
+
+                for (int32_t z = 0; z < Chunk::Width; ++z)
+                {
+                    for (int32_t x = 0; x < Chunk::Width; ++x)
+                    {
+                        const size_t index = SurfaceMap::GetIndex(x, z);
+
+                        if (y > ceilingList[index])
+                            continue;
+
+                        const BlockId block = section.Get(x, localY, z);
+
+                        if (block == AirBlock || block == WaterBlock)
+                            continue;
+
+                        if (caveA[index] * caveA[index] + caveB[index] * caveB[index] < CaveThreshold)
+                            section.Set(x, localY, z, AirBlock);
+                    }
+                }
+            }
+
+            for (int32_t z = 0; z < Chunk::Width; ++z)
+            {
+                for (int32_t x = 0; x < Chunk::Width; ++x)
+                {
+                    const size_t index = SurfaceMap::GetIndex(x, z);
+
+                    int32_t height = surface.heightList[index];
+
+                    while (height > 0 && chunk.Get(x, height, z) == AirBlock)
+                        height--;
+
+                    surface.heightList[index] = static_cast<int16_t>(height);
+                    surface.blockList[index] = chunk.Get(x, height, z);
+                }
+            }
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+                chunk.GetSection(sectionIndex).Compact();
+        }
+
+        void GenerateDecorations(Chunk& chunk, const std::array<const SurfaceMap*, 9>& neighbourhood) const
+        {
+            const auto coordinate = chunk.GetCoordinate();
+
+            for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+            {
+                for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                {
+                    const auto& surface = *neighbourhood[(offsetZ + 1) * 3 + offsetX + 1];
+
+                    Random random(Random::Hash(seed, coordinate.x + offsetX, coordinate.z + offsetZ));
+
+                    const uint32_t treeCount = random.NextBelow(MaximumTreeCount + 1);
+
+                    for (uint32_t tree = 0; tree < treeCount; ++tree)
+                    {
+                        const int32_t x = random.NextBetween(0, Chunk::Width - 1);
+                        const int32_t z = random.NextBetween(0, Chunk::Width - 1);
+                        const int32_t trunkHeight = random.NextBetween(4, 6);
+
+                        const size_t index = SurfaceMap::GetIndex(x, z);
+
+                        if (surface.blockList[index] != GrassBlock || surface.heightList[index] + trunkHeight + 2 >= Chunk::Height)
+                            continue;
+
+                        PlaceTree(chunk, x + offsetX * Chunk::Width, surface.heightList[index] + 1, z + offsetZ * Chunk::Width, trunkHeight);
+                    }
+                }
+            }
+
+            for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+                chunk.GetSection(sectionIndex).Compact();
+
+            chunk.MarkDirty();
+        }
+
+        [[nodiscard]]
+        uint64_t GetSeed() const
+        {
+            return seed;
+        }
+
+    private:
+
+        static constexpr size_t ColumnCount = Chunk::Width * Chunk::Width;
+
+        static constexpr int32_t BaseHeight = 64;
+        static constexpr int32_t SoilDepth = 3;
+        static constexpr int32_t HeightOctaveCount = 5;
+        static constexpr float HeightFrequency = 0.005f;
+        static constexpr float HeightAmplitude = 28.0f;
+        static constexpr float DetailFrequency = 0.03f;
+        static constexpr float DetailAmplitude = 3.0f;
+
+        static constexpr int32_t MinimumCaveHeight = 5;
+        static constexpr float CaveFrequency = 0.04f;
+        static constexpr float CaveVerticalFrequency = 0.06f;
+        static constexpr float CaveThreshold = 0.006f;
+
+        static constexpr uint32_t MaximumTreeCount = 4;
+        static constexpr int32_t TreeRadius = 2;
+
+        [[nodiscard]]
+        static BlockId GetColumnBlock(const int32_t y, const int32_t height, const BlockId top)
+        {
+            if (y < height - SoilDepth)
+                return StoneBlock;
+
+            if (y < height)
+                return top == SandBlock ? SandBlock : DirtBlock;
+
+            if (y == height)
+                return top;
+
+            return y <= SeaLevel ? WaterBlock : AirBlock;
+        }
+
+        static void PlaceTree(Chunk& chunk, const int32_t x, const int32_t y, const int32_t z, const int32_t trunkHeight)
+        {
+            const int32_t top = y + trunkHeight - 1;
+
+            for (int32_t leafY = top - 1; leafY <= top + 1; ++leafY)
+            {
+                const int32_t radius = leafY <= top ? TreeRadius : 1;
+
+                for (int32_t offsetZ = -radius; offsetZ <= radius; ++offsetZ)
+                {
+                    for (int32_t offsetX = -radius; offsetX <= radius; ++offsetX)
+                    {
+                        if (radius == TreeRadius && std::abs(offsetX) == radius && std::abs(offsetZ) == radius)
+                            continue;
+
+                        Place(chunk, x + offsetX, leafY, z + offsetZ, LeavesBlock);
+                    }
+                }
+            }
+
+            for (int32_t trunkY = y; trunkY <= top; ++trunkY)
+                Place(chunk, x, trunkY, z, LogBlock);
+        }
+
+        static void Place(Chunk& chunk, const int32_t x, const int32_t y, const int32_t z, const BlockId block)
+        {
+            if (!Chunk::IsInside(x, y, z))
+                return;
+
+            const BlockId current = chunk.Get(x, y, z);
+
+            if (current == AirBlock || (block == LogBlock && current == LeavesBlock))
+                chunk.GetSection(y / ChunkSection::Size).Set(x, y % ChunkSection::Size, z, block);
+        }
+
+        uint64_t seed;
+
+        Noise heightNoise;
+        Noise detailNoise;
+        Noise caveNoiseA;
+        Noise caveNoiseB;
+
+    };
+}
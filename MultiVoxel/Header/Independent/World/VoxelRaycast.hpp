@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include "Independent/Math/Vector.hpp"
+#include "Independent/Thread/WorkerPool.hpp"
+#include "Independent/World/ChunkManager.hpp"
+
+using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::Thread;
+
+namespace MultiVoxel::Independent::World
+{
+    struct Ray
+    {
+        Vector<float, 3> origin;
+        Vector<float, 3> direction;
+
+        float maximumDistance = 0.0f;
+    };
+
+    struct RaycastHit
+    {
+        Vector<int32_t, 3> position;
+        Vector<int32_t, 3> normal;
+
+        float distance = 0.0f;
+
+        BlockId block = AirBlock;
+    };
+
+    class VoxelRaycast final
+    {
+
+    public:
+
+        VoxelRaycast(const VoxelRaycast&) = delete;
+        VoxelRaycast(VoxelRaycast&&) = delete;
+        VoxelRaycast& operator=(const VoxelRaycast&) = delete;
+        VoxelRaycast& operator=(VoxelRaycast&&) = delete;
+
+        [[nodiscard]]
+        static bool IsSolid(const BlockId block)
+        {
+            return block != AirBlock;
+        }
+
+        template <typename Predicate = decltype(&IsSolid)>
+        [[nodiscard]]
+        static std::optional<RaycastHit> Cast(const ChunkManager& manager, const Ray& ray, Predicate&& predicate = &IsSolid)
+        {
+            float origin[3];
+            float direction[3];
+
+            float length = 0.0f;
+
+            for (int32_t axis = 0; axis < 3; ++axis)
+            {
+                origin[axis] = ray.origin[axis];
+                direction[axis] = ray.direction[axis];
+
+                length += direction[axis] * direction[axis];
+            }
+
+            if (!(length > 0.0f))
+                return std::nullopt;
+
+            length = std::sqrt(length);
+
+            for (float& component : direction)
+                component /= length;
+
+            float start = 0.0f;
+            float end = ray.maximumDistance;
+
+            if (!ClipHeight(origin[1], direction[1], start, end))
+                return std::nullopt;
+
+            int32_t voxel[3];
+            int32_t step[3];
+            int32_t normal[3] = { 0, 0, 0 };
+
+            float inverse[3];
+            float next[3];
+            float delta[3];
+
+            for (int32_t axis = 0; axis < 3; ++axis)
+            {
+                step[axis] = direction[axis] > 0.0f ? 1 : direction[axis] < 0.0f ? -1 : 0;
+                inverse[axis] = step[axis] != 0 ? 1.0f / direction[axis] : 0.0f;
+                delta[axis] = step[axis] != 0 ? std::abs(inverse[axis]) : Infinity;
+                voxel[axis] = static_cast<int32_t>(std::floor(origin[axis] + direction[axis] * start));
+            }
+
+            voxel[1] = std::clamp(voxel[1], 0, Chunk::Height - 1);
+
+            if (start > 0.0f)
+                normal[1] = -step[1];
+
+            float distance = start;
+
+            Reset(origin, inverse, step, voxel, next);
+
+            const Chunk* chunk = nullptr;
+            ChunkCoordinate coordinate = { std::numeric_limits<int32_t>::min(), 0 };
+
+            while (distance <= end)
+            {
+                if (const auto current = ChunkCoordinate::FromBlock(voxel[0], voxel[2]); current != coordinate)
+                {
+                    chunk = manager.GetChunk(current);
+                    coordinate = current;
+                }
+
+                int32_t minimum[3];
+                int32_t maximum[3];
+
+                bool empty = chunk == nullptr;
+
+                if (empty)
+                {
+                    minimum[1] = 0;
+                    maximum[1] = Chunk::Height;
+                }
+                else
+                {
+                    const auto& section = chunk->GetSection(voxel[1] / ChunkSection::Size);
+
+                    if (section.IsUniform() && !predicate(section.GetUniformBlock()))
+                    {
+                        empty = true;
+                        minimum[1] = voxel[1] / ChunkSection::Size * ChunkSection::Size;
+                        maximum[1] = minimum[1] + ChunkSection::Size;
+                    }
+                    else if (const BlockId block = section.Get(voxel[0] & (Chunk::Width - 1), voxel[1] % ChunkSection::Size, voxel[2] & (Chunk::Width - 1)); predicate(block))
+                    {
+                        RaycastHit hit;
+
+                        hit.position = { voxel[0], voxel[1], voxel[2] };
+                        hit.normal = { normal[0], normal[1], normal[2] };
+                        hit.distance = distance;
+                        hit.block = block;
+
+                        return hit;
+                    }
+                }
+
+                if (empty)
+                {
+                    minimum[0] = coordinate.x * Chunk::Width;
+                    minimum[2] = coordinate.z * Chunk::Width;
+                    maximum[0] = minimum[0] + Chunk::Width;
+                    maximum[2] = minimum[2] + Chunk::Width;
+
+                    int32_t exitAxis = 0;
+                    float exit = Infinity;
+
+                    for (int32_t axis = 0; axis < 3; ++axis)
+                    {
+                        if (step[axis] == 0)
+                            continue;
+
+                        const float boundary = (static_cast<float>(step[axis] > 0 ? maximum[axis] : minimum[axis]) - origin[axis]) * inverse[axis];
+
+                        if (boundary < exit)
+                        {
+                            exit = boundary;
+                            exitAxis = axis;
+                        }
+                    }
+
+                    distance = std::max(distance, exit);
+
+                    if (distance > end)
+                        break;
+
+                    for (int32_t axis = 0; axis < 3; ++axis)
+                    {
+                        if (axis == exitAxis)
+                            voxel[axis] = step[axis] > 0 ? maximum[axis] : minimum[axis] - 1;
+                        else
+                            voxel[axis] = std::clamp(static_cast<int32_t>(std::floor(origin[axis] + direction[axis] * distance)), minimum[axis], maximum[axis] - 1);
+
+                        normal[axis] = axis == exitAxis ? -step[axis] : 0;
+                    }
+
+                    Reset(origin, inverse, step, voxel, next);
+                }
+                else
+                {
+                    const int32_t axis = next[0] < next[1] ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+
+                    distance = next[axis];
+                    voxel[axis] += step[axis];
+                    next[axis] += delta[axis];
+
+                    normal[0] = normal[1] = normal[2] = 0;
+                    normal[axis] = -step[axis];
+                }
+
+                if (voxel[1] < 0 || voxel[1] >= Chunk::Height)
+                    break;
+            }
+
+            return std::nullopt;
+        }
+
+        template <typename Predicate = decltype(&IsSolid)>
+        static void CastBatch(const ChunkManager& manager, const std::span<const Ray> rayList, const std::span<std::optional<RaycastHit>> hitList, WorkerPool* pool = nullptr, Predicate predicate = &IsSolid)
+        {
+            const size_t count = std::min(rayList.size(), hitList.size());
+
+            if (pool == nullptr || count < BatchSize * 2)
+            {
+                for (size_t index = 0; index < count; ++index)
+                    hitList[index] = Cast(manager, rayList[index], predicate);
+
+                return;
+            }
+
+            for (size_t begin = 0; begin < count; begin += BatchSize)
+            {
+                pool->Submit([&manager, rayList, hitList, predicate, begin, end = std::min(begin + BatchSize, count)]()
+                {
+                    for (size_t index = begin; index < end; ++index)
+                        hitList[index] = Cast(manager, rayList[index], predicate);
+                });
+            }
+
+            pool->Wait();
+        }
+
+    private:
+
+        static constexpr float Infinity = std::numeric_limits<float>::infinity();
+        static constexpr size_t BatchSize = 256;
+
+        VoxelRaycast() = default;
+
+        static bool ClipHeight(const float origin, const float direction, float& start, float& end)
+        {
+            if (direction == 0.0f)
+                return origin >= 0.0f && origin < static_cast<float>(Chunk::Height) && start <= end;
+
+            float enter = (0.0f - origin) / direction;
+            float exit = (static_cast<float>(Chunk::Height) - origin) / direction;
+
+            if (enter > exit)
+                std::swap(enter, exit);
+
+            start = std::max(start, enter);
+            end = std::min(end, exit);
+
+            return start <= end;
+        }
+
+        static void Reset(const float* origin, const float* inverse, const int32_t* step, const int32_t* voxel, float* next)
+        {
+            for (int32_t axis = 0; axis < 3; ++axis)
+                next[axis] = step[axis] != 0 ? (static_cast<float>(voxel[axis] + (step[axis] > 0)) - origin[axis]) * inverse[axis] : Infinity;
+        }
+
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Independent/World/Block.hpp"
+#include "Independent/World/ChunkChangeTracker.hpp"
+#include "Independent/World/FluidSimulation.hpp"
+#include "Server/BlockTickScheduler.hpp"
+
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Server
+{
+    class BlockBehaviours final
+    {
+
+    public:
+
+        BlockBehaviours(const BlockBehaviours&) = delete;
+        BlockBehaviours(BlockBehaviours&&) = delete;
+        BlockBehaviours& operator=(const BlockBehaviours&) = delete;
+        BlockBehaviours& operator=(BlockBehaviours&&) = delete;
+
+        static void RegisterDefaults(BlockTickScheduler& scheduler)
+        {
+            BlockBehaviour sand;
+
+            sand.delay = 2;
+            sand.onScheduledTick = [](const int32_t x, const int32_t y, const int32_t z, uint64_t)
+            {
+                const BlockId below = ChunkManager::GetInstance().GetBlock(x, y - 1, z);
+
+                if (y == 0 || (below != AirBlock && !IsFluid(below)))
+                    return;
+
+                auto& tracker = ChunkChangeTracker::GetInstance();
+
+                if (IsFluid(below))
+                    FluidSimulation::GetInstance().Displace(x, y - 1, z, x, y, z);
+
+                tracker.SetBlock(x, y, z, below);
+                tracker.SetBlock(x, y - 1, z, SandBlock);
+            };
+
+            scheduler.Register(SandBlock, std::move(sand));
+
+            BlockBehaviour dirt;
+
+            dirt.onRandomTick = [](const int32_t x, const int32_t y, const int32_t z, uint64_t)
+            {
+                const auto& manager = ChunkManager::GetInstance();
+
+                if (GetLightOpacity(manager.GetBlock(x, y + 1, z)) >= MaximumLight)
+                    return;
+
+                for (int32_t offsetY = -1; offsetY <= 1; ++offsetY)
+                {
+                    for (int32_t offsetZ = -1; offsetZ <= 1; ++offsetZ)
+                    {
+                        for (int32_t offsetX = -1; offsetX <= 1; ++offsetX)
+                        {
+                            if (manager.GetBlock(x + offsetX, y + offsetY, z + offsetZ) == GrassBlock)
+                            {
+                                ChunkChangeTracker::GetInstance().SetBlock(x, y, z, GrassBlock);
+                                return;
+                            }
+                        }
+                    }
+                }
+            };
+
+            scheduler.Register(DirtBlock, std::move(dirt));
+
+            BlockBehaviour grass;
+
+            grass.onRandomTick = [](const int32_t x, const int32_t y, const int32_t z, uint64_t)
+            {
+                if (GetLightOpacity(ChunkManager::GetInstance().GetBlock(x, y + 1, z)) >= MaximumLight)
+                    ChunkChangeTracker::GetInstance().SetBlock(x, y, z, DirtBlock);
+            };
+
+            scheduler.Register(GrassBlock, std::move(grass));
+        }
+
+    private:
+
+        BlockBehaviours() = default;
+
+    };
+}
@@ -0,0 +1,340 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Independent/Math/Random.hpp"
+#include "Independent/World/ChunkChangeTracker.hpp"
+
+using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::World;
+
+namespace MultiVoxel::Server
+{
+    struct BlockBehaviour
+    {
+        using Handler = std::function<void(int32_t, int32_t, int32_t, uint64_t)>;
+
+        uint32_t delay = 1;
+
+        Handler onScheduledTick;
+        Handler onRandomTick;
+    };
+
+    class BlockTickScheduler final
+    {
+
+    public:
+
+        static constexpr uint32_t RandomTickCount = 3;
+        static constexpr size_t MaximumScheduledPerTick = 1 << 16;
+
+        BlockTickScheduler(const BlockTickScheduler&) = delete;
+        BlockTickScheduler(BlockTickScheduler&&) = delete;
+        BlockTickScheduler& operator=(const BlockTickScheduler&) = delete;
+        BlockTickScheduler& operator=(BlockTickScheduler&&) = delete;
+
+        void Register(const BlockId block, BlockBehaviour behaviour)
+        {
+            behaviourMap[block] = std::move(behaviour);
+        }
+
+        [[nodiscard]]
+        const BlockBehaviour* GetBehaviour(const BlockId block) const
+        {
+            const auto iterator = behaviourMap.find(block);
+
+            return iterator == behaviourMap.end() ? nullptr : &iterator->second;
+        }
+
+        bool Schedule(const int32_t x, const int32_t y, const int32_t z, const uint32_t delay)
+        {
+            if (y < 0 || y >= Chunk::Height)
+                return false;
+
+            const BlockId block = ChunkManager::GetInstance().GetBlock(x, y, z);
+
+            const auto [iterator, inserted] = pendingMap.try_emplace(Pack(x, y, z), block);
+
+            if (!inserted)
+            {
+                if (iterator->second == block)
+                    return false;
+
+                iterator->second = block;
+            }
+
+            Insert({ x, y, z, block, currentTick + std::max<uint32_t>(delay, 1) });
+
+            return true;
+        }
+
+        void OnBlockChanged(const int32_t x, const int32_t y, const int32_t z)
+        {
+            for (const auto& [offsetX, offsetY, offsetZ] : NeighbourList)
+            {
+                const BlockId block = ChunkManager::GetInstance().GetBlock(x + offsetX, y + offsetY, z + offsetZ);
+
+                if (const auto behaviour = GetBehaviour(block); behaviour && behaviour->onScheduledTick)
+                    Schedule(x + offsetX, y + offsetY, z + offsetZ, behaviour->delay);
+            }
+        }
+
+        void Tick(const uint64_t tick)
+        {
+            lastScheduledCount = 0;
+            lastRandomCount = 0;
+
+            while (currentTick < tick)
+            {
+                currentTick++;
+
+                if ((currentTick & SlotMask) == 0)
+                    Cascade();
+
+                RunSlot(wheelList[0][currentTick & SlotMask]);
+            }
+
+            if (!deferredList.empty())
+            {
+                auto deferred = std::move(deferredList);
+
+                deferredList.clear();
+
+                for (auto& entry : deferred)
+                {
+                    entry.tick = currentTick + 1;
+                    Insert(entry);
+                }
+            }
+
+            RunRandomTicks();
+        }
+
+        [[nodiscard]]
+        uint64_t GetCurrentTick() const
+        {
+            return currentTick;
+        }
+
+        [[nodiscard]]
+        size_t GetPendingCount() const
+        {
+            return pendingMap.size();
+        }
+
+        [[nodiscard]]
+        size_t GetLastScheduledCount() const
+        {
+            return lastScheduledCount;
+        }
+
+        [[nodiscard]]
+        size_t GetLastRandomCount() const
+        {
+            return lastRandomCount;
+        }
+
+        static BlockTickScheduler& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<BlockTickScheduler>(new BlockTickScheduler());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct Entry
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+
+            BlockId block;
+
+            uint64_t tick;
+        };
+
+        struct Offset
+        {
+            int32_t x;
+            int32_t y;
+            int32_t z;
+        };
+
+        static constexpr int32_t LevelCount = 3;
+        static constexpr int32_t SlotBits = 8;
+        static constexpr uint64_t SlotCount = 1ull << SlotBits;
+        static constexpr uint64_t SlotMask = SlotCount - 1;
+
+        static constexpr std::array<Offset, 7> NeighbourList = { { { 0, 0, 0 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } } };
+
+        BlockTickScheduler() = default;
+
+        [[nodiscard]]
+        static uint64_t Pack(const int32_t x, const int32_t y, const int32_t z)
+        {
+            return static_cast<uint64_t>(static_cast<uint32_t>(x) & 0xFFFFFF) << 32 | static_cast<uint64_t>(static_cast<uint32_t>(z) & 0xFFFFFF) << 8 | static_cast<uint64_t>(y & 0xFF);
+        }
+
+        void Insert(const Entry& entry)
+        {
+            const uint64_t delta = entry.tick - currentTick;
+
+            for (int32_t level = 0; level < LevelCount; ++level)
+            {
+                if (delta < 1ull << (SlotBits * (level + 1)))
+                {
+                    wheelList[level][entry.tick >> (SlotBits * level) & SlotMask].push_back(entry);
+                    return;
+                }
+            }
+
+            overflowList.push_back(entry);
+        }
+
+        void Cascade()
+        {
+            for (int32_t level = 1; level < LevelCount; ++level)
+            {
+                auto& slot = wheelList[level][currentTick >> (SlotBits * level) & SlotMask];
+
+                auto entryList = std::move(slot);
+
+                slot.clear();
+
+                for (const auto& entry : entryList)
+                    Insert(entry);
+
+                if ((currentTick >> (SlotBits * level) & SlotMask) != 0)
+                    return;
+            }
+
+            auto overflow = std::move(overflowList);
+
+            overflowList.clear();
+
+            for (const auto& entry : overflow)
+                Insert(entry);
+        }
+
+        void RunSlot(std::vector<Entry>& slot)
+        {
+            if (slot.empty())
+                return;
+
+            auto entryList = std::move(slot);
+
+            slot.clear();
+
+            for (const auto& entry : entryList)
+            {
+                if (lastScheduledCount >= MaximumScheduledPerTick)
+                {
+                    deferredList.push_back(entry);
+                    continue;
+                }
+
+                const auto iterator = pendingMap.find(Pack(entry.x, entry.y, entry.z));
+
+                if (iterator == pendingMap.end() || iterator->second != entry.block)
+                    continue;
+
+                pendingMap.erase(iterator);
+
+                if (ChunkManager::GetInstance().GetBlock(entry.x, entry.y, entry.z) != entry.block)
+                    continue;
+
+                const auto behaviour = GetBehaviour(entry.block);
+
+                if (!behaviour || !behaviour->onScheduledTick)
+                    continue;
+
+                behaviour->onScheduledTick(entry.x, entry.y, entry.z, currentTick);
+
+                lastScheduledCount++;
+            }
+        }
+
+        void RunRandomTicks()
+        {
+            if (behaviourMap.empty())
+                return;
+
+            ChunkManager::GetInstance().ForEach([&](const Chunk& chunk)
+            {
+                const auto coordinate = chunk.GetCoordinate();
+
+                Random random(Random::Hash(currentTick, coordinate.x, coordinate.z));
+
+                for (int32_t sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+                {
+                    const auto& section = chunk.GetSection(sectionIndex);
+
+                    if (section.IsUniform())
+                    {
+                        const auto behaviour = GetBehaviour(section.GetUniformBlock());
+
+                        if (!behaviour || !behaviour->onRandomTick)
+                            continue;
+                    }
+
+                    for (uint32_t sample = 0; sample < RandomTickCount; ++sample)
+                    {
+                        const uint64_t value = random.Next();
+
+                        const auto x = static_cast<int32_t>(value & 15);
+                        const auto y = static_cast<int32_t>(value >> 4 & 15);
+                        const auto z = static_cast<int32_t>(value >> 8 & 15);
+
+                        const auto behaviour = GetBehaviour(section.Get(x, y, z));
+
+                        if (!behaviour || !behaviour->onRandomTick)
+                            continue;
+
+                        randomList.push_back({ coordinate.x * Chunk::Width + x, sectionIndex * ChunkSection::Size + y, coordinate.z * Chunk::Width + z, section.Get(x, y, z), currentTick });
+                    }
+                }
+            });
+
+            for (const auto& entry : randomList)
+            {
+                if (ChunkManager::GetInstance().GetBlock(entry.x, entry.y, entry.z) != entry.block)
+                    continue;
+
+                GetBehaviour(entry.block)->onRandomTick(entry.x, entry.y, entry.z, currentTick);
+
+                lastRandomCount++;
+            }
+
+            randomList.clear();
+        }
+
+        std::array<std::array<std::vector<Entry>, SlotCount>, LevelCount> wheelList;
+        std::vector<Entry> overflowList;
+        std::vector<Entry> deferredList;
+        std::vector<Entry> randomList;
+
+        std::unordered_map<uint64_t, BlockId> pendingMap;
+        std::unordered_map<BlockId, BlockBehaviour> behaviourMap;
+
+        uint64_t currentTick = 0;
+
+        size_t lastScheduledCount = 0;
+        size_t lastRandomCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<BlockTickScheduler> instance;
+
+    };
+
+    std::once_flag BlockTickScheduler::initializationFlag;
+    std::unique_ptr<BlockTickScheduler> BlockTickScheduler::instance;
+}
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <cereal/archives/binary.hpp>
 #include "Client/Core/InputManager.hpp"
 #include "Client/Packet/RpcClient.hpp"
 #include "Client/Render/Mesh.hpp"
@@ -104,14 +103,18 @@ namespace MultiVoxel::Server::Entity::Entities
             return 100;
         }
 
-        void Serialize(cereal::BinaryOutputArchive& archive) const override
+        void Serialize(WireOutputArchive& archive) const override
         {
             archive(GetCurrentHealth());
         }
 
-        void Deserialize(cereal::BinaryInputArchive& archive) override
+        void Deserialize(WireInputArchive& archive) override
         {
-            archive(GetCurrentHealth());
+            float currentHealth;
+
+            archive(currentHealth);
+
+            SetCurrentHealth(currentHealth);
 
             dirty = false;
         }
@@ -27,6 +27,11 @@ namespace MultiVoxel::Server::Entity
             return currentHealth;
         }
 
+        void SetCurrentHealth(const float value)
+        {
+            currentHealth = value;
+        }
+
     private:
 
         float currentHealth = 0;
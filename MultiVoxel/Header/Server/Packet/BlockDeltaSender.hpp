@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Independent/Network/NetworkManager.hpp"
+#include "Independent/Network/PacketSender.hpp"
+#include "Independent/World/BlockDeltaCodec.hpp"
+#include "Server/RPC/RpcRateLimiter.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Independent::World;
+using namespace MultiVoxel::Server::Rpc;
+
+namespace MultiVoxel::Server::Packet
+{
+    class BlockDeltaSender final : public PacketSender
+    {
+
+    public:
+
+        static constexpr size_t MaximumPacketSize = 32 * 1024;
+        static constexpr size_t MaximumResyncPerPacket = 4;
+        static constexpr size_t MaximumResyncPerTick = 8;
+        static constexpr size_t MaximumResyncRequestCount = 1024;
+        static constexpr size_t MaximumResyncQueueLength = 1024;
+        static constexpr double ResyncRequestCost = 1.0;
+
+        BlockDeltaSender(const BlockDeltaSender&) = delete;
+        BlockDeltaSender(BlockDeltaSender&&) = delete;
+        BlockDeltaSender& operator=(const BlockDeltaSender&) = delete;
+        BlockDeltaSender& operator=(BlockDeltaSender&&) = delete;
+
+        void OnChunkChanged(const Chunk& chunk, const ChunkDirtyRegion& region)
+        {
+            auto& record = recordList.emplace_back();
+
+            WireOutputArchive archive(record);
+
+            archive(region.coordinate, region.baseVersion, chunk.GetVersion());
+            archive.WriteNested([&](WireOutputArchive& body) { BlockDeltaCodec::WriteSections(body, chunk, region, statistics); });
+        }
+
+        void HandleResyncRequest(const HSteamNetConnection peer, const std::string& data)
+        {
+            WireInputArchive archive(data);
+
+            BlockDeltaType type;
+            uint32_t count;
+
+            archive(type, count);
+
+            if (type != BlockDeltaType::ResyncRequest)
+                return;
+
+            if (count > MaximumResyncRequestCount)
+            {
+                std::cerr << "Peer '" << peer << "' requested " << count << " chunk resyncs at once, ignoring the request.\n";
+                return;
+            }
+
+            auto& state = peerStateMap[peer];
+            auto& limiter = RpcRateLimiter::GetInstance();
+
+            const auto& manager = ChunkManager::GetInstance();
+            const auto now = steady_clock::now();
+
+            uint32_t droppedCount = 0;
+
+            for (; count > 0; --count)
+            {
+                ChunkCoordinate coordinate;
+
+                archive(coordinate);
+
+                if (!manager.Has(coordinate) || state.queuedSet.contains(coordinate))
+                    continue;
+
+                if (state.resyncQueue.size() >= MaximumResyncQueueLength || !limiter.TryConsume(peer, ResyncRequestCost, now))
+                {
+                    droppedCount += count;
+                    break;
+                }
+
+                state.queuedSet.insert(coordinate);
+                state.resyncQueue.push_back(coordinate);
+            }
+
+            if (droppedCount > 0)
+                std::cerr << "Peer '" << peer << "' exceeded its chunk resync budget, dropping " << droppedCount << " requests.\n";
+        }
+
+        void Reload(const HSteamNetConnection peer) override
+        {
+            auto& state = peerStateMap[peer];
+
+            state = { };
+
+            ChunkManager::GetInstance().ForEach([&](const Chunk& chunk) { state.resyncQueue.push_back(chunk.GetCoordinate()); });
+
+            std::ranges::sort(state.resyncQueue, { }, [](const ChunkCoordinate coordinate) { return coordinate.x * coordinate.x + coordinate.z * coordinate.z; });
+
+            state.queuedSet.insert(state.resyncQueue.begin(), state.resyncQueue.end());
+        }
+
+        void BeginTick() override
+        {
+            const auto peerHandleList = NetworkManager::GetInstance().GetPeerHandles();
+
+            std::erase_if(peerStateMap, [&](const auto& pair) { return std::ranges::find(peerHandleList, pair.first) == peerHandleList.end(); });
+
+            for (auto& state : peerStateMap | std::views::values)
+                state.resyncSentThisTick = 0;
+        }
+
+        bool SendPacket(std::string& outName, std::string& outData) override
+        {
+            if (recordIndex == recordList.size())
+            {
+                recordList.clear();
+                recordIndex = 0;
+
+                return false;
+            }
+
+            size_t end = recordIndex;
+            size_t size = 0;
+
+            while (end < recordList.size() && (end == recordIndex || size + recordList[end].size() <= MaximumPacketSize))
+                size += recordList[end++].size();
+
+            outName = BlockDeltaChannelName;
+            outData.clear();
+
+            WireOutputArchive archive(outData);
+
+            archive(BlockDeltaType::Delta, static_cast<uint32_t>(end - recordIndex));
+
+            for (; recordIndex < end; ++recordIndex)
+                archive.WriteBytes(recordList[recordIndex].data(), recordList[recordIndex].size());
+
+            return true;
+        }
+
+        bool SendPacketTo(const HSteamNetConnection peer, std::string& outName, std::string& outData) override
+        {
+            const auto iterator = peerStateMap.find(peer);
+
+            if (iterator == peerStateMap.end())
+                return false;
+
+            auto& state = iterator->second;
+
+            if (state.resyncQueue.empty() || state.resyncSentThisTick >= MaximumResyncPerTick)
+                return false;
+
+            const size_t count = std::min({ state.resyncQueue.size(), MaximumResyncPerPacket, MaximumResyncPerTick - state.resyncSentThisTick });
+
+            outName = BlockDeltaChannelName;
+            outData.clear();
+
+            WireOutputArchive archive(outData);
+
+            archive(BlockDeltaType::Resync, static_cast<uint32_t>(count));
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const auto coordinate = state.resyncQueue.front();
+
+                state.resyncQueue.pop_front();
+                state.queuedSet.erase(coordinate);
+
+                const auto chunk = ChunkManager::GetInstance().GetChunk(coordinate);
+
+                archive(coordinate, chunk != nullptr);
+
+                if (chunk)
+                    BlockDeltaCodec::WriteChunk(archive, *chunk);
+            }
+
+            state.resyncSentThisTick += count;
+            resyncCount += count;
+
+            return true;
+        }
+
+        [[nodiscard]]
+        size_t GetRunSectionCount() const
+        {
+            return statistics.runSectionCount;
+        }
+
+        [[nodiscard]]
+        size_t GetResendSectionCount() const
+        {
+            return statistics.resendSectionCount;
+        }
+
+        [[nodiscard]]
+        size_t GetResyncCount() const
+        {
+            return resyncCount;
+        }
+
+        static BlockDeltaSender& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<BlockDeltaSender>(new BlockDeltaSender());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct PeerState
+        {
+            std::deque<ChunkCoordinate> resyncQueue;
+            std::unordered_set<ChunkCoordinate, ChunkCoordinateHash> queuedSet;
+
+            size_t resyncSentThisTick = 0;
+        };
+
+        BlockDeltaSender() = default;
+
+        std::vector<std::string> recordList;
+        size_t recordIndex = 0;
+
+        std::unordered_map<HSteamNetConnection, PeerState> peerStateMap;
+
+        BlockDeltaCodec::Statistics statistics;
+
+        size_t resyncCount = 0;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<BlockDeltaSender> instance;
+
+    };
+
+    std::once_flag BlockDeltaSender::initializationFlag;
+    std::unique_ptr<BlockDeltaSender> BlockDeltaSender::instance;
+}
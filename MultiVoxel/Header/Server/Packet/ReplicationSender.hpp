@@ -1,10 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <optional>
 #include <ranges>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Independent/ECS/GameObjectManager.hpp"
+#include "Independent/ECS/HierarchyHash.hpp"
+#include "Independent/Network/DeltaCodec.hpp"
+#include "Independent/Network/NetworkManager.hpp"
 #include "Independent/Network/PacketSender.hpp"
 
+using namespace std::chrono;
+
 using namespace MultiVoxel::Independent::ECS;
 using namespace MultiVoxel::Independent::Network;
 
@@ -44,109 +55,487 @@ namespace MultiVoxel::Server::Packet
             removeComponentQueue.emplace_back(objectId, compTypeName);
         }
 
-        void Reload() override
+        void SetBandwidthCap(const size_t bytesPerSecond)
         {
-            sent = false;
+            bandwidthCap = bytesPerSecond;
+        }
 
-            spawnQueue.clear();
-            deleteQueue.clear();
-            addChildQueue.clear();
-            removeChildQueue.clear();
+        [[nodiscard]]
+        size_t GetBandwidthCap() const
+        {
+            return bandwidthCap;
+        }
+
+        void SetViewer(const HSteamNetConnection peer, const NetworkId viewerId)
+        {
+            GetPeerState(peer).viewerId = viewerId;
+        }
+
+        [[nodiscard]]
+        std::vector<Vector<float, 3>> GetViewerPositions() const
+        {
+            std::vector<Vector<float, 3>> result;
+
+            for (const auto& state : peerStateMap | std::views::values)
+            {
+                if (const auto position = GetWorldPosition(state.viewerId))
+                    result.push_back(*position);
+            }
+
+            return result;
+        }
+
+        void Reload(const HSteamNetConnection peer) override
+        {
+            auto& state = GetPeerState(peer);
+
+            state.fullSync.emplace(HierarchyHash::GetInstance().GetSubtree(HierarchyHash::RootId));
+        }
+
+        [[nodiscard]]
+        bool IsFullSyncPending(const HSteamNetConnection peer) const
+        {
+            const auto iterator = peerStateMap.find(peer);
+
+            return iterator != peerStateMap.end() && iterator->second.fullSync.has_value();
+        }
 
-            for (auto& gameObject : GameObjectManager::GetInstance().GetAll())
-                spawnQueue.push_back(gameObject);
+        void ReloadSubtree(const HSteamNetConnection peer, const NetworkId id)
+        {
+            auto& state = GetPeerState(peer);
+
+            auto subtree = HierarchyHash::GetInstance().GetSubtree(id);
+
+            if (!state.fullSync)
+            {
+                state.fullSync.emplace(std::move(subtree));
+                return;
+            }
+
+            for (const auto objectId : subtree)
+            {
+                if (state.fullSync->pendingSet.insert(objectId).second)
+                    state.fullSync->objectList.push_back(objectId);
+            }
+        }
+
+        void BeginTick() override
+        {
+            const auto now = steady_clock::now();
+            const double elapsedSeconds = lastTick ? duration<double>(now - *lastTick).count() : 0.0;
+
+            lastTick = now;
+
+            const auto peerHandleList = NetworkManager::GetInstance().GetPeerHandles();
 
-            for (const auto& gameObject : GameObjectManager::GetInstance().GetAll())
+            std::erase_if(peerStateMap, [&](const auto& pair) { return std::ranges::find(peerHandleList, pair.first) == peerHandleList.end(); });
+
+            for (const auto handle : peerHandleList)
+            {
+                auto& state = GetPeerState(handle);
+
+                state.tokens = std::min(state.tokens + static_cast<double>(bandwidthCap) * elapsedSeconds, static_cast<double>(bandwidthCap) * MaximumBurstSeconds);
+                state.sentThisTick = false;
+                state.fullSyncSentThisTick = false;
+            }
+
+            const auto gameObjectList = GameObjectManager::GetInstance().GetAll();
+
+            gameObjectCount = static_cast<uint32_t>(gameObjectList.size());
+            structureBlock = SerializeStructure();
+            hasStructureChanges = structureChangeCount > 0;
+
+            recordCache.clear();
+
+            for (const auto& gameObject : gameObjectList)
             {
                 for (const auto& component : gameObject->GetComponentMap() | std::views::values)
                 {
-                    if (const auto networkComponent = dynamic_cast<INetworkSerializable*>(component.get()))
-                        networkComponent->MarkDirty();
+                    const auto networkComponent = dynamic_cast<INetworkSerializable*>(component.get());
+
+                    if (!networkComponent || !networkComponent->IsDirty())
+                        continue;
+
+                    const ComponentKey key{ gameObject->GetNetworkId(), networkComponent->GetComponentTypeName() };
+
+                    for (auto& state : peerStateMap | std::views::values)
+                        state.pendingMap.try_emplace(key, 0.0f);
+
+                    networkComponent->ClearDirty();
                 }
             }
         }
 
-        bool SendPacket(std::string& outName, std::string& outData) override
+        bool SendPacket(std::string&, std::string&) override
         {
-            if (sent)
+            return false;
+        }
+
+        bool SendPacketTo(const HSteamNetConnection peer, std::string& outName, std::string& outData) override
+        {
+            const auto iterator = peerStateMap.find(peer);
+
+            if (iterator == peerStateMap.end())
                 return false;
 
-            std::ostringstream stream;
-            cereal::BinaryOutputArchive archive(stream);
+            auto& state = iterator->second;
 
-            archive(static_cast<uint32_t>(spawnQueue.size()));
+            if (!state.sentThisTick)
+            {
+                state.sentThisTick = true;
 
-            for (const auto& gameObject : spawnQueue)
-                archive(gameObject->GetNetworkId(), gameObject->GetName().operator std::string());
+                if (BuildUpdate(state, outData))
+                {
+                    outName = SyncChannelName;
+                    return true;
+                }
+            }
 
-            spawnQueue.clear();
+            if (state.fullSync && !state.fullSyncSentThisTick && state.tokens > 0.0)
+            {
+                state.fullSyncSentThisTick = true;
 
-            archive(static_cast<uint32_t>(deleteQueue.size()));
+                outName = SyncChannelName;
+                outData = BuildFullSyncChunk(state);
 
-            for (auto id : deleteQueue)
-                archive(id);
+                return true;
+            }
 
-            deleteQueue.clear();
+            return false;
+        }
 
-            archive(static_cast<uint32_t>(addChildQueue.size()));
+    private:
 
-            for (auto& [parentId, childId] : addChildQueue)
-                archive(parentId, childId);
+        static constexpr double MaximumBurstSeconds = 0.25;
+        static constexpr size_t DefaultBandwidthCap = 128 * 1024;
+        static constexpr float ReferenceDistance = 16.0f;
+        static constexpr size_t FullSyncChunkSize = 16 * 1024;
 
-            addChildQueue.clear();
+        struct ComponentKey
+        {
+            NetworkId objectId;
+            std::string typeName;
 
-            archive(static_cast<uint32_t>(removeChildQueue.size()));
+            bool operator==(const ComponentKey& other) const
+            {
+                return objectId == other.objectId && typeName == other.typeName;
+            }
+        };
 
-            for (auto& [parentId, childId] : removeChildQueue)
-                archive(parentId, childId);
+        struct ComponentKeyHash
+        {
+            size_t operator()(const ComponentKey& key) const noexcept
+            {
+                size_t seed = std::hash<NetworkId>()(key.objectId);
 
-            removeChildQueue.clear();
+                HashCombine(seed, std::hash<std::string>()(key.typeName));
 
-            archive(static_cast<uint32_t>(addComponentQueue.size()));
+                return seed;
+            }
+        };
 
-            for (auto& [id, type] : addComponentQueue)
-                archive(id, type);
+        struct FullSyncState
+        {
+            explicit FullSyncState(std::vector<NetworkId> objectList) : objectList(std::move(objectList)), pendingSet(this->objectList.begin(), this->objectList.end()) { }
 
-            addComponentQueue.clear();
+            std::vector<NetworkId> objectList;
+            size_t position = 0;
 
-            archive(static_cast<uint32_t>(removeComponentQueue.size()));
+            std::unordered_set<NetworkId> pendingSet;
+        };
 
-            for (auto& [id, type] : removeComponentQueue)
-                archive(id, type);
+        struct PeerState
+        {
+            NetworkId viewerId = 0;
 
-            removeComponentQueue.clear();
+            double tokens = 0.0;
+            bool sentThisTick = false;
+            bool fullSyncSentThisTick = false;
 
-            const auto gameObjectList = GameObjectManager::GetInstance().GetAll();
+            std::unordered_map<ComponentKey, float, ComponentKeyHash> pendingMap;
+
+            std::optional<FullSyncState> fullSync;
+        };
+
+        PeerState& GetPeerState(const HSteamNetConnection peer)
+        {
+            auto [iterator, inserted] = peerStateMap.try_emplace(peer);
 
-            archive(static_cast<uint32_t>(gameObjectList.size()));
+            if (inserted)
+                iterator->second.tokens = static_cast<double>(bandwidthCap) * MaximumBurstSeconds;
 
-            for (auto& gameObject : gameObjectList)
+            return iterator->second;
+        }
+
+        bool BuildUpdate(PeerState& state, std::string& outData)
+        {
+            if (!hasStructureChanges && state.pendingMap.empty())
+                return false;
+
+            const std::optional<Vector<float, 3>> viewerPosition = GetWorldPosition(state.viewerId);
+
+            std::vector<std::pair<float, const ComponentKey*>> orderList;
+            orderList.reserve(state.pendingMap.size());
+
+            for (auto& [key, accumulator] : state.pendingMap)
             {
-                for (const auto& component : gameObject->GetComponentMap() | std::views::values)
+                if (state.fullSync && state.fullSync->pendingSet.contains(key.objectId))
+                    continue;
+
+                accumulator += ComputePriority(key, viewerPosition);
+                orderList.emplace_back(accumulator, &key);
+            }
+
+            std::ranges::sort(orderList, std::greater{ }, &std::pair<float, const ComponentKey*>::first);
+
+            state.tokens -= static_cast<double>(structureBlock.size());
+
+            std::string recordBlock;
+            uint32_t recordCount = 0;
+
+            std::vector<ComponentKey> sentList;
+
+            for (const auto& [priority, key] : orderList)
+            {
+                if (state.tokens <= 0.0)
+                    break;
+
+                const auto& record = GetRecord(*key);
+
+                if (record)
                 {
-                    if (const auto networkComponent = dynamic_cast<INetworkSerializable*>(component.get()); networkComponent && networkComponent->IsDirty())
+                    recordBlock += *record;
+                    recordCount++;
+
+                    state.tokens -= static_cast<double>(record->size());
+
+                    NetworkStatistics::GetInstance().RecordSent(NetworkStatistics::Category::Component, key->typeName, record->size());
+                }
+
+                sentList.push_back(*key);
+            }
+
+            for (const auto& key : sentList)
+                state.pendingMap.erase(key);
+
+            if (!hasStructureChanges && sentList.empty())
+                return false;
+
+            outData = structureBlock + SerializeSummary(state.fullSync ? 0 : HierarchyHash::GetInstance().GetRootHash(), recordCount) + recordBlock;
+
+            return true;
+        }
+
+        std::string BuildFullSyncChunk(PeerState& state)
+        {
+            auto& manager = GameObjectManager::GetInstance();
+            const auto& hierarchy = HierarchyHash::GetInstance();
+
+            auto& sync = *state.fullSync;
+
+            std::vector<std::shared_ptr<GameObject>> spawnList;
+            std::vector<std::pair<NetworkId, NetworkId>> childList;
+            std::string recordBlock;
+            uint32_t recordCount = 0;
+
+            while (sync.position < sync.objectList.size() && recordBlock.size() < FullSyncChunkSize)
+            {
+                const NetworkId id = sync.objectList[sync.position++];
+
+                sync.pendingSet.erase(id);
+
+                const auto gameObject = manager.Get(id);
+
+                if (!gameObject)
+                    continue;
+
+                spawnList.push_back(gameObject.value());
+
+                if (const NetworkId parentId = hierarchy.GetParent(id); parentId != HierarchyHash::RootId)
+                    childList.emplace_back(parentId, id);
+
+                for (const auto& component : gameObject.value()->GetComponentMap() | std::views::values)
+                {
+                    const auto networkComponent = dynamic_cast<INetworkSerializable*>(component.get());
+
+                    if (!networkComponent)
+                        continue;
+
+                    const ComponentKey key{ id, networkComponent->GetComponentTypeName() };
+
+                    if (const auto& record = GetRecord(key))
                     {
-                        archive(true, gameObject->GetNetworkId(), networkComponent->GetComponentTypeName());
+                        recordBlock += *record;
+                        recordCount++;
 
-                        networkComponent->Serialize(archive);
-                        networkComponent->ClearDirty();
+                        NetworkStatistics::GetInstance().RecordSent(NetworkStatistics::Category::Component, key.typeName, record->size());
                     }
+
+                    state.pendingMap.erase(key);
                 }
             }
 
-            archive(false);
+            const bool finished = sync.position >= sync.objectList.size();
 
-            outName = SyncChannelName;
-            outData = stream.str();
+            std::vector<NetworkId> deleteList;
+            std::vector<std::pair<NetworkId, NetworkId>> removeChildList;
+            std::vector<std::pair<NetworkId, std::string>> addComponentList;
+            std::vector<std::pair<NetworkId, std::string>> removeComponentList;
 
-            sent = true;
+            std::string packet;
 
-            return true;
+            {
+                WireOutputArchive archive(packet);
+
+                WriteStructure(archive, spawnList, deleteList, childList, removeChildList, addComponentList, removeComponentList);
+            }
+
+            packet += SerializeSummary(finished ? hierarchy.GetRootHash() : 0, recordCount) + recordBlock;
+
+            state.tokens -= static_cast<double>(packet.size());
+
+            if (finished)
+                state.fullSync.reset();
+
+            return packet;
         }
 
-    private:
+        std::string SerializeSummary(const uint64_t rootHash, const uint32_t recordCount) const
+        {
+            std::string result;
+
+            WireOutputArchive archive(result);
+
+            archive(gameObjectCount, rootHash, recordCount);
+
+            return result;
+        }
+
+        std::string SerializeStructure()
+        {
+            structureChangeCount = spawnQueue.size() + deleteQueue.size() + addChildQueue.size() + removeChildQueue.size() + addComponentQueue.size() + removeComponentQueue.size();
+
+            std::string result;
+
+            WireOutputArchive archive(result);
+
+            WriteStructure(archive, spawnQueue, deleteQueue, addChildQueue, removeChildQueue, addComponentQueue, removeComponentQueue);
+
+            spawnQueue.clear();
+            deleteQueue.clear();
+            addChildQueue.clear();
+            removeChildQueue.clear();
+            addComponentQueue.clear();
+            removeComponentQueue.clear();
+
+            return result;
+        }
+
+        static void WriteStructure(WireOutputArchive& archive, std::vector<std::shared_ptr<GameObject>>& spawnList, std::vector<NetworkId>& deleteList, std::vector<std::pair<NetworkId, NetworkId>>& addChildList, std::vector<std::pair<NetworkId, NetworkId>>& removeChildList, std::vector<std::pair<NetworkId, std::string>>& addComponentList, std::vector<std::pair<NetworkId, std::string>>& removeComponentList)
+        {
+            WriteSortedIds(archive, spawnList, [](const auto& gameObject) { return gameObject->GetNetworkId(); }, [&](DeltaEncoder&, const auto& gameObject) { archive(gameObject->GetName().operator std::string()); });
+            WriteSortedIds(archive, deleteList, std::identity{ }, [](DeltaEncoder&, NetworkId) { });
+            WriteSortedIds(archive, addChildList, &std::pair<NetworkId, NetworkId>::second, [](DeltaEncoder& encoder, const auto& pair) { encoder.WriteRelative(pair.first, pair.second); });
+            WriteSortedIds(archive, removeChildList, &std::pair<NetworkId, NetworkId>::second, [](DeltaEncoder& encoder, const auto& pair) { encoder.WriteRelative(pair.first, pair.second); });
+            WriteSortedIds(archive, addComponentList, &std::pair<NetworkId, std::string>::first, [&](DeltaEncoder&, const auto& pair) { archive(pair.second); });
+            WriteSortedIds(archive, removeComponentList, &std::pair<NetworkId, std::string>::first, [&](DeltaEncoder&, const auto& pair) { archive(pair.second); });
+        }
+
+        template <typename T, typename Projection, typename Function>
+        static void WriteSortedIds(WireOutputArchive& archive, std::vector<T>& list, Projection projection, Function writeEntry)
+        {
+            std::ranges::stable_sort(list, std::less{ }, projection);
+
+            archive(static_cast<uint32_t>(list.size()));
+
+            DeltaEncoder encoder(archive);
+
+            for (const auto& entry : list)
+            {
+                encoder.Write(std::invoke(projection, entry));
+                writeEntry(encoder, entry);
+            }
+        }
+
+        const std::optional<std::string>& GetRecord(const ComponentKey& key)
+        {
+            if (const auto iterator = recordCache.find(key); iterator != recordCache.end())
+                return iterator->second;
+
+            std::optional<std::string> result;
+
+            if (const auto networkComponent = FindComponent(key))
+            {
+                std::string record;
+
+                WireOutputArchive archive(record);
+
+                archive(key.objectId, key.typeName);
+                archive.WriteNested([&](WireOutputArchive& payload) { networkComponent->Serialize(payload); });
+
+                result = std::move(record);
+            }
+
+            return recordCache.emplace(key, std::move(result)).first->second;
+        }
+
+        float ComputePriority(const ComponentKey& key, const std::optional<Vector<float, 3>>& viewerPosition) const
+        {
+            const auto networkComponent = FindComponent(key);
+
+            if (!networkComponent)
+                return 0.0f;
+
+            float result = networkComponent->GetReplicationPriority();
+
+            if (viewerPosition)
+            {
+                if (const auto position = GetWorldPosition(key.objectId))
+                    result /= 1.0f + Vector<float, 3>::Magnitude(*position - *viewerPosition) / ReferenceDistance;
+            }
+
+            return result;
+        }
+
+        static INetworkSerializable* FindComponent(const ComponentKey& key)
+        {
+            auto& manager = GameObjectManager::GetInstance();
+
+            if (!manager.Has(key.objectId))
+                return nullptr;
+
+            const auto component = manager.Get(key.objectId).value()->GetComponentByTypeName(key.typeName);
+
+            return dynamic_cast<INetworkSerializable*>(component.get());
+        }
+
+        static std::optional<Vector<float, 3>> GetWorldPosition(const NetworkId id)
+        {
+            auto& manager = GameObjectManager::GetInstance();
+
+            if (id == 0 || !manager.Has(id))
+                return std::nullopt;
+
+            const auto gameObject = manager.Get(id).value();
+
+            if (!gameObject->HasComponent<Transform>())
+                return std::nullopt;
+
+            return gameObject->GetTransform()->GetWorldPosition();
+        }
+
+        size_t bandwidthCap = DefaultBandwidthCap;
+
+        std::optional<steady_clock::time_point> lastTick;
+
+        uint32_t gameObjectCount = 0;
+
+        std::string structureBlock;
+        size_t structureChangeCount = 0;
+        bool hasStructureChanges = false;
 
-        bool sent = false;
+        std::unordered_map<ComponentKey, std::optional<std::string>, ComponentKeyHash> recordCache;
+        std::unordered_map<HSteamNetConnection, PeerState> peerStateMap;
 
         std::vector<std::shared_ptr<GameObject>> spawnQueue;
         std::vector<NetworkId> deleteQueue;
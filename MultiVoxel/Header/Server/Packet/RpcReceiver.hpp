@@ -1,12 +1,21 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <unordered_map>
 #include "Independent/Core/Settings.hpp"
 #include "Independent/ECS/GameObjectManager.hpp"
+#include "Independent/Network/ContentStore.hpp"
 #include "Independent/Network/NetworkManager.hpp"
+#include "Independent/Network/PacketCompressor.hpp"
 #include "Independent/Network/PeerConnection.hpp"
+#include "Server/Entity/EntityBase.hpp"
+#include "Server/RPC/RpcRateLimiter.hpp"
+#include "Server/RPC/RpcRegistry.hpp"
 #include "Server/RPC/RpcTypes.hpp"
 #include "Server/PermissionManager.hpp"
 
+using namespace std::chrono;
 using namespace MultiVoxel::Independent::Core;
 using namespace MultiVoxel::Independent::ECS;
 using namespace MultiVoxel::Independent::Network;
@@ -22,167 +31,243 @@ namespace MultiVoxel::Server::Packet
 
         static void HandleRpc(PeerConnection& peer, const std::string& data)
         {
-            const HSteamNetConnection requester = peer.GetHandle();
+            PendingPacket packet{ data };
 
-            std::istringstream stream(data);
-            cereal::BinaryInputArchive archive(stream);
+            {
+                WireInputArchive archive(packet.data);
+
+                archive(packet.remainingCount);
 
-            uint32_t requestCount;
-            archive(requestCount);
+                packet.offset = archive.GetPosition();
+            }
 
-            while (requestCount--)
+            if (const auto iterator = deferredMap.find(peer.GetHandle()); iterator != deferredMap.end())
             {
-                uint64_t callId;
-                RpcType rpc;
+                Defer(peer, std::move(packet));
+                return;
+            }
+
+            if (!ProcessPacket(peer, packet, steady_clock::now()))
+                Defer(peer, std::move(packet));
+        }
+
+        static void ProcessDeferred()
+        {
+            const auto now = steady_clock::now();
 
-                archive(callId, rpc);
+            for (auto iterator = deferredMap.begin(); iterator != deferredMap.end(); )
+            {
+                const auto peer = NetworkManager::GetInstance().FindPeer(iterator->first);
 
-                //if (!PermissionManager::GetInstance().HasPermission(requester, rpc))
-                //    continue;
+                auto& backlog = iterator->second;
 
-                switch (rpc)
+                while (peer && !backlog.packetQueue.empty() && ProcessPacket(*peer, backlog.packetQueue.front(), now))
                 {
-                    case RpcType::CreateGameObject:
-                    {
-                        std::string name;
-                        NetworkId parentId;
+                    backlog.byteCount -= backlog.packetQueue.front().data.size();
+                    backlog.packetQueue.pop_front();
+                }
 
-                        archive(name, parentId);
-                        HandleCreate(peer, callId, name, parentId);
+                if (!peer || backlog.packetQueue.empty())
+                    iterator = deferredMap.erase(iterator);
+                else
+                    ++iterator;
+            }
 
-                        break;
-                    }
+            if (now - lastPrune >= PruneInterval)
+            {
+                RpcRateLimiter::GetInstance().Prune(now);
+                lastPrune = now;
 
-                    case RpcType::DestroyGameObject:
-                    {
-                        NetworkId objId;
+                for (const auto& [handle, count] : deniedCountMap)
+                {
+                    if (count > 1)
+                        std::cerr << "Peer '" << handle << "' had " << count - 1 << " more RPC(s) denied for lacking permission.\n";
+                }
 
-                        archive(objId);
-                        HandleDestroy(objId);
+                deniedCountMap.clear();
+            }
+        }
 
-                        break;
-                    }
+        static void FlushResponses()
+        {
+            auto& networkManager = NetworkManager::GetInstance();
+            auto& statistics = NetworkStatistics::GetInstance();
 
-                    case RpcType::AddChild:
-                    {
-                        NetworkId parent, child;
+            for (auto& [handle, batch] : responseBatchMap)
+            {
+                if (batch.IsEmpty())
+                    continue;
 
-                        archive(parent, child);
-                        HandleAddChild(parent, child);
+                const auto message = PackBatch(batch);
 
-                        break;
-                    }
+                if (networkManager.SendTo(handle, message))
+                    statistics.RecordSent(NetworkStatistics::Category::Channel, RpcClient::RpcChannelName, message.GetBuffer().size());
+            }
 
-                    case RpcType::RemoveChild:
-                    {
-                        NetworkId parent, child;
+            responseBatchMap.clear();
 
-                        archive(parent, child);
-                        HandleRemoveChild(parent, child);
+            if (!broadcastBatch.IsEmpty())
+            {
+                const auto message = PackBatch(broadcastBatch);
 
-                        break;
-                    }
+                networkManager.Broadcast(message);
 
-                    case RpcType::RequestFullSync:
-                        Settings::GetInstance().REPLICATION_SENDER.Get()->Reload();
-                        break;
+                statistics.RecordSent(NetworkStatistics::Category::Channel, RpcClient::RpcChannelName, message.GetBuffer().size(), networkManager.GetPeerHandles().size());
+            }
+        }
 
-                    case RpcType::AddComponent:
-                    {
-                        std::string compTypeName;
-                        NetworkId objectId;
-                        std::string payload;
+    private:
 
-                        archive(compTypeName, objectId, payload);
-                        HandleAddComponent(peer, callId, compTypeName, objectId, payload);
+        static constexpr seconds PruneInterval{ 5 };
 
-                        break;
-                    }
+        struct PendingPacket
+        {
+            std::string data;
 
-                    case RpcType::RemoveComponent:
-                    {
-                        std::string compTypeName;
-                        NetworkId objectId;
+            size_t offset = 0;
+            uint32_t remainingCount = 0;
+        };
 
-                        archive(compTypeName, objectId);
-                        HandleRemoveComponent(peer, 0, compTypeName, objectId);
+        struct Backlog
+        {
+            std::deque<PendingPacket> packetQueue;
 
-                        break;
-                    }
+            size_t byteCount = 0;
+        };
+
+        RpcReceiver() = default;
+
+        static bool ProcessPacket(PeerConnection& peer, PendingPacket& packet, const steady_clock::time_point now)
+        {
+            WireInputArchive archive(packet.data);
+
+            archive.SetPosition(packet.offset);
+
+            auto& limiter = RpcRateLimiter::GetInstance();
+            auto& permissionManager = PermissionManager::GetInstance();
+
+            try
+            {
+                while (packet.remainingCount > 0)
+                {
+                    const auto start = archive.GetPosition();
+
+                    uint64_t callId;
+                    RpcType rpc;
+
+                    archive(callId, rpc);
 
-                    case RpcType::MoveGameObjectRequest:
+                    if (!limiter.TryConsume(peer.GetHandle(), rpc, now))
                     {
-                        NetworkId id;
-                        std::string payload;
+                        packet.offset = start;
+                        return false;
+                    }
 
-                        archive(id, payload);
+                    packet.remainingCount--;
 
-                        auto [position, rotation] = DeserializePositionRotation(payload);
+                    if (!permissionManager.HasPermission(peer.GetHandle(), rpc))
+                    {
+                        if (!GetDispatchTable().Skip(rpc, archive))
+                            break;
 
-                        if (auto gameObject = GameObjectManager::GetInstance().Get(id))
-                        {
-                            gameObject.value()->GetTransform()->SetLocalPosition(position, false);
-                            gameObject.value()->GetTransform()->SetLocalRotation(rotation, false);
-                        }
+                        if (deniedCountMap[peer.GetHandle()]++ == 0)
+                            std::cerr << "Peer '" << peer.GetHandle() << "' lacks permission for RPC '" << GetRpcTypeName(rpc) << "', ignoring it.\n";
 
-                        BroadcastTransformUpdate(id, position, rotation);
+                        continue;
+                    }
 
+                    if (!GetDispatchTable().Dispatch(peer, rpc, callId, archive))
+                    {
+                        std::cerr << "No RPC handler registered for type '" << static_cast<uint32_t>(rpc) << "', dropping the rest of the packet from peer '" << peer.GetHandle() << "'.\n";
                         break;
                     }
 
-                    default:
-                        break;
+                    NetworkStatistics::GetInstance().RecordReceived(NetworkStatistics::Category::Rpc, GetRpcTypeName(rpc), archive.GetPosition() - start);
                 }
             }
-        }
+            catch (const WireArchiveError& error)
+            {
+                std::cerr << "Malformed RPC packet from peer '" << peer.GetHandle() << "': " << error.what() << ", dropping the rest of it.\n";
+            }
 
-    private:
+            packet.remainingCount = 0;
 
-        RpcReceiver() = default;
+            return true;
+        }
 
-        static void HandleCreate(PeerConnection& peer, uint64_t callId, const std::string& name, NetworkId parentId)
+        static void Defer(const PeerConnection& peer, PendingPacket packet)
         {
-            const auto gameObject = GameObject::Create(IndexedString(name));
-
-            if (GameObjectManager::GetInstance().Has(parentId))
-                GameObjectManager::GetInstance().Get(parentId).value()->AddChild(gameObject);
-
-            GameObjectManager::GetInstance().Register(gameObject);
+            auto& backlog = deferredMap[peer.GetHandle()];
 
-            Settings::GetInstance().REPLICATION_SENDER.Get()->QueueSpawn(gameObject);
+            if (backlog.byteCount + packet.data.size() > RpcRateLimiter::GetInstance().GetBudget().maximumDeferredBytes)
+            {
+                std::cerr << "Peer '" << peer.GetHandle() << "' exceeded its deferred RPC budget, dropping a packet of " << packet.remainingCount << " calls.\n";
+                return;
+            }
 
-            std::ostringstream innerStream;
+            backlog.byteCount += packet.data.size();
+            backlog.packetQueue.push_back(std::move(packet));
+        }
 
+        static const RpcDispatchTable<PeerConnection&>& GetDispatchTable()
+        {
+            static const RpcDispatchTable<PeerConnection&> table = []()
             {
-                cereal::BinaryOutputArchive archive(innerStream);
+                RpcDispatchTable<PeerConnection&> result;
+
+                result.Register<RpcType::CreateGameObject>(&HandleCreate);
+                result.Register<RpcType::DestroyGameObject>(&HandleDestroy);
+                result.Register<RpcType::AddChild>(&HandleAddChild);
+                result.Register<RpcType::RemoveChild>(&HandleRemoveChild);
+                result.Register<RpcType::RequestFullSync>(&HandleRequestFullSync);
+                result.Register<RpcType::AddComponent>(&HandleAddComponent);
+                result.Register<RpcType::RemoveComponent>(&HandleRemoveComponent);
+                result.Register<RpcType::MoveGameObjectRequest>(&HandleMove);
+                result.Register<RpcType::RequestBlob>(&HandleRequestBlob);
+                result.Register<RpcType::RequestSubtreeHashes>(&HandleRequestSubtreeHashes);
+                result.Register<RpcType::RequestSubtreeSync>(&HandleRequestSubtreeSync);
+
+                return result;
+            }();
+
+            return table;
+        }
 
-                archive(static_cast<uint32_t>(1));
+        template <RpcType TYPE, typename... Arguments>
+        static void QueueResponse(const PeerConnection& peer, const uint64_t callId, Arguments&&... arguments)
+        {
+            responseBatchMap.try_emplace(peer.GetHandle()).first->second.Write<TYPE>(callId, std::forward<Arguments>(arguments)...);
+        }
 
-                archive(callId, RpcType::CreateGameObjectResponse, gameObject->GetNetworkId(), gameObject->GetName().operator std::string(), gameObject->GetParent().has_value() ? gameObject->GetParent().value()->GetNetworkId() : 0);
-            }
+        static Message PackBatch(RpcBatch& batch)
+        {
+            return PacketCompressor::GetInstance().Pack(RpcClient::RpcChannelName, batch.Take());
+        }
 
-            std::ostringstream stream;
-            cereal::BinaryOutputArchive archive(stream);
+        static void HandleCreate(PeerConnection& peer, const uint64_t callId, const std::string& name, const NetworkId parentId)
+        {
+            const auto gameObject = GameObject::Create(IndexedString(name));
 
-            archive(std::string(RpcClient::RpcChannelName));
+            if (GameObjectManager::GetInstance().Has(parentId))
+                GameObjectManager::GetInstance().Get(parentId).value()->AddChild(gameObject);
 
-            archive(innerStream.str());
+            GameObjectManager::GetInstance().Register(gameObject);
 
-            auto const& buffer = stream.str();
-            const auto message = Message::Create(Message::Type::Custom, buffer.data(), buffer.size(), true);
+            Settings::GetInstance().REPLICATION_SENDER.Get()->QueueSpawn(gameObject);
 
-            peer.Send(message);
+            if (gameObject->GetParent().has_value())
+                Settings::GetInstance().REPLICATION_SENDER.Get()->QueueAddChild(parentId, gameObject->GetNetworkId());
 
-            std::cout << "Sent message with buffer '" << buffer << "' to peer '" << peer.GetHandle() << "' with callId '" << callId << "'." << std::endl;
+            QueueResponse<RpcType::CreateGameObjectResponse>(peer, callId, gameObject->GetNetworkId(), gameObject->GetName().operator std::string(), gameObject->GetParent().has_value() ? gameObject->GetParent().value()->GetNetworkId() : 0);
         }
 
-        static void HandleDestroy(const NetworkId id)
+        static void HandleDestroy(PeerConnection&, uint64_t, const NetworkId id)
         {
             if (auto optionalGameObject = GameObjectManager::GetInstance().Get(id))
                 GameObjectManager::GetInstance().Unregister(id);
         }
 
-        static void HandleAddChild(const NetworkId parentId, const NetworkId childId)
+        static void HandleAddChild(PeerConnection&, uint64_t, const NetworkId parentId, const NetworkId childId)
         {
             auto& gameObjectManagerInstance = GameObjectManager::GetInstance();
 
@@ -193,7 +278,7 @@ namespace MultiVoxel::Server::Packet
             }
         }
 
-        static void HandleRemoveChild(const NetworkId parentId, const NetworkId childId)
+        static void HandleRemoveChild(PeerConnection&, uint64_t, const NetworkId parentId, const NetworkId childId)
         {
             auto& gameObjectManagerInstance = GameObjectManager::GetInstance();
 
@@ -201,7 +286,12 @@ namespace MultiVoxel::Server::Packet
                 parent.value()->RemoveChild(childId);
         }
 
-        static void HandleAddComponent(PeerConnection& peer, uint64_t callId, const std::string& compTypeName, NetworkId objectId, const std::string& payload)
+        static void HandleRequestFullSync(PeerConnection& peer, uint64_t)
+        {
+            Settings::GetInstance().REPLICATION_SENDER.Get()->Reload(peer.GetHandle());
+        }
+
+        static void HandleAddComponent(PeerConnection& peer, const uint64_t callId, const std::string& compTypeName, const NetworkId objectId, const std::string& payload)
         {
             auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId);
 
@@ -209,110 +299,81 @@ namespace MultiVoxel::Server::Packet
                 return;
 
             auto component = ComponentFactory::Create(compTypeName);
-            
+
             component = optionalGameObject.value()->AddComponentDynamic(component);
 
             if (auto networkComponent = dynamic_cast<INetworkSerializable*>(component.get()))
             {
-                std::istringstream stream(payload);
-
-                cereal::BinaryInputArchive archive(stream);
+                WireInputArchive archive(payload);
 
                 networkComponent->Deserialize(archive);
             }
 
             Settings::GetInstance().REPLICATION_SENDER.Get()->QueueAddComponent(objectId, compTypeName);
 
-            std::ostringstream inner;
+            if (dynamic_cast<Entity::EntityBase*>(component.get()))
+                Settings::GetInstance().REPLICATION_SENDER.Get()->SetViewer(peer.GetHandle(), objectId);
 
-            {
-                cereal::BinaryOutputArchive archive(inner);
-
-                archive(static_cast<uint32_t>(1));
-                archive(callId, RpcType::AddComponentResponse, objectId, compTypeName, payload);
-            }
-
-            std::ostringstream outer;
-
-            {
-                cereal::BinaryOutputArchive archive(outer);
-
-                archive(std::string(RpcClient::RpcChannelName));
-                archive(inner.str());
-            }
-
-            auto buffer = outer.str();
-
-            peer.Send(Message::Create(Message::Type::Custom, buffer.data(), buffer.size(), true));
+            QueueResponse<RpcType::AddComponentResponse>(peer, callId, objectId, compTypeName, payload);
         }
 
-        static void HandleRemoveComponent(const PeerConnection& peer, uint64_t, const std::string& compTypeName, NetworkId objectId)
+        static void HandleRemoveComponent(PeerConnection& peer, const uint64_t callId, const std::string& compTypeName, const NetworkId objectId)
         {
             if (const auto optionalGameObject = GameObjectManager::GetInstance().Get(objectId))
                 optionalGameObject.value()->RemoveComponentDynamic(ComponentFactory::Create(compTypeName));
 
-            Settings::GetInstance().REPLICATION_SENDER.Get()
-                    ->QueueRemoveComponent(objectId, compTypeName);
-
-            std::ostringstream inner;
-
-            cereal::BinaryOutputArchive innerArchive(inner);
+            Settings::GetInstance().REPLICATION_SENDER.Get()->QueueRemoveComponent(objectId, compTypeName);
 
-            innerArchive(static_cast<uint32_t>(1));
-            innerArchive(static_cast<uint64_t>(0), RpcType::RemoveComponentResponse, objectId, compTypeName);
-
-            std::ostringstream os;
-            cereal::BinaryOutputArchive archive(os);
-
-            archive(std::string(RpcClient::RpcChannelName));
-            archive(inner.str());
-
-            peer.Send(Message::Create(Message::Type::Custom, os.str().data(), os.str().size(), true));
+            QueueResponse<RpcType::RemoveComponentResponse>(peer, callId, objectId, compTypeName);
         }
 
-        static void BroadcastTransformUpdate(NetworkId id, const Vector<float, 3>& p, const Vector<float, 3>& q)
+        static void HandleMove(PeerConnection&, uint64_t, const NetworkId id, const Vector<float, 3>& position, const Vector<float, 3>& rotation)
         {
-            std::ostringstream innerStream;
-
-            cereal::BinaryOutputArchive archiveInner(innerStream);
-
-            archiveInner(static_cast<uint32_t>(1), static_cast<uint64_t>(0), RpcType::MoveGameObjectResponse, id, SerializePositionRotation(p,q));
-
-            std::ostringstream outerStream;
-
-            cereal::BinaryOutputArchive archiveOuter(outerStream);
-
-            archiveOuter(std::string(RpcClient::RpcChannelName), innerStream.str());
-
-            auto buffer = outerStream.str();
-            auto message = Message::Create(Message::Type::Custom, buffer.data(), buffer.size(), true);
+            if (auto gameObject = GameObjectManager::GetInstance().Get(id))
+            {
+                gameObject.value()->GetTransform()->SetLocalPosition(position, false);
+                gameObject.value()->GetTransform()->SetLocalRotation(rotation, false);
+            }
 
-            NetworkManager::GetInstance().Broadcast(message);
+            broadcastBatch.Write<RpcType::MoveGameObjectResponse>(0, id, position, rotation);
         }
 
-        static std::string SerializePositionRotation(const Vector<float, 3>& position, const Vector<float, 3>& rotation)
+        static void HandleRequestBlob(PeerConnection& peer, const uint64_t callId, const ContentHash hash)
         {
-            std::ostringstream stream;
+            const auto blob = ContentStore::GetInstance().Find(hash);
 
-            cereal::BinaryOutputArchive archive(stream);
+            if (!blob)
+            {
+                QueueResponse<RpcType::BlobResponse>(peer, callId, hash, false, std::string());
+                return;
+            }
 
-            archive(position, rotation);
+            QueueResponse<RpcType::BlobResponse>(peer, callId, hash, true, *blob);
+        }
 
-            return stream.str();
+        static void HandleRequestSubtreeHashes(PeerConnection& peer, const uint64_t callId, const NetworkId parentId)
+        {
+            QueueResponse<RpcType::SubtreeHashesResponse>(peer, callId, parentId, HierarchyHash::GetInstance().GetChildren(parentId));
         }
 
-        static std::pair<Vector<float, 3>, Vector<float, 3>> DeserializePositionRotation(const std::string& payload)
+        static void HandleRequestSubtreeSync(PeerConnection& peer, uint64_t, const NetworkId id)
         {
-            std::istringstream stream(payload);
+            Settings::GetInstance().REPLICATION_SENDER.Get()->ReloadSubtree(peer.GetHandle(), id);
+        }
 
-            cereal::BinaryInputArchive archive(stream);
+        static std::unordered_map<HSteamNetConnection, RpcBatch> responseBatchMap;
+        static RpcBatch broadcastBatch;
 
-            Vector<float, 3> position = { 0, 0, 0 };
-            Vector<float, 3> rotation = { 0, 0, 0 };
+        static std::unordered_map<HSteamNetConnection, Backlog> deferredMap;
+        static steady_clock::time_point lastPrune;
 
-            archive(position, rotation);
+        static std::unordered_map<HSteamNetConnection, size_t> deniedCountMap;
 
-            return {position,rotation};
-        }
     };
+
+    std::unordered_map<HSteamNetConnection, RpcBatch> RpcReceiver::responseBatchMap;
+    RpcBatch RpcReceiver::broadcastBatch;
+    std::unordered_map<HSteamNetConnection, RpcReceiver::Backlog> RpcReceiver::deferredMap;
+    steady_clock::time_point RpcReceiver::lastPrune;
+    std::unordered_map<HSteamNetConnection, size_t> RpcReceiver::deniedCountMap;
 }
\ No newline at end of file
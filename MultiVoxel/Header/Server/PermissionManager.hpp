@@ -1,11 +1,14 @@
 #pragma once
 
+#include <bitset>
+#include <memory>
 #include <unordered_map>
-#include <unordered_set>
 #include <mutex>
 #include <steam/steamnetworkingsockets.h>
 #include "Server/RPC/RpcTypes.hpp"
 
+using namespace MultiVoxel::Server::Rpc;
+
 namespace MultiVoxel::Server
 {
     class PermissionManager final
@@ -13,6 +16,8 @@ namespace MultiVoxel::Server
 
     public:
 
+        using PermissionSet = std::bitset<256>;
+
         PermissionManager(const PermissionManager&) = delete;
         PermissionManager(PermissionManager&&) = delete;
         PermissionManager& operator=(const PermissionManager&) = delete;
@@ -20,16 +25,12 @@ namespace MultiVoxel::Server
 
         void GrantPermission(const HSteamNetConnection peer, const RpcType rpc)
         {
-            std::lock_guard guard{ mutex };
-
-            permissions[peer].insert(rpc);
+            GetOrCreate(peer).set(static_cast<size_t>(rpc));
         }
 
         void RevokePermission(const HSteamNetConnection peer, const RpcType rpc)
         {
-            std::lock_guard guard{ mutex };
-
-            permissions[peer].erase(rpc);
+            GetOrCreate(peer).reset(static_cast<size_t>(rpc));
         }
 
         bool HasPermission(const HSteamNetConnection peer, const RpcType rpc) const
@@ -37,11 +38,19 @@ namespace MultiVoxel::Server
             if (!RpcNeedsElevation(rpc))
                 return true;
 
-            std::lock_guard guard{ mutex };
-
             const auto iterator = permissions.find(peer);
 
-            return iterator != permissions.end() && iterator->second.contains(rpc);
+            return (iterator != permissions.end() ? iterator->second : defaultPermissions).test(static_cast<size_t>(rpc));
+        }
+
+        void SetDefaultPermission(const RpcType rpc, const bool granted)
+        {
+            defaultPermissions.set(static_cast<size_t>(rpc), granted);
+        }
+
+        void RemovePeer(const HSteamNetConnection peer)
+        {
+            permissions.erase(peer);
         }
 
         static PermissionManager& GetInstance()
@@ -56,11 +65,19 @@ namespace MultiVoxel::Server
 
     private:
 
-        PermissionManager() = default;
+        PermissionManager()
+        {
+            defaultPermissions.set();
+        }
+
+        PermissionSet& GetOrCreate(const HSteamNetConnection peer)
+        {
+            return permissions.try_emplace(peer, defaultPermissions).first->second;
+        }
 
-        std::unordered_map<HSteamNetConnection, std::unordered_set<RpcType>> permissions;
+        std::unordered_map<HSteamNetConnection, PermissionSet> permissions;
 
-        mutable std::mutex mutex;
+        PermissionSet defaultPermissions;
         
         static std::once_flag initializationFlag;
         static std::unique_ptr<PermissionManager> instance;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <steam/steamnetworkingtypes.h>
+#include "Server/RPC/RpcTypes.hpp"
+
+using namespace std::chrono;
+
+namespace MultiVoxel::Server::Rpc
+{
+    struct RpcBudget
+    {
+        double tokensPerSecond = 200.0;
+        double burst = 400.0;
+
+        size_t maximumDeferredBytes = 1024 * 1024;
+    };
+
+    class RpcRateLimiter final
+    {
+
+    public:
+
+        RpcRateLimiter(const RpcRateLimiter&) = delete;
+        RpcRateLimiter(RpcRateLimiter&&) = delete;
+        RpcRateLimiter& operator=(const RpcRateLimiter&) = delete;
+        RpcRateLimiter& operator=(RpcRateLimiter&&) = delete;
+
+        void SetBudget(const RpcBudget& value)
+        {
+            budget = value;
+            budget.burst = std::max(budget.burst, GetMaximumRpcCost());
+        }
+
+        [[nodiscard]]
+        const RpcBudget& GetBudget() const
+        {
+            return budget;
+        }
+
+        bool TryConsume(const HSteamNetConnection peer, const RpcType type, const steady_clock::time_point now)
+        {
+            return TryConsume(peer, GetRpcCost(type), now);
+        }
+
+        bool TryConsume(const HSteamNetConnection peer, const double cost, const steady_clock::time_point now)
+        {
+            auto& bucket = bucketMap.try_emplace(peer, Bucket{ budget.burst, now }).first->second;
+
+            Refill(bucket, now);
+
+            if (bucket.tokens < cost)
+            {
+                throttledCount++;
+                return false;
+            }
+
+            bucket.tokens -= cost;
+
+            return true;
+        }
+
+        void Prune(const steady_clock::time_point now)
+        {
+            for (auto iterator = bucketMap.begin(); iterator != bucketMap.end(); )
+            {
+                Refill(iterator->second, now);
+
+                if (iterator->second.tokens >= budget.burst)
+                    iterator = bucketMap.erase(iterator);
+                else
+                    ++iterator;
+            }
+        }
+
+        void RemovePeer(const HSteamNetConnection peer)
+        {
+            bucketMap.erase(peer);
+        }
+
+        [[nodiscard]]
+        uint64_t GetThrottledCount() const
+        {
+            return throttledCount;
+        }
+
+        static RpcRateLimiter& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<RpcRateLimiter>(new RpcRateLimiter());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct Bucket
+        {
+            double tokens = 0.0;
+
+            steady_clock::time_point lastRefill;
+        };
+
+        RpcRateLimiter() = default;
+
+        void Refill(Bucket& bucket, const steady_clock::time_point now) const
+        {
+            if (now <= bucket.lastRefill)
+                return;
+
+            bucket.tokens = std::min(budget.burst, bucket.tokens + duration<double>(now - bucket.lastRefill).count() * budget.tokensPerSecond);
+            bucket.lastRefill = now;
+        }
+
+        RpcBudget budget;
+
+        uint64_t throttledCount = 0;
+
+        std::unordered_map<HSteamNetConnection, Bucket> bucketMap;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<RpcRateLimiter> instance;
+
+    };
+
+    std::once_flag RpcRateLimiter::initializationFlag;
+    std::unique_ptr<RpcRateLimiter> RpcRateLimiter::instance;
+}
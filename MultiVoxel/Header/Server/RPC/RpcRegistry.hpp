@@ -0,0 +1,289 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include "Independent/ECS/Component.hpp"
+#include "Independent/ECS/HierarchyHash.hpp"
+#include "Independent/Math/Vector.hpp"
+#include "Independent/Network/NetworkStatistics.hpp"
+#include "Independent/Network/WireArchive.hpp"
+#include "Server/RPC/RpcTypes.hpp"
+
+using namespace MultiVoxel::Independent::ECS;
+using namespace MultiVoxel::Independent::Math;
+using namespace MultiVoxel::Independent::Network;
+
+namespace MultiVoxel::Server::Rpc
+{
+    template <RpcType TYPE>
+    struct RpcSignature;
+
+    template <>
+    struct RpcSignature<RpcType::CreateGameObject>
+    {
+        using Arguments = std::tuple<std::string, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::DestroyGameObject>
+    {
+        using Arguments = std::tuple<NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::AddChild>
+    {
+        using Arguments = std::tuple<NetworkId, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RemoveChild>
+    {
+        using Arguments = std::tuple<NetworkId, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RequestFullSync>
+    {
+        using Arguments = std::tuple<>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::AddComponent>
+    {
+        using Arguments = std::tuple<std::string, NetworkId, std::string>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RemoveComponent>
+    {
+        using Arguments = std::tuple<std::string, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::MoveGameObjectRequest>
+    {
+        using Arguments = std::tuple<NetworkId, Vector<float, 3>, Vector<float, 3>>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RequestBlob>
+    {
+        using Arguments = std::tuple<uint64_t>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RequestSubtreeHashes>
+    {
+        using Arguments = std::tuple<NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RequestSubtreeSync>
+    {
+        using Arguments = std::tuple<NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::CreateGameObjectResponse>
+    {
+        using Arguments = std::tuple<NetworkId, std::string, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::AddChildResponse>
+    {
+        using Arguments = std::tuple<NetworkId, NetworkId>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::AddComponentResponse>
+    {
+        using Arguments = std::tuple<NetworkId, std::string, std::string>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::RemoveComponentResponse>
+    {
+        using Arguments = std::tuple<NetworkId, std::string>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::MoveGameObjectResponse>
+    {
+        using Arguments = std::tuple<NetworkId, Vector<float, 3>, Vector<float, 3>>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::BlobResponse>
+    {
+        using Arguments = std::tuple<uint64_t, bool, std::string>;
+    };
+
+    template <>
+    struct RpcSignature<RpcType::SubtreeHashesResponse>
+    {
+        using Arguments = std::tuple<NetworkId, std::vector<HierarchyHash::Entry>>;
+    };
+
+    template <RpcType TYPE>
+    using RpcArguments = typename RpcSignature<TYPE>::Arguments;
+
+    class RpcSerializer final
+    {
+
+    public:
+
+        template <RpcType TYPE, typename... Arguments>
+        static void Write(WireOutputArchive& archive, const uint64_t callId, Arguments&&... arguments)
+        {
+            static_assert(sizeof...(Arguments) == std::tuple_size_v<RpcArguments<TYPE>>, "Argument count does not match the RPC signature");
+
+            archive(callId, TYPE);
+
+            WriteArguments<RpcArguments<TYPE>>(archive, std::index_sequence_for<Arguments...>{ }, std::forward<Arguments>(arguments)...);
+        }
+
+        template <RpcType TYPE>
+        static RpcArguments<TYPE> Read(WireInputArchive& archive)
+        {
+            RpcArguments<TYPE> result;
+
+            std::apply([&](auto&... values) { (archive(values), ...); }, result);
+
+            return result;
+        }
+
+    private:
+
+        RpcSerializer() = default;
+
+        template <typename Tuple, size_t... INDICES, typename... Arguments>
+        static void WriteArguments(WireOutputArchive& archive, std::index_sequence<INDICES...>, Arguments&&... arguments)
+        {
+            (archive(static_cast<const std::tuple_element_t<INDICES, Tuple>&>(arguments)), ...);
+        }
+
+    };
+
+    class RpcBatch final
+    {
+
+    public:
+
+        RpcBatch() : archive(body) { }
+
+        RpcBatch(const RpcBatch&) = delete;
+        RpcBatch(RpcBatch&&) = delete;
+        RpcBatch& operator=(const RpcBatch&) = delete;
+        RpcBatch& operator=(RpcBatch&&) = delete;
+
+        template <RpcType TYPE, typename... Arguments>
+        void Write(const uint64_t callId, Arguments&&... arguments)
+        {
+            const auto start = body.size();
+
+            RpcSerializer::Write<TYPE>(archive, callId, std::forward<Arguments>(arguments)...);
+
+            NetworkStatistics::GetInstance().RecordSent(NetworkStatistics::Category::Rpc, GetRpcTypeName(TYPE), body.size() - start);
+
+            ++count;
+        }
+
+        [[nodiscard]]
+        uint32_t GetCount() const
+        {
+            return count;
+        }
+
+        [[nodiscard]]
+        bool IsEmpty() const
+        {
+            return count == 0;
+        }
+
+        std::string Take()
+        {
+            std::string result;
+
+            result.reserve(Varint::SizeOf(count) + body.size());
+
+            WireOutputArchive header(result);
+
+            header.WriteVarint(count);
+            header.WriteBytes(body.data(), body.size());
+
+            body.clear();
+
+            count = 0;
+
+            return result;
+        }
+
+    private:
+
+        uint32_t count = 0;
+
+        std::string body;
+        WireOutputArchive archive;
+
+    };
+
+    template <typename... Contexts>
+    class RpcDispatchTable final
+    {
+
+    public:
+
+        using Invoker = std::function<void(Contexts..., uint64_t, WireInputArchive&)>;
+
+        template <RpcType TYPE, typename Function>
+        void Register(Function function)
+        {
+            table[static_cast<size_t>(TYPE)] = [function = std::move(function)](Contexts... contexts, const uint64_t callId, WireInputArchive& archive)
+            {
+                auto arguments = RpcSerializer::Read<TYPE>(archive);
+
+                std::apply([&](auto&... values) { function(contexts..., callId, values...); }, arguments);
+            };
+
+            skipTable[static_cast<size_t>(TYPE)] = [](WireInputArchive& archive)
+            {
+                RpcSerializer::Read<TYPE>(archive);
+            };
+        }
+
+        bool Dispatch(Contexts... contexts, const RpcType type, const uint64_t callId, WireInputArchive& archive) const
+        {
+            const auto& invoker = table[static_cast<size_t>(type)];
+
+            if (!invoker)
+                return false;
+
+            invoker(contexts..., callId, archive);
+
+            return true;
+        }
+
+        bool Skip(const RpcType type, WireInputArchive& archive) const
+        {
+            const auto& skipper = skipTable[static_cast<size_t>(type)];
+
+            if (!skipper)
+                return false;
+
+            skipper(archive);
+
+            return true;
+        }
+
+    private:
+
+        std::array<Invoker, 256> table;
+        std::array<std::function<void(WireInputArchive&)>, 256> skipTable;
+
+    };
+}
\ No newline at end of file
@@ -14,13 +14,83 @@ namespace MultiVoxel::Server::Rpc
         AddComponent = 5,
         RemoveComponent = 6,
         MoveGameObjectRequest = 7,
+        RequestBlob = 8,
+        RequestSubtreeHashes = 9,
+        RequestSubtreeSync = 10,
         CreateGameObjectResponse = 128,
         AddChildResponse = 129,
         AddComponentResponse = 130,
         RemoveComponentResponse = 131,
-        MoveGameObjectResponse = 132
+        MoveGameObjectResponse = 132,
+        BlobResponse = 133,
+        SubtreeHashesResponse = 134
     };
 
+    inline const char* GetRpcTypeName(const RpcType type)
+    {
+        switch (type)
+        {
+
+        case RpcType::CreateGameObject:         return "CreateGameObject";
+        case RpcType::DestroyGameObject:        return "DestroyGameObject";
+        case RpcType::AddChild:                 return "AddChild";
+        case RpcType::RemoveChild:              return "RemoveChild";
+        case RpcType::RequestFullSync:          return "RequestFullSync";
+        case RpcType::AddComponent:             return "AddComponent";
+        case RpcType::RemoveComponent:          return "RemoveComponent";
+        case RpcType::MoveGameObjectRequest:    return "MoveGameObjectRequest";
+        case RpcType::RequestBlob:              return "RequestBlob";
+        case RpcType::RequestSubtreeHashes:     return "RequestSubtreeHashes";
+        case RpcType::RequestSubtreeSync:       return "RequestSubtreeSync";
+        case RpcType::CreateGameObjectResponse: return "CreateGameObjectResponse";
+        case RpcType::AddChildResponse:         return "AddChildResponse";
+        case RpcType::AddComponentResponse:     return "AddComponentResponse";
+        case RpcType::RemoveComponentResponse:  return "RemoveComponentResponse";
+        case RpcType::MoveGameObjectResponse:   return "MoveGameObjectResponse";
+        case RpcType::BlobResponse:             return "BlobResponse";
+        case RpcType::SubtreeHashesResponse:    return "SubtreeHashesResponse";
+
+        default:
+            return "Unknown";
+        }
+    }
+
+    inline double GetRpcCost(const RpcType type)
+    {
+        switch (type)
+        {
+
+        case RpcType::MoveGameObjectRequest:
+            return 1.0;
+
+        case RpcType::AddChild:
+        case RpcType::RemoveChild:
+        case RpcType::RequestSubtreeHashes:
+            return 2.0;
+
+        case RpcType::CreateGameObject:
+        case RpcType::DestroyGameObject:
+        case RpcType::AddComponent:
+        case RpcType::RemoveComponent:
+        case RpcType::RequestBlob:
+            return 4.0;
+
+        case RpcType::RequestSubtreeSync:
+            return 16.0;
+
+        case RpcType::RequestFullSync:
+            return 64.0;
+
+        default:
+            return 1.0;
+        }
+    }
+
+    inline double GetMaximumRpcCost()
+    {
+        return GetRpcCost(RpcType::RequestFullSync);
+    }
+
     inline bool RpcNeedsElevation(const RpcType type)
     {
         switch (type)
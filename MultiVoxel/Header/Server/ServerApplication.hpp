@@ -25,6 +25,7 @@ namespace MultiVoxel::Server
 		static void Preinitialize()
 		{
 			ServerBase::GetInstance().RegisterPacketSender(Settings::GetInstance().REPLICATION_SENDER.Get());
+			ServerBase::GetInstance().RegisterPacketSender(&BlockDeltaSender::GetInstance());
 		}
 
 		static void Initialize()
@@ -4,18 +4,32 @@
 #include <thread>
 #include <chrono>
 #include <sstream>
-#include <cereal/cereal.hpp>
-#include <cereal/archives/binary.hpp>
 #include "Independent/Core/Settings.hpp"
+#include "Independent/Network/ContentStore.hpp"
 #include "Independent/Network/NetworkManager.hpp"
+#include "Independent/Network/PacketCompressor.hpp"
 #include "Independent/Network/PacketReceiver.hpp"
 #include "Independent/Network/PacketSender.hpp"
+#include "Independent/Utility/AssetPath.hpp"
+#include "Independent/World/Brickmap.hpp"
+#include "Independent/World/ChunkChangeTracker.hpp"
+#include "Independent/World/FluidSimulation.hpp"
+#include "Independent/World/GenerationPipeline.hpp"
+#include "Independent/World/LightEngine.hpp"
+#include "Independent/World/RegionStorage.hpp"
+#include "Server/BlockBehaviours.hpp"
+#include "Server/BlockTickScheduler.hpp"
+#include "Server/Packet/BlockDeltaSender.hpp"
 #include "Server/Packet/RpcReceiver.hpp"
+#include "Server/PermissionManager.hpp"
+#include "Server/RPC/RpcRateLimiter.hpp"
 #include "Server/ServerInterfaceLayer.hpp"
+#include "Server/SnapshotHistory.hpp"
 
 using namespace std::chrono;
 using namespace MultiVoxel::Independent::Core;
 using namespace MultiVoxel::Independent::Network;
+using namespace MultiVoxel::Independent::World;
 
 namespace MultiVoxel::Server
 {
@@ -41,38 +55,92 @@ namespace MultiVoxel::Server
                 return false;
             }
 
-            networkManager.GetDispatcher()
-                .RegisterHandler(Message::Type::Custom,
-                    [&](PeerConnection& peer, Message const& msg)
-                    {
-                        const auto& buffer = msg.GetBuffer();
+            ContentStore::GetInstance().SetPublishing(true);
+
+            if (!RegionStorage::GetInstance().Open(std::filesystem::path(GetExecutableDirectory()) / "World"))
+                std::cerr << "Server: world persistence is disabled\n";
+
+            BlockBehaviours::RegisterDefaults(BlockTickScheduler::GetInstance());
+
+            auto& tracker = ChunkChangeTracker::GetInstance();
+
+            tracker.AddListener([](Chunk&, const ChunkDirtyRegion& region) { LightEngine::GetInstance().OnBlocksChanged(region.changeList); });
+            tracker.AddListener([](Chunk& chunk, const ChunkDirtyRegion& region) { BrickmapStore::GetInstance().OnChunkChanged(chunk, region); });
 
-                        const std::string rawData{ reinterpret_cast<const char*>(buffer.data()), buffer.size() };
+            tracker.AddListener([](Chunk&, const ChunkDirtyRegion& region)
+            {
+                for (const auto& change : region.changeList)
+                    BlockTickScheduler::GetInstance().OnBlockChanged(change.x, change.y, change.z);
+            });
+
+            tracker.AddListener([](Chunk&, const ChunkDirtyRegion& region)
+            {
+                for (const auto& change : region.changeList)
+                    FluidSimulation::GetInstance().OnBlockChanged(change.x, change.y, change.z, change.previous, change.current);
+            });
 
-                        std::istringstream is(rawData);
+            tracker.AddListener([](Chunk& chunk, const ChunkDirtyRegion& region) { BlockDeltaSender::GetInstance().OnChunkChanged(chunk, region); });
+
+            simulationPool = std::make_unique<WorkerPool>(std::max(2u, std::thread::hardware_concurrency()) / 2);
+
+            generationPipeline = std::make_unique<GenerationPipeline>(WorldSeed, std::max(2u, std::thread::hardware_concurrency()) - 1);
+
+            for (int32_t z = -SpawnRadius; z <= SpawnRadius; ++z)
+            {
+                for (int32_t x = -SpawnRadius; x <= SpawnRadius; ++x)
+                {
+                    if (auto chunk = RegionStorage::GetInstance().Load({ x, z }))
+                        AddChunk(std::move(chunk));
+                    else
+                        generationPipeline->Request({ x, z });
+                }
+            }
+
+            const auto packetHandler = [&](PeerConnection& peer, Message const& msg)
+            {
+                std::string name;
+                std::string data;
 
-                        cereal::BinaryInputArchive archive(is);
+                try
+                {
+                    if (!PacketCompressor::GetInstance().Unpack(msg, name, data))
+                        return;
 
-                        std::string name;
-                        std::string data;
+                    NetworkStatistics::GetInstance().RecordReceived(NetworkStatistics::Category::Channel, name, msg.GetBuffer().size());
 
-                        archive(name, data);
+                    if (name == "RpcChannel")
+                        RpcReceiver::HandleRpc(peer, data);
+                    else if (name == BlockDeltaChannelName)
+                        BlockDeltaSender::GetInstance().HandleResyncRequest(peer.GetHandle(), data);
 
-                        if (name == "RpcChannel")
-                            RpcReceiver::HandleRpc(peer, data);
+                    for (auto* receiver : packetReceiverList)
+                        receiver->OnPacketReceived(name, data);
+                }
+                catch (const WireArchiveError& error)
+                {
+                    std::cerr << "Server: malformed packet from peer '" << peer.GetHandle() << "': " << error.what() << "\n";
+                }
+            };
 
-                        for (auto* receiver : packetReceiverList)
-                            receiver->OnPacketReceived(name, data);
-                    });
+            networkManager.GetDispatcher().RegisterHandler(Message::Type::Custom, packetHandler);
+            networkManager.GetDispatcher().RegisterHandler(Message::Type::CompressedCustom, packetHandler);
 
-            networkManager.AddOnPlayerConnectedCallback([&]()
+            networkManager.AddOnPlayerConnectedCallback([&](const HSteamNetConnection peer)
             {
                 for (auto* sender : packetSenderList)
-                    sender->Reload();
+                    sender->Reload(peer);
+            });
+
+            networkManager.AddOnPlayerDisconnectedCallback([](const HSteamNetConnection peer)
+            {
+                PermissionManager::GetInstance().RemovePeer(peer);
+                RpcRateLimiter::GetInstance().RemovePeer(peer);
             });
 
             ServerInterfaceLayer::GetInstance().CallEvent("preinitialize");
             ServerInterfaceLayer::GetInstance().CallEvent("initialize");
+
+            networkManager.StartNetworkThread();
             
             isInitialized = true;
 
@@ -86,46 +154,105 @@ namespace MultiVoxel::Server
 
             running = true;
 
-            const auto tickInterval = milliseconds(50);
-
             while (running)
             {
                 auto start = steady_clock::now();
 
-                auto& networkManager = NetworkManager::GetInstance();
+                Tick();
 
-                networkManager.PollEvents();
+                if (auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start); elapsed < TickInterval)
+                    std::this_thread::sleep_for(TickInterval - elapsed);
+            }
+        }
 
-                for (auto* sender : packetSenderList)
+        void Tick()
+        {
+            auto& networkManager = NetworkManager::GetInstance();
+
+            networkManager.PollEvents();
+
+            auto& statistics = NetworkStatistics::GetInstance();
+
+            const auto peerHandleList = networkManager.GetPeerHandles();
+
+            for (auto* sender : packetSenderList)
+            {
+                std::string packetName;
+                std::string packetData;
+
+                sender->BeginTick();
+
+                while (sender->SendPacket(packetName, packetData))
                 {
-                    std::string packetName;
-                    std::string packetData;
+                    const auto message = PacketCompressor::GetInstance().Pack(packetName, packetData);
 
-                    while (sender->SendPacket(packetName, packetData))
-                    {
-                        std::ostringstream stream;
-                        cereal::BinaryOutputArchive archive(stream);
+                    networkManager.Broadcast(message);
+
+                    statistics.RecordSent(NetworkStatistics::Category::Channel, packetName, message.GetBuffer().size(), peerHandleList.size());
+                }
 
-                        archive(packetName, packetData);
-                        auto const& buffer = stream.str();
+                for (const auto handle : peerHandleList)
+                {
+                    while (sender->SendPacketTo(handle, packetName, packetData))
+                    {
+                        const auto message = PacketCompressor::GetInstance().Pack(packetName, packetData);
 
-                        networkManager.Broadcast(Message::Create(Message::Type::Custom, buffer.data(), buffer.size(), true));
+                        if (networkManager.SendTo(handle, message))
+                            statistics.RecordSent(NetworkStatistics::Category::Channel, packetName, message.GetBuffer().size());
                     }
                 }
+            }
 
-                networkManager.FlushOutgoing();
+            RpcReceiver::ProcessDeferred();
+            RpcReceiver::FlushResponses();
 
-                ServerInterfaceLayer::GetInstance().CallEvent("update");
+            networkManager.FlushOutgoing();
 
-                if (auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start); elapsed < tickInterval)
-                    std::this_thread::sleep_for(tickInterval - elapsed);
-            }
+            if (statistics.IsReportDue())
+                statistics.Report(std::cout, networkManager.GetPeerStatuses());
+
+            ServerInterfaceLayer::GetInstance().CallEvent("update");
+
+            SnapshotHistory::GetInstance().Record(++tickNumber, steady_clock::now());
+
+            if (generationPipeline)
+                generationPipeline->Collect([](std::unique_ptr<Chunk> chunk) { AddChunk(std::move(chunk)); });
+
+            UpdateBrickmapFocus();
+
+            BlockTickScheduler::GetInstance().Tick(tickNumber);
+            FluidSimulation::GetInstance().Step(tickNumber, simulationPool.get());
+            ChunkChangeTracker::GetInstance().Flush();
+
+            RegionStorage::GetInstance().Update(steady_clock::now());
+
+            PacketCompressor::GetInstance().ReportIfDue(std::cout);
+
+            if (statistics.IsReportDue())
+                statistics.Report(std::cout, networkManager.GetPeerStatuses());
+        }
+
+        [[nodiscard]]
+        uint64_t GetTickNumber() const
+        {
+            return tickNumber;
         }
 
         void Stop()
         {
             ServerInterfaceLayer::GetInstance().CallEvent("uninitialize");
 
+            if (generationPipeline)
+            {
+                generationPipeline->Wait();
+                generationPipeline->Collect([](std::unique_ptr<Chunk> chunk) { ChunkManager::GetInstance().Insert(std::move(chunk)); });
+            }
+
+            auto& storage = RegionStorage::GetInstance();
+
+            storage.SaveDirty(ChunkManager::GetInstance());
+            storage.Close();
+
             running = false;
         }
 
@@ -157,16 +284,44 @@ namespace MultiVoxel::Server
             return *instance;
         }
 
+        static constexpr milliseconds TickInterval{ 50 };
+        static constexpr uint64_t WorldSeed = 0x4D756C7469566F78;
+        static constexpr int32_t SpawnRadius = 4;
+
     private:
 
         ServerBase() = default;
 
+        static void AddChunk(std::unique_ptr<Chunk> chunk)
+        {
+            auto& inserted = ChunkManager::GetInstance().Insert(std::move(chunk));
+
+            LightEngine::GetInstance().InitializeChunk(inserted);
+            BrickmapStore::GetInstance().Update(inserted);
+        }
+
+        static void UpdateBrickmapFocus()
+        {
+            std::vector<ChunkCoordinate> focusList;
+
+            for (const auto& position : Settings::GetInstance().REPLICATION_SENDER.Get()->GetViewerPositions())
+                focusList.push_back(ChunkCoordinate::FromBlock(static_cast<int32_t>(std::floor(position[0])), static_cast<int32_t>(std::floor(position[2]))));
+
+            BrickmapStore::GetInstance().SetFocus(std::move(focusList));
+            BrickmapStore::GetInstance().Refine([](const ChunkCoordinate coordinate) { return ChunkManager::GetInstance().GetChunk(coordinate); });
+        }
+
         uint16_t serverPort = 0;
 
         std::atomic<bool> running = false;
 
         bool isInitialized = false;
 
+        uint64_t tickNumber = 0;
+
+        std::unique_ptr<GenerationPipeline> generationPipeline;
+        std::unique_ptr<WorkerPool> simulationPool;
+
         std::unordered_map<std::string, HSteamNetConnection> players = {};
 
         std::vector<PacketSender*> packetSenderList;
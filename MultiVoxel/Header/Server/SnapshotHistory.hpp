@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include "Independent/ECS/GameObjectManager.hpp"
+#include "Independent/Math/Vector.hpp"
+
+using namespace std::chrono;
+using namespace MultiVoxel::Independent::ECS;
+using namespace MultiVoxel::Independent::Math;
+
+namespace MultiVoxel::Server
+{
+    class SnapshotView final
+    {
+
+    public:
+
+        [[nodiscard]]
+        uint64_t GetTick() const
+        {
+            return tick;
+        }
+
+        [[nodiscard]]
+        steady_clock::time_point GetTime() const
+        {
+            return time;
+        }
+
+        [[nodiscard]]
+        size_t GetCount() const
+        {
+            return count;
+        }
+
+        [[nodiscard]]
+        NetworkId GetId(const size_t index) const
+        {
+            return idList[index];
+        }
+
+        [[nodiscard]]
+        Vector<float, 3> GetPosition(const size_t index) const
+        {
+            return { positionX[index], positionY[index], positionZ[index] };
+        }
+
+        [[nodiscard]]
+        Vector<float, 3> GetRotation(const size_t index) const
+        {
+            return { rotationX[index], rotationY[index], rotationZ[index] };
+        }
+
+        [[nodiscard]]
+        std::optional<size_t> Find(const NetworkId id) const
+        {
+            const auto iterator = std::lower_bound(idList, idList + count, id);
+
+            if (iterator == idList + count || *iterator != id)
+                return std::nullopt;
+
+            return static_cast<size_t>(iterator - idList);
+        }
+
+        [[nodiscard]]
+        std::optional<Vector<float, 3>> FindPosition(const NetworkId id) const
+        {
+            if (const auto index = Find(id))
+                return GetPosition(*index);
+
+            return std::nullopt;
+        }
+
+        template <typename Function>
+        void ForEachWithin(const Vector<float, 3>& center, const float radius, Function&& function) const
+        {
+            const float radiusSquared = radius * radius;
+
+            for (size_t index = 0; index < count; ++index)
+            {
+                const float x = positionX[index] - center[0];
+                const float y = positionY[index] - center[1];
+                const float z = positionZ[index] - center[2];
+
+                if (x * x + y * y + z * z <= radiusSquared)
+                    function(idList[index], GetPosition(index));
+            }
+        }
+
+    private:
+
+        SnapshotView() = default;
+
+        uint64_t tick = 0;
+        steady_clock::time_point time;
+        size_t count = 0;
+
+        const NetworkId* idList = nullptr;
+        const float* positionX = nullptr;
+        const float* positionY = nullptr;
+        const float* positionZ = nullptr;
+        const float* rotationX = nullptr;
+        const float* rotationY = nullptr;
+        const float* rotationZ = nullptr;
+
+        friend class SnapshotHistory;
+
+    };
+
+    class SnapshotHistory final
+    {
+
+    public:
+
+        static constexpr size_t FrameCount = 32;
+        static constexpr size_t MaximumObjectCount = 2048;
+
+        SnapshotHistory(const SnapshotHistory&) = delete;
+        SnapshotHistory(SnapshotHistory&&) = delete;
+        SnapshotHistory& operator=(const SnapshotHistory&) = delete;
+        SnapshotHistory& operator=(SnapshotHistory&&) = delete;
+
+        void Record(const uint64_t tick, const steady_clock::time_point time)
+        {
+            scratchList.clear();
+
+            GameObjectManager::GetInstance().ForEach([&](const std::shared_ptr<GameObject>& gameObject)
+            {
+                if (gameObject->HasComponent<Transform>())
+                    scratchList.emplace_back(gameObject->GetNetworkId(), gameObject->GetTransform().get());
+            });
+
+            std::ranges::sort(scratchList, std::less{ }, &std::pair<NetworkId, Transform*>::first);
+
+            if (scratchList.size() > MaximumObjectCount && !overflowReported)
+            {
+                std::cerr << "Snapshot history holds " << MaximumObjectCount << " objects per tick, dropping " << scratchList.size() - MaximumObjectCount << ".\n";
+                overflowReported = true;
+            }
+
+            const size_t slot = tick % FrameCount;
+            const size_t base = slot * MaximumObjectCount;
+
+            auto& frame = frameList[slot];
+
+            frame.tick = tick;
+            frame.time = time;
+            frame.count = std::min(scratchList.size(), MaximumObjectCount);
+            frame.valid = true;
+
+            for (size_t index = 0; index < frame.count; ++index)
+            {
+                const auto& [id, transform] = scratchList[index];
+
+                const auto position = transform->GetWorldPosition();
+                const auto rotation = transform->GetWorldRotation();
+
+                idList[base + index] = id;
+                positionX[base + index] = position[0];
+                positionY[base + index] = position[1];
+                positionZ[base + index] = position[2];
+                rotationX[base + index] = rotation[0];
+                rotationY[base + index] = rotation[1];
+                rotationZ[base + index] = rotation[2];
+            }
+
+            latestTick = tick;
+        }
+
+        [[nodiscard]]
+        std::optional<SnapshotView> Rewind(const uint64_t tick) const
+        {
+            const auto& frame = frameList[tick % FrameCount];
+
+            if (!frame.valid || frame.tick != tick)
+                return std::nullopt;
+
+            return CreateView(tick % FrameCount);
+        }
+
+        [[nodiscard]]
+        std::optional<SnapshotView> Rewind(const steady_clock::time_point time) const
+        {
+            std::optional<size_t> best;
+
+            for (size_t slot = 0; slot < FrameCount; ++slot)
+            {
+                const auto& frame = frameList[slot];
+
+                if (frame.valid && frame.time <= time && (!best || frame.tick > frameList[*best].tick))
+                    best = slot;
+            }
+
+            if (!best)
+                return std::nullopt;
+
+            return CreateView(*best);
+        }
+
+        [[nodiscard]]
+        std::optional<Vector<float, 3>> InterpolatePosition(const NetworkId id, const steady_clock::time_point time) const
+        {
+            const auto before = Rewind(time);
+
+            if (!before)
+                return std::nullopt;
+
+            const auto from = before->FindPosition(id);
+
+            if (!from)
+                return std::nullopt;
+
+            const auto after = Rewind(before->GetTick() + 1);
+
+            if (!after || after->GetTime() <= before->GetTime())
+                return from;
+
+            const auto to = after->FindPosition(id);
+
+            if (!to)
+                return from;
+
+            const float t = std::clamp(static_cast<float>(duration<double>(time - before->GetTime()).count() / duration<double>(after->GetTime() - before->GetTime()).count()), 0.0f, 1.0f);
+
+            return Vector<float, 3>::Lerp(*from, *to, t);
+        }
+
+        [[nodiscard]]
+        uint64_t GetLatestTick() const
+        {
+            return latestTick;
+        }
+
+        void Clear()
+        {
+            for (auto& frame : frameList)
+                frame = Frame{ };
+
+            latestTick = 0;
+        }
+
+        static SnapshotHistory& GetInstance()
+        {
+            std::call_once(initializationFlag, [&]()
+            {
+                instance = std::unique_ptr<SnapshotHistory>(new SnapshotHistory());
+            });
+
+            return *instance;
+        }
+
+    private:
+
+        struct Frame
+        {
+            uint64_t tick = 0;
+            steady_clock::time_point time;
+            size_t count = 0;
+
+            bool valid = false;
+        };
+
+        SnapshotHistory() : idList(FrameCount * MaximumObjectCount), positionX(FrameCount * MaximumObjectCount), positionY(FrameCount * MaximumObjectCount), positionZ(FrameCount * MaximumObjectCount), rotationX(FrameCount * MaximumObjectCount), rotationY(FrameCount * MaximumObjectCount), rotationZ(FrameCount * MaximumObjectCount)
+        {
+            scratchList.reserve(MaximumObjectCount);
+        }
+
+        [[nodiscard]]
+        SnapshotView CreateView(const size_t slot) const
+        {
+            const size_t base = slot * MaximumObjectCount;
+
+            SnapshotView result;
+
+            result.tick = frameList[slot].tick;
+            result.time = frameList[slot].time;
+            result.count = frameList[slot].count;
+            result.idList = idList.data() + base;
+            result.positionX = positionX.data() + base;
+            result.positionY = positionY.data() + base;
+            result.positionZ = positionZ.data() + base;
+            result.rotationX = rotationX.data() + base;
+            result.rotationY = rotationY.data() + base;
+            result.rotationZ = rotationZ.data() + base;
+
+            return result;
+        }
+
+        std::array<Frame, FrameCount> frameList;
+
+        std::vector<NetworkId> idList;
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> positionZ;
+        std::vector<float> rotationX;
+        std::vector<float> rotationY;
+        std::vector<float> rotationZ;
+
+        std::vector<std::pair<NetworkId, Transform*>> scratchList;
+
+        uint64_t latestTick = 0;
+        bool overflowReported = false;
+
+        static std::once_flag initializationFlag;
+        static std::unique_ptr<SnapshotHistory> instance;
+
+    };
+
+    std::once_flag SnapshotHistory::initializationFlag;
+    std::unique_ptr<SnapshotHistory> SnapshotHistory::instance;
+}
@@ -1,23 +1,47 @@
-﻿#include "Client/ClientApplication.hpp"
+﻿#include <sstream>
+#include "Benchmark/FluidBenchmark.hpp"
+#include "Benchmark/LodBenchmark.hpp"
+#include "Benchmark/NoiseBenchmark.hpp"
+#include "Benchmark/RaycastBenchmark.hpp"
+#include "Benchmark/SerializationBenchmark.hpp"
+#include "Benchmark/TerrainBenchmark.hpp"
+#include "Bot/BotBase.hpp"
+#include "Client/ClientApplication.hpp"
 #include "Client/ClientBase.hpp"
 #include "Independent/Core/Settings.hpp"
+#include "Independent/Network/LoopbackTransport.hpp"
 #include "Server/ServerBase.hpp"
 #include "Server/ServerApplication.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
-    std::cout << "Run as (s)erver or (c)lient? ";
+    std::stringstream arguments;
+
+    for (int index = 1; index < argc; ++index)
+        arguments << argv[index] << ' ';
+
+    std::istream& input = argc > 1 ? static_cast<std::istream&>(arguments) : std::cin;
+
+    std::cout << "Run as (s)erver, (c)lient, (b)ots, (l)oopback bots or (p)erformance benchmarks? ";
 
     char choice;
 
-    std::cin >> choice;
+    input >> choice;
 
     if (choice == 's' || choice == 'S')
     {
         std::cout << "Port: ";
 
         int port;
-        std::cin >> port;
+        input >> port;
+
+        std::cout << "Network statistics CSV file (- disables it): ";
+
+        std::string csvPath;
+        input >> csvPath;
+
+        if (!csvPath.empty() && csvPath != "-")
+            MultiVoxel::Independent::Network::NetworkStatistics::GetInstance().SetCsvPath(csvPath);
 
         MultiVoxel::Server::ServerApplication::GetInstance();
 
@@ -28,17 +52,139 @@ int main()
 
         server.Run();
     }
+    else if (choice == 'b' || choice == 'B')
+    {
+        std::cout << "Server address: ";
+
+        std::string address;
+        input >> address;
+
+        std::cout << "Port: ";
+
+        int port;
+        input >> port;
+
+        std::cout << "Bot count: ";
+
+        size_t botCount;
+        input >> botCount;
+
+        std::cout << "Duration in seconds (0 runs until stopped): ";
+
+        int duration;
+        input >> duration;
+
+        auto& bots = MultiVoxel::Bot::BotBase::GetInstance();
+
+        if (!bots.Initialize(address, static_cast<uint16_t>(port), botCount))
+            return EXIT_FAILURE;
+
+        bots.Run(std::chrono::seconds(duration));
+    }
+    else if (choice == 'l' || choice == 'L')
+    {
+        using namespace MultiVoxel::Independent::Network;
+
+        constexpr uint16_t port = 27020;
+
+        std::cout << "Bot count: ";
+
+        size_t botCount;
+        input >> botCount;
+
+        std::cout << "Duration in seconds: ";
+
+        int duration;
+        input >> duration;
+
+        std::cout << "Latency in milliseconds, jitter in milliseconds, loss percent, bandwidth in KiB/s (0 is unlimited): ";
+
+        int latency, jitter, bandwidth;
+        float loss;
+        input >> latency >> jitter >> loss >> bandwidth;
+
+        LoopbackSettings settings;
+
+        settings.latency = std::chrono::milliseconds(latency);
+        settings.jitter = std::chrono::milliseconds(jitter);
+        settings.lossRate = loss / 100.0f;
+        settings.bytesPerSecond = static_cast<size_t>(bandwidth) * 1024;
+
+        const auto network = std::make_shared<LoopbackNetwork>(settings);
+
+        NetworkManager::GetInstance().SetTransport(std::make_unique<LoopbackTransport>(network));
+
+        MultiVoxel::Server::ServerApplication::GetInstance();
+
+        auto& server = MultiVoxel::Server::ServerBase::GetInstance();
+
+        if (!server.Initialize(port))
+            return EXIT_FAILURE;
+
+        const auto botManager = NetworkManager::Create(std::make_unique<LoopbackTransport>(network));
+
+        auto& bots = MultiVoxel::Bot::BotBase::GetInstance();
+
+        if (!bots.Initialize(*botManager, "loopback", port, botCount))
+            return EXIT_FAILURE;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto nextServerTick = start;
+
+        while (std::chrono::steady_clock::now() - start < std::chrono::seconds(duration))
+        {
+            const auto now = std::chrono::steady_clock::now();
+
+            if (now >= nextServerTick)
+            {
+                server.Tick();
+                nextServerTick += MultiVoxel::Server::ServerBase::TickInterval;
+            }
+
+            if (!bots.Tick(now))
+                break;
+
+            std::this_thread::sleep_until(std::min(now + MultiVoxel::Bot::BotBase::TickInterval, nextServerTick));
+        }
+
+        bots.PrintStatistics(std::cout, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    else if (choice == 'p' || choice == 'P')
+    {
+        std::cout << "Benchmark suite (serialization, terrain, noise, raycast, lod, fluid): ";
+
+        std::string suite;
+        input >> suite;
+
+        if (suite == "serialization")
+            MultiVoxel::Benchmark::SerializationBenchmark::Run(std::cout);
+        else if (suite == "terrain")
+            MultiVoxel::Benchmark::TerrainBenchmark::Run(std::cout);
+        else if (suite == "noise")
+            MultiVoxel::Benchmark::NoiseBenchmark::Run(std::cout);
+        else if (suite == "raycast")
+            MultiVoxel::Benchmark::RaycastBenchmark::Run(std::cout);
+        else if (suite == "lod")
+            MultiVoxel::Benchmark::LodBenchmark::Run(std::cout);
+        else if (suite == "fluid")
+            MultiVoxel::Benchmark::FluidBenchmark::Run(std::cout);
+        else
+        {
+            std::cerr << "Unknown benchmark suite '" << suite << "'.\n";
+            return EXIT_FAILURE;
+        }
+    }
     else
     {
         std::cout << "Server address: ";
 
         std::string address;
-        std::cin >> address;
+        input >> address;
 
         std::cout << "Port: ";
 
         int port;
-        std::cin >> port;
+        input >> port;
 
         MultiVoxel::Client::ClientApplication::GetInstance();
 